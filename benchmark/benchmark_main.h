@@ -0,0 +1,44 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_BENCHMARK_MAIN_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_BENCHMARK_MAIN_H
+
+#include "syropod_highlevel_controller/standard_includes.h"
+#include "syropod_highlevel_controller/ros_interface.h"
+
+#include <benchmark/benchmark.h>
+
+/// Initialises ros and Google Benchmark for a benchmark executable. Results default to being written as JSON to the
+/// given output file, unless overridden by the --benchmark_out and --benchmark_out_format arguments.
+/// @param[in] argc Count of command line arguments
+/// @param[in] argv Command line arguments
+/// @param[in] node_name The name of the ros node of the benchmark executable
+/// @param[in] output_file The default file to which JSON benchmark results are written
+/// @return Flag denoting if all command line arguments were recognised
+inline bool initBenchmarks(int argc, char* argv[], const std::string &node_name, const std::string &output_file)
+{
+  ros::init(argc, argv, node_name);
+  setCoreInterface(std::make_shared<RosInterface>());
+
+  // Default to JSON output file, prepended such that explicit benchmark arguments take precedence
+  std::string output_argument = "--benchmark_out=" + output_file;
+  std::string output_format_argument = "--benchmark_out_format=json";
+  std::vector<char*> arguments;
+  arguments.push_back(argv[0]);
+  arguments.push_back(&output_argument[0]);
+  arguments.push_back(&output_format_argument[0]);
+  arguments.insert(arguments.end(), argv + 1, argv + argc);
+  int argument_count = arguments.size();
+  benchmark::Initialize(&argument_count, arguments.data());
+  return !benchmark::ReportUnrecognizedArguments(argument_count, arguments.data());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_BENCHMARK_MAIN_H
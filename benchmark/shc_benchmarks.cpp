@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/state_controller.h"
+
+#include "benchmark_main.h"
+
+#define BENCHMARK_OUTPUT_FILE "shc_benchmarks.json" ///< Default file to which JSON benchmark results are written
+
+/// Full controller stack shared by all fixtures, generated once from parameters on the ros param server
+static StateController* shc = NULL;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This fixture provides the robot model and sub-controllers of the shared controller stack to each benchmark. The
+/// stack is initialised as per the transition to the RUNNING state (default joint positions, generated workspaces and
+/// walkspace) such that kernels are benchmarked on representative data. Kernels which allocate transient data from
+/// the cycle arena of the model reset it each iteration, as per the start of each control cycle.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ControllerFixture : public benchmark::Fixture
+{
+public:
+  /// Acquires pointers to the robot model and sub-controllers of the shared controller stack.
+  void SetUp(const benchmark::State &) override
+  {
+    model_ = shc->getModel();
+    walker_ = shc->getWalker();
+    poser_ = shc->getPoser();
+    admittance_ = shc->getAdmittance();
+    leg_ = model_->getLegByIDNumber(0);
+  };
+
+  /// Releases pointers to the robot model and sub-controllers of the shared controller stack.
+  void TearDown(const benchmark::State &) override
+  {
+    model_.reset();
+    walker_.reset();
+    poser_.reset();
+    admittance_.reset();
+    leg_.reset();
+  };
+
+protected:
+  std::shared_ptr<Model> model_;                     ///< Pointer to robot model object
+  std::shared_ptr<WalkController> walker_;           ///< Pointer to walk controller object
+  std::shared_ptr<PoseController> poser_;            ///< Pointer to pose controller object
+  std::shared_ptr<AdmittanceController> admittance_; ///< Pointer to admittance controller object
+  std::shared_ptr<Leg> leg_;                         ///< Pointer to first leg of robot model object
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Leg kinematics benchmarks
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegApplyFK)(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(leg_->applyFK());
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegApplyFK);
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegSolveIK)(benchmark::State &state)
+{
+  Eigen::Matrix<double, 6, 1> delta = Eigen::Matrix<double, 6, 1>::Zero();
+  delta(0) = 1.0e-3;
+  delta(2) = -1.0e-3;
+  Eigen::VectorXd joint_position_delta(leg_->getJointCount());
+  for (auto _ : state)
+  {
+    model_->getCycleArena()->reset();
+    leg_->solveIK(delta, false, joint_position_delta);
+    benchmark::DoNotOptimize(joint_position_delta.data());
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegSolveIK);
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegApplyIK)(benchmark::State &state)
+{
+  Pose tip_pose = leg_->getCurrentTipPose();
+  for (auto _ : state)
+  {
+    model_->getCycleArena()->reset();
+    leg_->setDesiredTipPose(tip_pose, false);
+    benchmark::DoNotOptimize(leg_->applyIK(true));
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegApplyIK);
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegCalculateTipForce)(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    model_->getCycleArena()->reset();
+    leg_->calculateTipForce();
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegCalculateTipForce);
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegGenerateWorkspace)(benchmark::State &state)
+{
+  // Search for kinematic limitations on a copy of the model as per Model::generateWorkspaces()
+  std::shared_ptr<Model> search_model = std::allocate_shared<Model>(Eigen::aligned_allocator<Model>(), model_);
+  search_model->generate(model_);
+  search_model->initLegs(true);
+  std::shared_ptr<Leg> search_leg = search_model->getLegByIDNumber(0);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(search_leg->generateWorkspace());
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegGenerateWorkspace)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ControllerFixture, LegGetWorkplane)(benchmark::State &state)
+{
+  // Interpolate between the two lowest workplanes
+  const Workspace& workspace = leg_->getWorkspace();
+  ROS_ASSERT(workspace.size() > 1);
+  double height = (workspace.begin()->first + (++workspace.begin())->first) / 2.0;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(leg_->getWorkplane(height));
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, LegGetWorkplane);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Walk controller benchmarks
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_DEFINE_F(ControllerFixture, WalkerGenerateWalkspace)(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    walker_->generateWalkspace();
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, WalkerGenerateWalkspace)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(ControllerFixture, WalkerGenerateLimits)(benchmark::State &state)
+{
+  // Limits are output to local maps such that the limits of the walk controller are left unchanged
+  LimitMap max_linear_speed;
+  LimitMap max_angular_speed;
+  LimitMap max_linear_acceleration;
+  LimitMap max_angular_acceleration;
+  for (auto _ : state)
+  {
+    walker_->generateLimits(&max_linear_speed, &max_angular_speed, &max_linear_acceleration, &max_angular_acceleration);
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, WalkerGenerateLimits)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(ControllerFixture, WalkerGetLimit)(benchmark::State &state)
+{
+  LimitMap max_linear_speed;
+  walker_->generateLimits(&max_linear_speed);
+  Eigen::Vector2d linear_velocity_input(0.5, 0.25);
+  double angular_velocity_input = 0.1;
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(walker_->getLimit(linear_velocity_input, angular_velocity_input, max_linear_speed));
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, WalkerGetLimit);
+
+BENCHMARK_DEFINE_F(ControllerFixture, WalkerUpdateWalk)(benchmark::State &state)
+{
+  Eigen::Vector2d linear_velocity_input(0.5, 0.0);
+  double angular_velocity_input = 0.1;
+  for (auto _ : state)
+  {
+    model_->getCycleArena()->reset();
+    walker_->updateWalk(linear_velocity_input, angular_velocity_input);
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, WalkerUpdateWalk);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pose and admittance controller benchmarks
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_DEFINE_F(ControllerFixture, PoserUpdateCurrentPose)(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    model_->getCycleArena()->reset();
+    poser_->updateCurrentPose(RUNNING);
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, PoserUpdateCurrentPose);
+
+BENCHMARK_DEFINE_F(ControllerFixture, AdmittanceUpdateAdmittance)(benchmark::State &state)
+{
+  for (auto _ : state)
+  {
+    admittance_->updateAdmittance();
+  }
+}
+BENCHMARK_REGISTER_F(ControllerFixture, AdmittanceUpdateAdmittance);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Generates the shared controller stack from parameters on the ros param server (see launch/benchmarks.launch) and
+/// runs all registered benchmarks. Results are written as JSON to BENCHMARK_OUTPUT_FILE unless overridden by the
+/// --benchmark_out and --benchmark_out_format arguments.
+int main(int argc, char* argv[])
+{
+  if (!initBenchmarks(argc, argv, "shc_benchmarks", BENCHMARK_OUTPUT_FILE))
+  {
+    return 1;
+  }
+
+  // Initialise controller stack as per transition to RUNNING state
+  StateController state;
+  state.init();
+  state.initModel(true);
+  std::shared_ptr<Model> model = state.getModel();
+  state.getWalker()->init();
+  model->updateDefaultConfiguration();
+  model->generateWorkspaces();
+  state.getWalker()->generateWalkspace();
+  shc = &state;
+
+  benchmark::RunSpecifiedBenchmarks();
+  shc = NULL;
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
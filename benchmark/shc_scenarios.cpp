@@ -0,0 +1,523 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/state_controller.h"
+
+#include "benchmark_main.h"
+
+#include <chrono>
+#include <functional>
+
+#define BENCHMARK_OUTPUT_FILE "shc_scenarios.json" ///< Default file to which JSON results are written
+#define PHASE_TIMEOUT 60.0                         ///< Max duration of a conditional phase before aborting (seconds)
+#define STANCE_TIP_FORCE_SCALER 2.0                ///< Touchdown threshold scaler giving tip force of stance legs
+#define PLANNER_BODY_LIFT 0.02                     ///< Body lift of the planner body pose target (metres)
+#define PLANNER_TIP_LIFT 0.02                      ///< Tip lift of the planner tip pose targets (metres)
+
+/// Inputs applied by a scenario phase before each control cycle, given the number of the cycle within the phase
+typedef std::function<void(StateController*, const int&)> ScenarioInput;
+
+/// Condition ending a scenario phase, evaluated after each control cycle
+typedef std::function<bool(StateController*)> ScenarioCondition;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains a single phase of a scripted scenario. Inputs are applied by calling the state controller
+/// callbacks directly, emulating the remote, planner and sensor topics of a running system. A phase either runs until
+/// its completion condition is met (aborting the scenario if not met within PHASE_TIMEOUT) or for a fixed duration.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct ScenarioPhase
+{
+  std::string name_;           ///< Name of the phase used in error reporting
+  ScenarioInput input_;        ///< Inputs applied before each control cycle of the phase
+  ScenarioCondition complete_; ///< Condition on which the phase completes (if empty the phase runs for duration_)
+  double duration_ = 0.0;      ///< Duration of phase without completion condition (seconds, minimum of one cycle)
+  bool measured_ = true;       ///< Flags if control cycles of the phase are included in measurements
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains a scripted scenario, run on a newly constructed state controller stack.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Scenario
+{
+  std::map<std::string, bool> parameter_overrides_; ///< Parameters set on the ros param server during construction
+  std::vector<ScenarioPhase> phases_;               ///< Phases of the scenario, run in order
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scenario inputs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Generates an Int8 message as published by the remote for state and mode selections.
+/// @param[in] data The data of the message
+/// @return The Int8 message
+static std_msgs::Int8 int8Message(const int &data)
+{
+  std_msgs::Int8 msg;
+  msg.data = static_cast<int8_t>(data);
+  return msg;
+}
+
+/// Applies remote inputs requesting an operational system and the given robot state.
+/// @param[in] shc Pointer to the state controller
+/// @param[in] robot_state The requested robot state
+static void requestRobotState(StateController* shc, const RobotState &robot_state)
+{
+  shc->systemStateCallback(int8Message(OPERATIONAL));
+  shc->robotStateCallback(int8Message(robot_state));
+}
+
+/// Applies remote body velocity input.
+/// @param[in] shc Pointer to the state controller
+/// @param[in] linear_x The linear body velocity input in the x axis (-1.0 -> 1.0)
+/// @param[in] linear_y The linear body velocity input in the y axis (-1.0 -> 1.0)
+/// @param[in] angular_z The angular body velocity input about the z axis (-1.0 -> 1.0)
+static void inputBodyVelocity(StateController* shc, const double &linear_x, const double &linear_y,
+                              const double &angular_z)
+{
+  geometry_msgs::Twist msg;
+  msg.linear.x = linear_x;
+  msg.linear.y = linear_y;
+  msg.angular.z = angular_z;
+  shc->bodyVelocityInputCallback(msg);
+}
+
+/// Applies tip state sensor input, emulating tip force sensors on flat ground: legs in stance measure a vertical tip
+/// force above the touchdown threshold and legs in swing measure no tip force.
+/// @param[in] shc Pointer to the state controller
+static void inputTipStates(StateController* shc)
+{
+  const Parameters& params = shc->getParameters();
+  std::shared_ptr<Model> model = shc->getModel();
+  syropod_highlevel_controller::TipState msg;
+  LegContainer::iterator leg_it;
+  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> leg = leg_it->second;
+    geometry_msgs::Wrench wrench;
+    if (leg->getLegStepper()->getStepState() != SWING)
+    {
+      wrench.force.z = params.touchdown_threshold.data * STANCE_TIP_FORCE_SCALER;
+    }
+    msg.name.push_back(leg->getIDName() + "_tip");
+    msg.wrench.push_back(wrench);
+  }
+  shc->tipStatesCallback(msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Planner interface inputs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Publishes a plan step raising the body, emulating the planner interface.
+/// @param[in] shc Pointer to the state controller
+static void publishTargetBodyPose(StateController* shc)
+{
+  geometry_msgs::Pose msg = Pose(Eigen::Vector3d(0.0, 0.0, PLANNER_BODY_LIFT), Eigen::Quaterniond::Identity())
+                              .toPoseMessage();
+  shc->targetBodyPoseCallback(msg);
+}
+
+/// Publishes a plan step raising the tip of each leg, emulating the planner interface.
+/// @param[in] shc Pointer to the state controller
+static void publishTargetTipPoses(StateController* shc)
+{
+  std::shared_ptr<Model> model = shc->getModel();
+  syropod_highlevel_controller::TargetTipPose msg;
+  LegContainer::iterator leg_it;
+  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> leg = leg_it->second;
+    Pose target_tip_pose = leg->getCurrentTipPose();
+    target_tip_pose.position_[2] += PLANNER_TIP_LIFT;
+    geometry_msgs::PoseStamped target;
+    target.header.frame_id = "base_link";
+    target.pose = target_tip_pose.toPoseMessage();
+    msg.name.push_back(leg->getIDName());
+    msg.target.push_back(target);
+  }
+  shc->targetTipPoseCallback(msg);
+}
+
+/// Publishes a plan step returning all joints to their default positions (or holding their desired positions if no
+/// default position is defined), emulating the planner interface.
+/// @param[in] shc Pointer to the state controller
+static void publishTargetConfiguration(StateController* shc)
+{
+  std::shared_ptr<Model> model = shc->getModel();
+  sensor_msgs::JointState msg;
+  LegContainer::iterator leg_it;
+  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> leg = leg_it->second;
+    JointContainer::iterator joint_it;
+    for (joint_it = leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+    {
+      std::shared_ptr<Joint> joint = joint_it->second;
+      msg.name.push_back(joint->id_name_);
+      bool default_defined = joint->default_position_ != UNASSIGNED_VALUE;
+      msg.position.push_back(default_defined ? joint->default_position_ : joint->desired_position_);
+    }
+  }
+  shc->targetConfigurationCallback(msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scenario phases
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Generates a phase running the startup sequence from the initial unknown state to the RUNNING state.
+/// @param[in] measured Flags if control cycles of the phase are included in measurements
+/// @return The scenario phase
+static ScenarioPhase startupPhase(const bool &measured)
+{
+  ScenarioPhase phase;
+  phase.name_ = "startup";
+  phase.input_ = [](StateController* shc, const int&) { requestRobotState(shc, RUNNING); };
+  phase.complete_ = [](StateController* shc) { return shc->getRobotState() == RUNNING; };
+  phase.measured_ = measured;
+  return phase;
+}
+
+/// Generates a phase walking at constant body velocity input for a fixed duration.
+/// @param[in] linear_x The linear body velocity input in the x axis (-1.0 -> 1.0)
+/// @param[in] angular_z The angular body velocity input about the z axis (-1.0 -> 1.0)
+/// @param[in] duration The duration of the phase (seconds)
+/// @param[in] tip_states Flags if tip state sensor input is applied during the phase
+/// @return The scenario phase
+static ScenarioPhase walkPhase(const double &linear_x, const double &angular_z, const double &duration,
+                               const bool &tip_states = false)
+{
+  ScenarioPhase phase;
+  phase.name_ = "walk";
+  phase.input_ = [linear_x, angular_z, tip_states](StateController* shc, const int&)
+  {
+    inputBodyVelocity(shc, linear_x, 0.0, angular_z);
+    if (tip_states)
+    {
+      inputTipStates(shc);
+    }
+  };
+  phase.duration_ = duration;
+  return phase;
+}
+
+/// Generates a phase removing body velocity input until the walk controller has stopped.
+/// @param[in] tip_states Flags if tip state sensor input is applied during the phase
+/// @return The scenario phase
+static ScenarioPhase stopPhase(const bool &tip_states = false)
+{
+  ScenarioPhase phase = walkPhase(0.0, 0.0, 0.0, tip_states);
+  phase.name_ = "stop";
+  phase.complete_ = [](StateController* shc) { return shc->getWalker()->getWalkState() == STOPPED; };
+  return phase;
+}
+
+/// Generates a phase selecting a gait until the gait change has been applied.
+/// @param[in] gait_selection The selected gait
+/// @param[in] gait_type The name of the selected gait as per config/gait.yaml
+/// @return The scenario phase
+static ScenarioPhase gaitSelectionPhase(const GaitDesignation &gait_selection, const std::string &gait_type)
+{
+  ScenarioPhase phase;
+  phase.name_ = "gait_selection";
+  phase.input_ = [gait_selection](StateController* shc, const int&)
+  {
+    shc->gaitSelectionCallback(int8Message(gait_selection));
+  };
+  phase.complete_ = [gait_type](StateController* shc) { return shc->getParameters().gait_type.data == gait_type; };
+  return phase;
+}
+
+/// Generates a phase toggling the state of the first leg, selected as the primary leg, until it reaches the new state.
+/// @param[in] leg_state The new state of the leg (WALKING or MANUAL)
+/// @return The scenario phase
+static ScenarioPhase legStatePhase(const LegState &leg_state)
+{
+  ScenarioPhase phase;
+  phase.name_ = "leg_state";
+  phase.input_ = [leg_state](StateController* shc, const int&)
+  {
+    shc->primaryLegSelectionCallback(int8Message(LEG_0));
+    shc->primaryLegStateCallback(int8Message(leg_state));
+    shc->primaryTipVelocityInputCallback(geometry_msgs::Point());
+  };
+  phase.complete_ = [leg_state](StateController* shc)
+  {
+    return shc->getModel()->getLegByIDNumber(LEG_0)->getLegState() == leg_state;
+  };
+  return phase;
+}
+
+/// Generates a phase manipulating the tip of the primary manual leg around a circle for a fixed duration.
+/// @param[in] duration The duration of the phase (seconds)
+/// @return The scenario phase
+static ScenarioPhase manualTipPhase(const double &duration)
+{
+  ScenarioPhase phase;
+  phase.name_ = "manual_tip";
+  phase.input_ = [duration](StateController* shc, const int &cycle)
+  {
+    double angle = 2.0 * M_PI * cycle * shc->getParameters().time_delta.data / duration;
+    geometry_msgs::Point msg;
+    msg.x = cos(angle);
+    msg.z = sin(angle);
+    shc->primaryTipVelocityInputCallback(msg);
+  };
+  phase.duration_ = duration;
+  return phase;
+}
+
+/// Generates a phase switching planner mode.
+/// @param[in] planner_mode The new planner mode
+/// @return The scenario phase
+static ScenarioPhase plannerModePhase(const PlannerMode &planner_mode)
+{
+  ScenarioPhase phase;
+  phase.name_ = "planner_mode";
+  phase.input_ = [planner_mode](StateController* shc, const int&)
+  {
+    shc->plannerModeCallback(int8Message(planner_mode));
+  };
+  phase.duration_ = 0.0; // Single control cycle
+  return phase;
+}
+
+/// Generates a phase publishing a plan step on its first cycle, emulating the planner interface, until it executes.
+/// @param[in] publish_step Function applying the plan step to the state controller
+/// @return The scenario phase
+static ScenarioPhase planStepPhase(const std::function<void(StateController*)> &publish_step)
+{
+  ScenarioPhase phase;
+  phase.name_ = "plan_step";
+  std::shared_ptr<int> plan_step = std::make_shared<int>(0);
+  phase.input_ = [publish_step, plan_step](StateController* shc, const int &cycle)
+  {
+    if (cycle == 0)
+    {
+      *plan_step = shc->getPlanStep();
+      publish_step(shc);
+    }
+  };
+  phase.complete_ = [plan_step](StateController* shc) { return shc->getPlanStep() > *plan_step; };
+  return phase;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Scenarios
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Generates a scenario measuring the startup sequence from the initial unknown state to the RUNNING state.
+/// @return The scenario
+static Scenario startupScenario(void)
+{
+  Scenario scenario;
+  scenario.phases_.push_back(startupPhase(true));
+  return scenario;
+}
+
+/// Generates a scenario measuring tripod gait walking forward whilst rotating in each direction, then stopping.
+/// @return The scenario
+static Scenario tripodWalkingScenario(void)
+{
+  Scenario scenario;
+  scenario.phases_.push_back(startupPhase(false));
+  scenario.phases_.push_back(gaitSelectionPhase(TRIPOD_GAIT, "tripod_gait"));
+  scenario.phases_.push_back(walkPhase(0.5, 0.3, 10.0));
+  scenario.phases_.push_back(walkPhase(0.5, -0.3, 10.0));
+  scenario.phases_.push_back(stopPhase());
+  return scenario;
+}
+
+/// Generates a scenario measuring wave gait walking in rough terrain mode with tip force sensor input, then stopping.
+/// @return The scenario
+static Scenario waveGaitRoughTerrainScenario(void)
+{
+  Scenario scenario;
+  scenario.parameter_overrides_["rough_terrain_mode"] = true;
+  scenario.phases_.push_back(startupPhase(false));
+  scenario.phases_.push_back(gaitSelectionPhase(WAVE_GAIT, "wave_gait"));
+  scenario.phases_.push_back(walkPhase(0.5, 0.0, 20.0, true));
+  scenario.phases_.push_back(stopPhase(true));
+  return scenario;
+}
+
+/// Generates a scenario measuring manual manipulation of a leg: transitioning the leg to the MANUAL state, moving its
+/// tip and returning it to the WALKING state before walking with all legs.
+/// @return The scenario
+static Scenario manualLegScenario(void)
+{
+  Scenario scenario;
+  scenario.phases_.push_back(startupPhase(false));
+  scenario.phases_.push_back(legStatePhase(MANUAL));
+  scenario.phases_.push_back(manualTipPhase(5.0));
+  scenario.phases_.push_back(legStatePhase(WALKING));
+  scenario.phases_.push_back(walkPhase(0.5, 0.0, 5.0));
+  scenario.phases_.push_back(stopPhase());
+  return scenario;
+}
+
+/// Generates a scenario measuring planner mode: entering planner mode, executing body pose, tip pose and configuration
+/// plan steps and leaving planner mode before walking.
+/// @return The scenario
+static Scenario plannerModeScenario(void)
+{
+  Scenario scenario;
+  scenario.phases_.push_back(startupPhase(false));
+  scenario.phases_.push_back(plannerModePhase(PLANNER_MODE_ON));
+  scenario.phases_.push_back(planStepPhase(publishTargetBodyPose));
+  scenario.phases_.push_back(planStepPhase(publishTargetTipPoses));
+  scenario.phases_.push_back(planStepPhase(publishTargetConfiguration));
+  scenario.phases_.push_back(plannerModePhase(PLANNER_MODE_OFF));
+  scenario.phases_.push_back(walkPhase(0.5, 0.0, 5.0));
+  scenario.phases_.push_back(stopPhase());
+  return scenario;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runs the phases of a scenario on a state controller, emulating the main ros loop without sleeping between cycles.
+/// The latency of each measured control cycle (sensor sampling, state controller update and publishing) is sampled.
+/// @param[in] shc Pointer to the state controller
+/// @param[in] scenario The scenario to run
+/// @param[out] latency Timing statistics to which the latency of each measured control cycle is added
+/// @param[out] allocations Allocation statistics to which heap allocations of each measured control cycle are added
+/// @param[out] measured_time The summed latency of all measured control cycles (seconds)
+/// @return Error message if a phase failed to complete, otherwise an empty string
+static std::string runPhases(StateController* shc, const Scenario &scenario,
+                             TimingStatistics* latency, AllocationStatistics* allocations, double* measured_time)
+{
+  double time_delta = shc->getParameters().time_delta.data;
+  std::vector<ScenarioPhase>::const_iterator phase_it;
+  for (phase_it = scenario.phases_.begin(); phase_it != scenario.phases_.end(); ++phase_it)
+  {
+    const ScenarioPhase& phase = *phase_it;
+    bool conditional = static_cast<bool>(phase.complete_);
+    int cycle_limit = std::max(1, roundToInt((conditional ? PHASE_TIMEOUT : phase.duration_) / time_delta));
+    bool complete = false;
+    for (int cycle = 0; cycle < cycle_limit && !complete; ++cycle)
+    {
+      phase.input_(shc, cycle);
+      AllocationCounts allocation_start = getThreadAllocationCounts();
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      shc->updateSensorData();
+      shc->runControlCycle();
+      std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+      if (phase.measured_)
+      {
+        latency->addSample(duration.count());
+        allocations->addSample(allocation_start, getThreadAllocationCounts());
+        *measured_time += duration.count();
+      }
+      complete = conditional && phase.complete_(shc);
+    }
+    if (conditional && !complete)
+    {
+      return "Scenario phase '" + phase.name_ + "' did not complete within " + numberToString(PHASE_TIMEOUT) + "s";
+    }
+  }
+  return "";
+}
+
+/// Benchmarks a scripted scenario end-to-end on a full state controller stack, newly constructed for each iteration
+/// from parameters on the ros param server (see launch/benchmarks.launch). Iteration time is the summed latency of the
+/// measured control cycles only. Reports the rate of control cycles and percentiles of control cycle latency, which
+/// are estimated from the timing statistics histogram to within its bucket resolution. If heap allocation tracking is
+/// compiled in (SHC_TRACK_ALLOCATIONS), also reports the mean and max heap allocations per measured control cycle.
+/// @param[in] state The benchmark state
+/// @param[in] scenario The scenario to benchmark
+static void EndToEnd(benchmark::State &state, const Scenario &scenario)
+{
+  TimingStatistics latency;
+  AllocationStatistics allocations;
+  double total_measured_time = 0.0;
+  for (auto _ : state)
+  {
+    // Override parameters on the ros param server whilst the state controller reads its parameters
+    std::map<std::string, bool> overridden;
+    std::map<std::string, bool>::const_iterator override_it;
+    for (override_it = scenario.parameter_overrides_.begin(); override_it != scenario.parameter_overrides_.end();
+         ++override_it)
+    {
+      std::string name = "syropod/parameters/" + override_it->first;
+      bool value;
+      if (ros::param::get(name, value))
+      {
+        overridden[name] = value;
+      }
+      ros::param::set(name, override_it->second);
+    }
+
+    double measured_time = 0.0;
+    std::string error;
+    {
+      StateController shc;
+      for (override_it = scenario.parameter_overrides_.begin(); override_it != scenario.parameter_overrides_.end();
+           ++override_it)
+      {
+        std::string name = "syropod/parameters/" + override_it->first;
+        if (overridden.find(name) != overridden.end())
+        {
+          ros::param::set(name, overridden[name]);
+        }
+        else
+        {
+          ros::param::del(name);
+        }
+      }
+      shc.init();
+      shc.initModel(true);
+      error = runPhases(&shc, scenario, &latency, &allocations, &measured_time);
+    }
+
+    if (!error.empty())
+    {
+      state.SkipWithError(error.c_str());
+      break;
+    }
+    state.SetIterationTime(measured_time);
+    total_measured_time += measured_time;
+  }
+
+  int cycle_count = latency.getSampleCount();
+  state.counters["cycles"] = benchmark::Counter(cycle_count, benchmark::Counter::kAvgIterations);
+  state.counters["cycles_per_second"] = total_measured_time > 0.0 ? cycle_count / total_measured_time : 0.0;
+  state.counters["latency_mean_us"] = latency.getMean() * 1.0e6;
+  state.counters["latency_p50_us"] = latency.getPercentile(0.5) * 1.0e6;
+  state.counters["latency_p90_us"] = latency.getPercentile(0.9) * 1.0e6;
+  state.counters["latency_p99_us"] = latency.getPercentile(0.99) * 1.0e6;
+  state.counters["latency_max_us"] = latency.getMax() * 1.0e6;
+  if (allocationTrackingEnabled())
+  {
+    state.counters["allocations_mean"] = allocations.getMeanAllocations();
+    state.counters["allocations_max"] = allocations.getMaxAllocations();
+    state.counters["allocated_bytes_mean"] = allocations.getMeanBytes();
+  }
+}
+
+BENCHMARK_CAPTURE(EndToEnd, StartupSequence, startupScenario())->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(EndToEnd, TripodWalking, tripodWalkingScenario())->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(EndToEnd, WaveGaitRoughTerrain, waveGaitRoughTerrainScenario())
+  ->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(EndToEnd, ManualLeg, manualLegScenario())->UseManualTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(EndToEnd, PlannerMode, plannerModeScenario())->UseManualTime()->Unit(benchmark::kMillisecond);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runs all registered scenario benchmarks. Results are written as JSON to BENCHMARK_OUTPUT_FILE unless overridden by
+/// the --benchmark_out and --benchmark_out_format arguments.
+int main(int argc, char* argv[])
+{
+  if (!initBenchmarks(argc, argv, "shc_scenarios", BENCHMARK_OUTPUT_FILE))
+  {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -10,12 +10,60 @@
 #define SYROPOD_HIGHLEVEL_CONTROLLER_ADMITTANCE_CONTROLLER_H
 
 #include "standard_includes.h"
+#include "realtime_loop.h"
 #include "parameters_and_states.h"
-#include <boost/numeric/odeint.hpp>
+#include "latest_value.h"
+#include <unsupported/Eigen/MatrixFunctions>
+#include <boost/lockfree/spsc_queue.hpp>
 
 #include "model.h"
 
 #define ADMITTANCE_DEADBAND 0.0
+#define TIP_FORCE_QUEUE_SIZE 256 ///< Maximum number of tip force samples queued for the admittance thread
+
+// Arrays of admittance variables for all legs (one column per leg indexed by leg id number), stored row major such
+// that each component is contiguous across legs for the vectorised update of all legs
+typedef Eigen::Array<double, 2, Eigen::Dynamic, Eigen::RowMajor> AdmittanceArray2Xd;
+typedef Eigen::Array<double, 3, Eigen::Dynamic, Eigen::RowMajor> AdmittanceArray3Xd;
+typedef Eigen::Array<double, 4, Eigen::Dynamic, Eigen::RowMajor> AdmittanceArray4Xd;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Object containing the exact (zero-order hold) discretisation of the mass/spring/damper system of the admittance
+/// controller, along with the system characteristics and integrator step time from which it was generated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct AdmittanceDiscretisation
+{
+  double mass_ = 0.0;          ///< The virtual mass of the discretised system
+  double stiffness_ = 0.0;     ///< The virtual stiffness of the discretised system
+  double damping_ratio_ = 0.0; ///< The virtual damping ratio of the discretised system
+  double step_time_ = 0.0;     ///< The integrator step time of the discretised system
+  Eigen::Matrix2d state_transition_ = Eigen::Matrix2d::Identity(); ///< Maps state over a single integrator step
+  Eigen::Vector2d input_response_ = Eigen::Vector2d::Zero();        ///< Maps force input held over a single step
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Object containing the characteristics of the mass/spring/damper systems of all legs for a single admittance update.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct AdmittanceCharacteristics
+{
+  double mass_ = 0.0;          ///< The virtual mass of the system of each leg
+  double damping_ratio_ = 0.0; ///< The virtual damping ratio of the system of each leg
+  double step_time_ = 0.0;     ///< The integrator step time of each admittance update
+  double force_gain_ = 0.0;    ///< The gain applied to the tip force input of each leg
+  Eigen::ArrayXd stiffness_;   ///< The virtual stiffness of the system of each leg (indexed by leg id number)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Object containing a tip force sample of a leg, passed to the admittance thread as it arrives.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TipForceSample
+{
+  int leg_id_number_ = 0;       ///< The id number of the leg
+  Eigen::Vector3d tip_force_;   ///< The tip force of the leg
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This class handles the application of an admittance controller to the robot model. Specifically it calculates a
@@ -34,12 +82,44 @@ public:
   /// @param[in] model Pointer to the robot model class object
   /// @param[in] params Pointer to the parameter struct object  
   AdmittanceController(std::shared_ptr<Model> model, const Parameters& params);
+
+  /// AdmittanceController object destructor. Stops the admittance thread if running.
+  ~AdmittanceController(void);
   
-  /// Iterates through legs in the robot model and updates the tip position offset value for each.
-  /// The calculation is achieved through the use of a classical Runge-Kutta ODE solver with a force input
-  /// acquired from a tip force callback OR from estimation from joint effort values.
+  /// Updates the tip position offset value for all legs in the robot model. The calculation is achieved through an
+  /// exact (zero-order hold) discretisation of the mass/spring/damper system of each leg with a force input acquired
+  /// from a tip force callback OR from estimation from joint effort values. Legs use the virtual stiffness generated
+  /// by the dynamic stiffness system if enabled. The system update, clamping and deadbanding are applied to the
+  /// admittance state of all legs simultaneously. If the admittance thread is running, the calculation is instead
+  /// performed on the admittance thread and this function passes the current system characteristics to the thread and
+  /// applies the latest tip position offsets generated by the thread.
   /// @todo Implement admittance control in x/y axis
   void updateAdmittance(void);
+
+  /// Starts the admittance thread if the admittance rate parameter is set.
+  /// @return Flag denoting whether the admittance thread was started
+  bool startAdmittanceThread(void);
+
+  /// Stops the admittance thread, if running, and waits for it to finish.
+  void stopAdmittanceThread(void);
+
+  /// Passes a tip force sample of a leg to the admittance thread, if running.
+  /// @param[in] leg_id_number The id number of the leg
+  /// @param[in] tip_force The tip force of the leg
+  /// @return Flag denoting whether the sample was passed to the admittance thread
+  bool pushTipForce(const int &leg_id_number, const Eigen::Vector3d &tip_force);
+
+  /// Regenerates the exact (zero-order hold) discretisation of the mass/spring/damper system if the input system
+  /// characteristics or integrator step time differ from those used to generate the existing discretisation. The
+  /// state transition and input response matrices are generated from the exponential of the augmented system matrix.
+  /// @param[in] mass The virtual mass of the system
+  /// @param[in] stiffness The virtual stiffness of the system
+  /// @param[in] damping_ratio The virtual damping ratio of the system
+  /// @param[in] step_time The integrator step time
+  /// @param[out] discretisation Pointer to the discretisation object to update
+  /// @return Flag denoting if the discretisation was regenerated
+  bool updateDiscretisation(const double &mass, const double &stiffness, const double &damping_ratio,
+                            const double &step_time, AdmittanceDiscretisation *discretisation);
   
   /// Scales virtual stiffness of an input swinging leg and two 'adjacent legs' according to an input reference.
   /// The input reference ranges between 0.0 and 1.0, and defines the characteristic of the curve as stiffness changes
@@ -61,9 +141,44 @@ public:
   void updateStiffness(std::shared_ptr<WalkController> walker);
 
 private:
+  /// Updates the system characteristics of all legs from parameters and the virtual stiffness of each leg.
+  void updateCharacteristics(void);
+
+  /// Advances the mass/spring/damper system of all legs for the current tip force inputs and generates tip position
+  /// offsets with clamping and deadbanding applied.
+  /// @param[in] characteristics The system characteristics of all legs
+  void integrateAdmittance(const AdmittanceCharacteristics &characteristics);
+
+  /// Loop of the admittance thread. Consumes queued tip force samples and updates admittance at the admittance rate
+  /// until the admittance thread is stopped.
+  void admittanceLoop(void);
+
   std::shared_ptr<Model> model_; ///< Pointer to the robot model object
   const Parameters &params_;     ///< Pointer to parameter data structure for storing parameter variables
 
+  AdmittanceCharacteristics characteristics_;    ///< Current system characteristics of all legs
+  AdmittanceArray3Xd applied_admittance_delta_; ///< Tip position offsets applied to each leg
+
+  /// Discretisations of the mass/spring/damper system of each leg (indexed by leg id number)
+  std::vector<AdmittanceDiscretisation, Eigen::aligned_allocator<AdmittanceDiscretisation>> discretisations_;
+
+  // Admittance variables for all legs
+  AdmittanceArray4Xd state_transition_; ///< State transition matrix (elements in row major order) for each leg
+  AdmittanceArray2Xd input_response_;   ///< Input response vector for each leg
+  AdmittanceArray2Xd admittance_state_; ///< Admittance state (position, velocity) of each leg
+  AdmittanceArray3Xd tip_force_;        ///< Tip force of each leg
+  AdmittanceArray3Xd force_input_;      ///< Force input to the system of each leg
+  AdmittanceArray3Xd admittance_delta_; ///< Tip position offset of each leg
+
+  // Admittance thread variables
+  std::thread admittance_thread_;                        ///< Thread updating admittance at the admittance rate
+  std::atomic<bool> admittance_thread_running_{ false }; ///< Flags if the admittance thread is running
+  LatestValue<AdmittanceCharacteristics> characteristics_input_; ///< Latest system characteristics passed to thread
+  LatestValue<AdmittanceArray3Xd> admittance_delta_output_;      ///< Latest tip position offsets generated by thread
+
+  /// Queue of tip force samples passed to the admittance thread as they arrive
+  boost::lockfree::spsc_queue<TipForceSample, boost::lockfree::capacity<TIP_FORCE_QUEUE_SIZE>> tip_force_queue_;
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_ALLOCATION_TRACKING_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_ALLOCATION_TRACKING_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#define ALLOCATION_BACKTRACE_DEPTH 32 ///< Max number of stack frames logged by the allocation guard
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for potential actions of the allocation guard upon a heap allocation.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum AllocationGuardMode
+{
+  ALLOCATION_GUARD_OFF,        ///< Allocations are permitted
+  ALLOCATION_GUARD_LOG,        ///< The first allocation logs a backtrace, later allocations are only counted
+  ALLOCATION_GUARD_ABORT,      ///< Any allocation logs a backtrace and aborts the process
+  ALLOCATION_GUARD_MODE_COUNT, ///< Misc enum defining number of Allocation Guard Modes
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains the running count of heap allocations made by a single thread.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct AllocationCounts
+{
+  uint64_t allocations_ = 0;      ///< Count of heap allocations (including reallocations)
+  uint64_t bytes_ = 0;            ///< Count of bytes requested by heap allocations
+  uint64_t deallocations_ = 0;    ///< Count of heap deallocations
+  uint64_t guard_violations_ = 0; ///< Count of heap allocations made whilst the allocation guard was armed
+};
+
+/// Flags if heap allocation tracking is compiled in (see SHC_TRACK_ALLOCATIONS in CMakeLists.txt). If not, allocation
+/// counts remain zero and the allocation guard has no effect.
+/// @return Flag denoting if heap allocation tracking is enabled
+bool allocationTrackingEnabled(void);
+
+/// Accessor for the running count of heap allocations made by the calling thread.
+/// @return The allocation counts of the calling thread
+AllocationCounts getThreadAllocationCounts(void);
+
+/// Arms the allocation guard of the calling thread, such that heap allocations made by the thread are logged with a
+/// backtrace or abort the process as per the given mode.
+/// @param[in] mode The action of the allocation guard upon a heap allocation
+void armAllocationGuard(const AllocationGuardMode &mode);
+
+/// Disarms the allocation guard of the calling thread.
+void disarmAllocationGuard(void);
+
+/// Resets the latch of the allocation guard of the calling thread. In ALLOCATION_GUARD_LOG mode only the first guarded
+/// allocation after a reset logs a backtrace, such that an allocating loop does not log every cycle. Later guarded
+/// allocations are only counted (see AllocationCounts::guard_violations_).
+void resetAllocationGuard(void);
+
+/// Converts the name of an allocation guard mode (off, log or abort) to its designation.
+/// @param[in] name The name of the allocation guard mode
+/// @return The allocation guard mode, or ALLOCATION_GUARD_OFF if the name is unknown
+AllocationGuardMode allocationGuardModeFromName(const std::string &name);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class aggregates the heap allocations made during samples of a tracked stage (e.g. a control cycle stage).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class AllocationStatistics
+{
+public:
+  /// Constructor for allocation statistics object.
+  AllocationStatistics(void) { reset(); };
+
+  /// Accessor for count of samples.
+  /// @return Count of samples since last reset
+  inline int getSampleCount(void) { return sample_count_; };
+
+  /// Accessor for mean count of allocations per sample.
+  /// @return Mean count of heap allocations per sample since last reset
+  inline double getMeanAllocations(void) { return sample_count_ > 0 ? double(allocations_) / sample_count_ : 0.0; };
+
+  /// Accessor for maximum count of allocations in a sample.
+  /// @return Maximum count of heap allocations in a sample since last reset
+  inline uint64_t getMaxAllocations(void) { return max_allocations_; };
+
+  /// Accessor for mean count of allocated bytes per sample.
+  /// @return Mean count of bytes requested by heap allocations per sample since last reset
+  inline double getMeanBytes(void) { return sample_count_ > 0 ? double(bytes_) / sample_count_ : 0.0; };
+
+  /// Adds a sample of the heap allocations made during a tracked stage.
+  /// @param[in] start The allocation counts of the tracking thread at the start of the stage
+  /// @param[in] end The allocation counts of the tracking thread at the end of the stage
+  inline void addSample(const AllocationCounts &start, const AllocationCounts &end)
+  {
+    uint64_t allocations = end.allocations_ - start.allocations_;
+    sample_count_++;
+    allocations_ += allocations;
+    bytes_ += end.bytes_ - start.bytes_;
+    max_allocations_ = std::max(max_allocations_, allocations);
+  };
+
+  /// Resets all statistics.
+  inline void reset(void)
+  {
+    sample_count_ = 0;
+    allocations_ = 0;
+    bytes_ = 0;
+    max_allocations_ = 0;
+  };
+
+private:
+  int sample_count_;         ///< Count of samples
+  uint64_t allocations_;     ///< Sum of heap allocations over all samples
+  uint64_t bytes_;           ///< Sum of allocated bytes over all samples
+  uint64_t max_allocations_; ///< Maximum count of heap allocations in a sample
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_ALLOCATION_TRACKING_H
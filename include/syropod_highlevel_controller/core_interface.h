@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_CORE_INTERFACE_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_CORE_INTERFACE_H
+
+#include <xmlrpcpp/XmlRpcValue.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#define LOG_MESSAGE_SIZE 1024 ///< Maximum length of a formatted log message (longer messages are truncated)
+
+/// Source location (file, line and function) of a logged message, as passed to logMessage by the logging macros
+#define SHC_LOG_LOCATION __FILE__, __LINE__, __PRETTY_FUNCTION__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Severity of messages logged by the core library, matching the levels of rosconsole.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum LogLevel
+{
+  DEBUG_LOG_LEVEL,  ///< Debugging information, disabled by default
+  INFO_LOG_LEVEL,   ///< Information on normal operation
+  WARN_LOG_LEVEL,   ///< Unexpected conditions from which operation continues
+  ERROR_LOG_LEVEL,  ///< Failures from which operation may continue in a degraded state
+  FATAL_LOG_LEVEL,  ///< Failures from which operation cannot continue
+  LOG_LEVEL_COUNT,  ///< Misc enum defining number of LogLevels
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class is the interface through which the core library (the robot model and the walk, pose and admittance
+/// controllers) accesses the services of its host: parameter lookup, logging, time and shutdown. The core library holds
+/// no dependency on roscpp: the node provides a ros implementation of this interface (see RosInterface) whilst this
+/// default implementation allows the core library to run without ros (e.g. in tests and simulators), providing no
+/// parameters, logging to stderr and measuring time on the monotonic clock.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CoreInterface
+{
+public:
+  /// Destructor for core interface object.
+  virtual ~CoreInterface(void) = default;
+
+  /// Looks up a parameter from the host.
+  /// @param[in] key The name of the parameter, relative to the node namespace
+  /// @param[out] value Pointer to the value to populate with the parameter
+  /// @return Flag denoting if the parameter was found
+  virtual bool getParameter(const std::string &key, XmlRpc::XmlRpcValue* value);
+
+  /// Determines if messages of the given level are logged, such that disabled messages are not formatted.
+  /// @param[in] level The level of the message
+  /// @return Flag denoting if messages of the given level are logged
+  virtual bool isLogEnabled(const LogLevel &level);
+
+  /// Logs a formatted message.
+  /// @param[in] level The level of the message
+  /// @param[in] file The source file from which the message was logged
+  /// @param[in] line The line of the source file from which the message was logged
+  /// @param[in] function The function from which the message was logged
+  /// @param[in] message The formatted message
+  virtual void log(const LogLevel &level, const char* file, const int &line, const char* function,
+                   const char* message);
+
+  /// Accessor for the current time of the host, used to throttle logged messages.
+  /// @return The current time (seconds)
+  virtual double now(void);
+
+  /// Determines if the host is running, such that threads of the core library should continue.
+  /// @return Flag denoting if the host is running
+  virtual bool ok(void);
+
+  /// Requests shutdown of the host due to an unrecoverable error in the core library.
+  virtual void shutdown(void);
+
+private:
+  std::atomic<bool> shutdown_requested_{ false }; ///< Flag denoting if shutdown has been requested
+};
+
+/// Sets the interface through which the core library accesses its host. Must be called before any object of the core
+/// library is constructed.
+/// @param[in] core_interface A pointer to the host implementation of the core interface
+void setCoreInterface(std::shared_ptr<CoreInterface> core_interface);
+
+/// Accessor for the interface through which the core library accesses its host.
+/// @return Pointer to the interface set by the host, otherwise to the default interface
+CoreInterface* getCoreInterface(void);
+
+/// Formats a message into a fixed size buffer on the stack (such that logging does not allocate) and logs it via the
+/// core interface.
+/// @param[in] level The level of the message
+/// @param[in] file The source file from which the message was logged
+/// @param[in] line The line of the source file from which the message was logged
+/// @param[in] function The function from which the message was logged
+/// @param[in] format The printf style format of the message
+void logMessage(const LogLevel &level, const char* file, const int &line, const char* function,
+                const char* format, ...) __attribute__((format(printf, 5, 6)));
+
+#define SHC_LOG(level, ...)                                                                                            \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (getCoreInterface()->isLogEnabled(level))                                                                       \
+    {                                                                                                                  \
+      logMessage(level, SHC_LOG_LOCATION, __VA_ARGS__);                                                                \
+    }                                                                                                                  \
+  } while (false)
+
+#define SHC_LOG_COND(cond, level, ...)                                                                                 \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if ((cond) && getCoreInterface()->isLogEnabled(level))                                                             \
+    {                                                                                                                  \
+      logMessage(level, SHC_LOG_LOCATION, __VA_ARGS__);                                                                \
+    }                                                                                                                  \
+  } while (false)
+
+#define SHC_LOG_THROTTLE(period, level, ...)                                                                           \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    static double shc_throttle_last_hit = 0.0;                                                                         \
+    double shc_throttle_now = getCoreInterface()->now();                                                               \
+    if (shc_throttle_last_hit + (period) <= shc_throttle_now && getCoreInterface()->isLogEnabled(level))               \
+    {                                                                                                                  \
+      shc_throttle_last_hit = shc_throttle_now;                                                                        \
+      logMessage(level, SHC_LOG_LOCATION, __VA_ARGS__);                                                                \
+    }                                                                                                                  \
+  } while (false)
+
+#define SHC_DEBUG(...) SHC_LOG(DEBUG_LOG_LEVEL, __VA_ARGS__)
+#define SHC_INFO(...) SHC_LOG(INFO_LOG_LEVEL, __VA_ARGS__)
+#define SHC_WARN(...) SHC_LOG(WARN_LOG_LEVEL, __VA_ARGS__)
+#define SHC_ERROR(...) SHC_LOG(ERROR_LOG_LEVEL, __VA_ARGS__)
+#define SHC_FATAL(...) SHC_LOG(FATAL_LOG_LEVEL, __VA_ARGS__)
+
+#define SHC_DEBUG_COND(cond, ...) SHC_LOG_COND(cond, DEBUG_LOG_LEVEL, __VA_ARGS__)
+#define SHC_INFO_COND(cond, ...) SHC_LOG_COND(cond, INFO_LOG_LEVEL, __VA_ARGS__)
+#define SHC_WARN_COND(cond, ...) SHC_LOG_COND(cond, WARN_LOG_LEVEL, __VA_ARGS__)
+#define SHC_ERROR_COND(cond, ...) SHC_LOG_COND(cond, ERROR_LOG_LEVEL, __VA_ARGS__)
+#define SHC_FATAL_COND(cond, ...) SHC_LOG_COND(cond, FATAL_LOG_LEVEL, __VA_ARGS__)
+
+#define SHC_DEBUG_THROTTLE(period, ...) SHC_LOG_THROTTLE(period, DEBUG_LOG_LEVEL, __VA_ARGS__)
+#define SHC_INFO_THROTTLE(period, ...) SHC_LOG_THROTTLE(period, INFO_LOG_LEVEL, __VA_ARGS__)
+#define SHC_WARN_THROTTLE(period, ...) SHC_LOG_THROTTLE(period, WARN_LOG_LEVEL, __VA_ARGS__)
+#define SHC_ERROR_THROTTLE(period, ...) SHC_LOG_THROTTLE(period, ERROR_LOG_LEVEL, __VA_ARGS__)
+#define SHC_FATAL_THROTTLE(period, ...) SHC_LOG_THROTTLE(period, FATAL_LOG_LEVEL, __VA_ARGS__)
+
+// Assertions are compiled out of release builds, as per ROS_ASSERT.
+#ifdef NDEBUG
+#define SHC_ASSERT(cond)                                                                                               \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    (void)sizeof(cond);                                                                                                \
+  } while (false)
+#else
+#define SHC_ASSERT(cond)                                                                                               \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    if (!(cond))                                                                                                       \
+    {                                                                                                                  \
+      logMessage(FATAL_LOG_LEVEL, SHC_LOG_LOCATION, "ASSERTION FAILED\n\tfile = %s\n\tline = %d\n\tcond = %s\n",       \
+                 __FILE__, __LINE__, #cond);                                                                           \
+      std::abort();                                                                                                    \
+    }                                                                                                                  \
+  } while (false)
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_CORE_INTERFACE_H
@@ -0,0 +1,233 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_ARENA_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_ARENA_H
+
+#include "standard_includes.h"
+
+#include <new>
+
+#define DEFAULT_CYCLE_ARENA_CAPACITY 65536 ///< Default initial capacity of a cycle arena (bytes)
+#define CYCLE_ARENA_ALIGNMENT 64           ///< Minimum alignment of arena allocations, suits Eigen maps (bytes)
+#define CYCLE_ARENA_OVERFLOW_RESERVE 64    ///< Number of heap fallback allocations tracked without reallocation
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Object marking the memory allocated from a cycle arena at a point in time, to which the arena may be rewound.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct CycleArenaMarker
+{
+  size_t offset_ = 0;         ///< The offset of the next free byte of the region
+  size_t overflow_count_ = 0; ///< The number of live heap fallback allocations
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class is a monotonic arena providing scratch memory for transient data of a single control cycle. Allocation
+/// advances an offset into a preallocated region and deallocation is a no-op, such that scratch memory is acquired
+/// without heap calls or fragmentation. All memory is reclaimed at once by reset() at the start of each control cycle,
+/// hence memory allocated from the arena must not be held across cycles. Memory allocated within a CycleArenaScope is
+/// instead reclaimed when the scope ends, which bounds usage by code which is also run outside of control cycles (e.g.
+/// workspace generation and direct start up). Allocations which exceed the remaining capacity fall back to the heap
+/// and are tracked such that they are freed alongside the region memory, and the region is grown upon the following
+/// reset to fit the peak usage of the cycle. The arena is not thread safe and must only be used by the thread owning
+/// it.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CycleArena
+{
+public:
+  /// Constructor for cycle arena object. Preallocates the region from which memory is allocated.
+  /// @param[in] capacity The initial capacity of the region (bytes)
+  CycleArena(const size_t &capacity = DEFAULT_CYCLE_ARENA_CAPACITY);
+
+  /// Destructor for cycle arena object. Releases the region from which memory is allocated and any heap fallback
+  /// allocations.
+  ~CycleArena(void);
+
+  CycleArena(const CycleArena &) = delete;
+  CycleArena& operator=(const CycleArena &) = delete;
+
+  /// Accessor for capacity of the region from which memory is allocated.
+  /// @return The capacity of the region (bytes)
+  inline size_t getCapacity(void) { return capacity_; };
+
+  /// Accessor for memory allocated since the last reset.
+  /// @return The memory allocated from the arena since the last reset, including heap fallback allocations (bytes)
+  inline size_t getUsed(void) { return offset_ + overflow_bytes_; };
+
+  /// Accessor for peak memory allocated in a single cycle.
+  /// @return The maximum memory allocated from the arena between resets (bytes)
+  inline size_t getPeakUsed(void) { return std::max(std::max(peak_used_, cycle_peak_used_), getUsed()); };
+
+  /// Accessor for a marker of the memory currently allocated from the arena.
+  /// @return Marker to which the arena may be rewound
+  inline CycleArenaMarker getMarker(void)
+  {
+    CycleArenaMarker marker;
+    marker.offset_ = offset_;
+    marker.overflow_count_ = overflow_blocks_.size();
+    return marker;
+  };
+
+  /// Accessor for count of heap fallback allocations.
+  /// @return The count of allocations which exceeded the capacity of the region since construction
+  inline uint64_t getOverflowCount(void) { return overflow_count_; };
+
+  /// Allocates memory from the arena, falling back to the heap if the remaining capacity is insufficient.
+  /// @param[in] size The size of the allocation (bytes)
+  /// @param[in] alignment The required alignment of the allocation (bytes, power of two)
+  /// @return Pointer to the allocated memory
+  inline void* allocate(const size_t &size, const size_t &alignment = CYCLE_ARENA_ALIGNMENT)
+  {
+    size_t aligned_alignment = std::max(alignment, size_t(CYCLE_ARENA_ALIGNMENT));
+    size_t start = (offset_ + aligned_alignment - 1) & ~(aligned_alignment - 1);
+    if (start + size <= capacity_)
+    {
+      offset_ = start + size;
+      return buffer_ + start;
+    }
+    return allocateOverflow(size, aligned_alignment);
+  };
+
+  /// Deallocates memory allocated from the arena. This is a no-op, memory (including heap fallback allocations) is
+  /// only reclaimed upon rewind or reset.
+  inline void deallocate(void*) {};
+
+  /// Reclaims all memory allocated from the arena since the marker was taken, including freeing heap fallback
+  /// allocations. Memory allocated since the marker must no longer be in use.
+  /// @param[in] marker The marker to which the arena is rewound
+  void rewind(const CycleArenaMarker &marker);
+
+  /// Reclaims all memory allocated from the arena. If any allocations fell back to the heap since the last reset, the
+  /// region is reallocated with capacity to fit the peak usage such that subsequent cycles are served by the region.
+  void reset(void);
+
+private:
+  /// Allocates memory from the heap when the remaining capacity of the region is insufficient.
+  /// @param[in] size The size of the allocation (bytes)
+  /// @param[in] alignment The required alignment of the allocation (bytes)
+  /// @return Pointer to the allocated memory
+  void* allocateOverflow(const size_t &size, const size_t &alignment);
+
+  /// Frees heap fallback allocations made since the given number of live heap fallback allocations.
+  /// @param[in] overflow_count The number of heap fallback allocations to keep
+  void freeOverflow(const size_t &overflow_count);
+
+  /// Object containing a heap fallback allocation.
+  struct OverflowBlock
+  {
+    void* pointer_;    ///< Pointer to the allocated memory
+    size_t size_;      ///< The size of the allocation (bytes)
+    size_t alignment_; ///< The alignment of the allocation (bytes)
+  };
+
+  char* buffer_ = NULL;                        ///< The region from which memory is allocated
+  size_t capacity_ = 0;                        ///< The capacity of the region (bytes)
+  size_t offset_ = 0;                          ///< The offset of the next free byte of the region
+  std::vector<OverflowBlock> overflow_blocks_; ///< Live heap fallback allocations
+  size_t overflow_bytes_ = 0;                  ///< Memory of live heap fallback allocations (bytes)
+  bool overflowed_ = false;                    ///< Flags if any allocations fell back to the heap since the last reset
+  size_t cycle_peak_used_ = 0;                 ///< The maximum memory allocated since the last reset (bytes)
+  size_t peak_used_ = 0;                       ///< The maximum memory allocated from the arena between resets (bytes)
+  uint64_t overflow_count_ = 0;                ///< Count of heap fallback allocations since construction
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class rewinds a cycle arena to the memory allocated upon its construction when it goes out of scope, such that
+/// memory allocated from the arena within the scope of a function is reclaimed when the function returns.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class CycleArenaScope
+{
+public:
+  /// Constructor for cycle arena scope object. Marks the memory currently allocated from the arena.
+  /// @param[in] arena Pointer to the cycle arena to be rewound
+  CycleArenaScope(CycleArena* arena) : arena_(arena), marker_(arena->getMarker()) {};
+
+  /// Destructor for cycle arena scope object. Rewinds the arena to the marked memory.
+  ~CycleArenaScope(void) { arena_->rewind(marker_); };
+
+  CycleArenaScope(const CycleArenaScope &) = delete;
+  CycleArenaScope& operator=(const CycleArenaScope &) = delete;
+
+private:
+  CycleArena* arena_;       ///< Pointer to the cycle arena to be rewound
+  CycleArenaMarker marker_; ///< Marker of the memory allocated upon construction
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class adapts a cycle arena to the standard allocator interface such that standard containers (e.g. vectors)
+/// declared within the control cycle acquire their storage from the arena.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename T>
+class ArenaAllocator
+{
+public:
+  typedef T value_type; ///< Type of allocated elements
+
+  /// Constructor for arena allocator object.
+  /// @param[in] arena Pointer to the cycle arena from which memory is allocated
+  ArenaAllocator(CycleArena* arena) : arena_(arena) {};
+
+  /// Converting constructor for arena allocator object, as required for rebinding to other element types.
+  /// @param[in] allocator The arena allocator of another element type
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &allocator) : arena_(allocator.getArena()) {};
+
+  /// Accessor for the cycle arena from which memory is allocated.
+  /// @return Pointer to the cycle arena
+  inline CycleArena* getArena(void) const { return arena_; };
+
+  /// Allocates storage for elements from the cycle arena.
+  /// @param[in] count The number of elements
+  /// @return Pointer to the allocated storage
+  inline T* allocate(const size_t &count) { return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T))); };
+
+  /// Deallocates storage for elements allocated from the cycle arena.
+  /// @param[in] pointer Pointer to the allocated storage
+  inline void deallocate(T* pointer, const size_t &) { arena_->deallocate(pointer); };
+
+  /// Equality operator for arena allocators (storage allocated by one may be deallocated by the other).
+  template <typename U>
+  inline bool operator==(const ArenaAllocator<U> &allocator) const { return arena_ == allocator.getArena(); };
+
+  /// Inequality operator for arena allocators.
+  template <typename U>
+  inline bool operator!=(const ArenaAllocator<U> &allocator) const { return arena_ != allocator.getArena(); };
+
+private:
+  CycleArena* arena_; ///< Pointer to the cycle arena from which memory is allocated
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+typedef Eigen::Map<Eigen::MatrixXd, Eigen::AlignedMax> ArenaMatrixXd;
+typedef Eigen::Map<Eigen::VectorXd, Eigen::AlignedMax> ArenaVectorXd;
+
+/// Allocates a dynamically sized Eigen matrix from a cycle arena. The matrix is uninitialised.
+/// @param[in] arena Pointer to the cycle arena from which the matrix is allocated
+/// @param[in] rows The number of rows of the matrix
+/// @param[in] cols The number of columns of the matrix
+/// @return Map of the matrix onto arena memory
+inline ArenaMatrixXd arenaMatrix(CycleArena* arena, const int &rows, const int &cols)
+{
+  double* data = static_cast<double*>(arena->allocate(rows * cols * sizeof(double)));
+  return ArenaMatrixXd(data, rows, cols);
+}
+
+/// Allocates a dynamically sized Eigen vector from a cycle arena. The vector is uninitialised.
+/// @param[in] arena Pointer to the cycle arena from which the vector is allocated
+/// @param[in] size The number of elements of the vector
+/// @return Map of the vector onto arena memory
+inline ArenaVectorXd arenaVector(CycleArena* arena, const int &size)
+{
+  double* data = static_cast<double*>(arena->allocate(size * sizeof(double)));
+  return ArenaVectorXd(data, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_ARENA_H
@@ -0,0 +1,150 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_TIMING_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_TIMING_H
+
+#include "standard_includes.h"
+#include "allocation_tracking.h"
+
+#include <array>
+#include <chrono>
+
+#define TIMING_MIN_DURATION 1.0e-6  ///< Upper bound of the first timing histogram bucket (seconds)
+#define TIMING_BUCKETS_PER_OCTAVE 4 ///< Number of timing histogram buckets per doubling of duration
+#define TIMING_BUCKET_COUNT 84      ///< Number of timing histogram buckets (covers 1us to ~2s)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for stages of the control cycle which are individually timed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum TimingStage
+{
+  CONTROL_CYCLE_STAGE,               ///< The entire control cycle excluding sleep
+  CURRENT_POSE_STAGE,                ///< Pose controller update of current pose
+  ADMITTANCE_STAGE,                  ///< Admittance controller stiffness and admittance update
+  WALK_STAGE,                        ///< Walk controller update of walking leg tip trajectories
+  STANCE_STAGE,                      ///< Pose controller update of stance
+  MODEL_STAGE,                       ///< Model update of inverse/forward kinematics
+  LEG_STATE_PUBLISH_STAGE,           ///< Publishing of leg states
+  LEG_STATES_PUBLISH_STAGE,          ///< Publishing of aggregated leg states
+  VELOCITY_PUBLISH_STAGE,            ///< Publishing of body velocity
+  POSE_PUBLISH_STAGE,                ///< Publishing of body pose
+  WALKSPACE_PUBLISH_STAGE,           ///< Publishing of walkspace
+  ROTATION_POSE_ERROR_PUBLISH_STAGE, ///< Publishing of rotation pose error
+  FRAME_TRANSFORMS_PUBLISH_STAGE,    ///< Publishing of frame transforms
+  RVIZ_DEBUGGING_STAGE,              ///< Publishing of RVIZ debugging markers
+  DESIRED_JOINT_STATE_PUBLISH_STAGE, ///< Publishing of desired joint states
+  TIMING_STAGE_COUNT,                ///< Misc enum defining number of Timing Stages
+};
+
+/// Names of each timing stage as used in published diagnostics
+const char* const TIMING_STAGE_NAMES[TIMING_STAGE_COUNT] =
+{
+  "control_cycle", "current_pose", "admittance", "walk", "stance", "model", "publish_leg_state", "publish_leg_states",
+  "publish_velocity", "publish_pose", "publish_walkspace", "publish_rotation_pose_error", "publish_frame_transforms",
+  "rviz_debugging", "publish_desired_joint_state",
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class aggregates duration samples of a timed stage in fixed memory. Alongside count, min, mean and max, samples
+/// are binned into a histogram with logarithmically spaced buckets (TIMING_BUCKETS_PER_OCTAVE per doubling of
+/// duration) from which percentiles are estimated to within the bucket resolution (~19%).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class TimingStatistics
+{
+public:
+  /// Constructor for timing statistics object.
+  TimingStatistics(void) { reset(); };
+
+  /// Accessor for count of samples.
+  /// @return Count of duration samples since last reset
+  inline int getSampleCount(void) { return sample_count_; };
+
+  /// Accessor for minimum sampled duration.
+  /// @return Minimum duration sample since last reset
+  inline double getMin(void) { return sample_count_ > 0 ? min_ : 0.0; };
+
+  /// Accessor for mean sampled duration.
+  /// @return Mean of duration samples since last reset
+  inline double getMean(void) { return sample_count_ > 0 ? sum_ / sample_count_ : 0.0; };
+
+  /// Accessor for maximum sampled duration.
+  /// @return Maximum duration sample since last reset
+  inline double getMax(void) { return max_; };
+
+  /// Adds a duration sample to the statistics.
+  /// @param[in] duration The sampled duration (seconds)
+  void addSample(const double &duration);
+
+  /// Estimates a percentile of sampled durations from the histogram, as the upper bound of the bucket containing the
+  /// percentile (limited to the maximum sample).
+  /// @param[in] percentile The requested percentile (0.0 -> 1.0)
+  /// @return Estimated duration below which the requested percentile of samples lie
+  double getPercentile(const double &percentile);
+
+  /// Resets all statistics.
+  void reset(void);
+
+private:
+  std::array<int, TIMING_BUCKET_COUNT> histogram_; ///< Count of duration samples in each bucket
+  int sample_count_;                               ///< Count of duration samples
+  double min_;                                     ///< Minimum duration sample
+  double max_;                                     ///< Maximum duration sample
+  double sum_;                                     ///< Sum of duration samples used to calculate mean
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class times the scope in which it is declared using the monotonic steady clock, adding the duration as a
+/// sample to the given timing statistics upon destruction. Timing is skipped if the given statistics pointer is NULL.
+/// Heap allocations made by the calling thread within the scope are optionally added to allocation statistics.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ScopedTimer
+{
+public:
+  /// Constructor for scoped timer object. Starts timing.
+  /// @param[in] statistics Pointer to timing statistics to which the duration of the scope is added (may be NULL)
+  /// @param[in] allocations Pointer to allocation statistics to which heap allocations of the scope are added (may be
+  /// NULL)
+  inline ScopedTimer(TimingStatistics* statistics, AllocationStatistics* allocations = NULL)
+    : statistics_(statistics)
+    , allocations_(allocations)
+  {
+    if (allocations_ != NULL)
+    {
+      allocation_start_ = getThreadAllocationCounts();
+    }
+    if (statistics_ != NULL)
+    {
+      start_ = std::chrono::steady_clock::now();
+    }
+  };
+
+  /// Destructor for scoped timer object. Ends timing and adds the duration of the scope to the timing statistics.
+  inline ~ScopedTimer(void)
+  {
+    if (statistics_ != NULL)
+    {
+      std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_;
+      statistics_->addSample(duration.count());
+    }
+    if (allocations_ != NULL)
+    {
+      allocations_->addSample(allocation_start_, getThreadAllocationCounts());
+    }
+  };
+
+private:
+  TimingStatistics* statistics_;                ///< Pointer to timing statistics of timed scope
+  AllocationStatistics* allocations_;           ///< Pointer to allocation statistics of timed scope
+  std::chrono::steady_clock::time_point start_; ///< The start time of timing
+  AllocationCounts allocation_start_;           ///< The allocation counts of the calling thread at the start of timing
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_CYCLE_TIMING_H
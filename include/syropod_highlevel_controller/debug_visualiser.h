@@ -10,103 +10,267 @@
 #define SYROPOD_HIGHLEVEL_CONTROLLER_DEBUG_OUTPUT_H
 
 #include "standard_includes.h"
+#include "ros_interface.h"
 #include "pose.h"
 #include "model.h"
 #include "walk_controller.h"
+#include "latest_value.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <boost/lockfree/spsc_queue.hpp>
 
 #define ID_LIMIT 10000                    ///< Id value limit to prevent overflow
 #define TRAJECTORY_DURATION 1             ///< Time for trajectory markers to exist (sec)
+#define CONTROL_NODE_COUNT 5              ///< Number of control nodes of each bezier curve of a leg stepper
+#define WORKSPACE_SNAPSHOT_QUEUE_SIZE 256 ///< Maximum number of workspace generation snapshots queued for visualisation
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for each stream of visualisation markers, each published on its own topic at its own rate.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum DebugStream
+{
+  ROBOT_MODEL_STREAM,          ///< Line segments linking joints and tip of each leg
+  TIP_TRAJECTORY_STREAM,       ///< Trail of tip positions of each leg
+  BEZIER_CURVE_STREAM,         ///< Control nodes of tip trajectory bezier curves of each leg
+  DEFAULT_TIP_POSITION_STREAM, ///< Default tip position of each leg
+  TARGET_TIP_POSITION_STREAM,  ///< Target tip position of each leg
+  WALKSPACE_STREAM,            ///< 2D walkspace of each leg (static, published only upon change)
+  WORKSPACE_STREAM,            ///< 3D workspace of each leg (static, published only upon change)
+  WALK_PLANE_STREAM,           ///< Estimated walk plane
+  STRIDE_STREAM,               ///< Stride vector of each leg
+  TIP_FORCE_STREAM,            ///< Calculated and measured tip force vectors of each leg
+  JOINT_TORQUE_STREAM,         ///< Estimated effort of each joint
+  GRAVITY_STREAM,              ///< Estimated gravitational acceleration vector
+  TERRAIN_STREAM,              ///< Terrain estimate from tip positions at touchdown
+  DEBUG_STREAM_COUNT,          ///< Misc enum defining number of Debug Streams
+};
+
+/// Names of each debug stream as used in topic names and the debug_rviz_rates parameter
+const char* const DEBUG_STREAM_NAMES[DEBUG_STREAM_COUNT] =
+{
+  "robot_model", "tip_trajectories", "bezier_curves", "default_tip_positions", "target_tip_positions", "walkspace",
+  "workspace", "walk_plane", "stride", "tip_force", "joint_torque", "gravity", "terrain",
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Snapshot of the state of a leg from which its visualisation markers are generated.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct LegVisualisationState
+{
+  int id_number_;                                     ///< Identification number of the leg
+  std::string id_name_;                               ///< Identification name of the leg
+  std::vector<Eigen::Vector3d> joint_positions_;      ///< Position of the origin of each joint in the robot frame
+  std::vector<double> joint_efforts_;                 ///< Current effort of each joint
+  Eigen::Vector3d tip_position_;                      ///< Current tip position in the robot frame
+  double swing_progress_;                             ///< Swing progress of the leg stepper
+  bool at_correct_phase_;                             ///< Flags if the leg stepper is at the correct gait phase
+  Eigen::Vector3d default_tip_position_;              ///< Default tip position of the leg stepper
+  Eigen::Vector3d target_tip_position_;               ///< Target tip position of the leg stepper
+  Eigen::Vector3d identity_tip_position_;             ///< Identity tip position of the leg stepper
+  Eigen::Vector3d walk_plane_normal_;                 ///< Walk plane normal of the leg stepper
+  Eigen::Vector3d stride_vector_;                     ///< Stride vector of the leg stepper
+  Eigen::Vector3d stance_nodes_[CONTROL_NODE_COUNT];  ///< Control nodes of the stance bezier curve
+  Eigen::Vector3d swing_1_nodes_[CONTROL_NODE_COUNT]; ///< Control nodes of the primary swing bezier curve
+  Eigen::Vector3d swing_2_nodes_[CONTROL_NODE_COUNT]; ///< Control nodes of the secondary swing bezier curve
+  Eigen::Vector3d tip_force_calculated_;              ///< Tip force calculated from joint efforts
+  Eigen::Vector3d tip_force_measured_;                ///< Tip force measured by tip force sensor
+  Workspace workspace_;                               ///< Workspace of the leg (captured only when stream is due)
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// This class handles generation and publishing of visualisations for display in rviz for debugging purposes.
+/// Snapshot of the state of the robot from which visualisation markers are generated, captured on the control thread
+/// and handed to the visualisation thread.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-class DebugVisualiser
+struct VisualisationState
+{
+  std::array<bool, DEBUG_STREAM_COUNT> due_; ///< Flags if each stream is due for publishing from this snapshot
+  std::vector<LegVisualisationState> legs_;  ///< Snapshot of each leg ordered by leg identification number
+  Eigen::Quaterniond body_rotation_;         ///< Current rotation of the body
+  Eigen::Vector3d gravity_estimate_;         ///< Estimate of gravitational acceleration vector
+  Eigen::Vector3d walk_plane_;               ///< Estimated walk plane
+  Eigen::Vector3d walk_plane_normal_;        ///< Normal to the estimated walk plane
+  double body_clearance_;                    ///< Vertical offset of the body above the walk plane
+  LimitMap walkspace_;                       ///< Walkspace of walk controller (captured only when stream is due)
+  ros::Time stamp_;                          ///< Time at which the snapshot was captured
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+typedef boost::lockfree::spsc_queue<VisualisationState, boost::lockfree::capacity<WORKSPACE_SNAPSHOT_QUEUE_SIZE>>
+    WorkspaceSnapshotQueue;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class handles generation and publishing of visualisations for display in rviz for debugging purposes. The
+/// state required by each stream of markers is captured on the control thread only if the stream has subscribers and
+/// is due according to its decimated rate. Markers are then generated and published from the captured state on a
+/// separate visualisation thread. Static workspace and walkspace markers are only republished upon change of their
+/// input or upon connection of a new subscriber. Intermediate snapshots of workspace generation are queued separately
+/// such that visualising the workspace search does not slow the search.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DebugVisualiser : public WorkspaceVisualiser
 {
 public:
   /// Constructor for debug output class. Sets up publishers for the visualisation markers and initialises odometry.
   DebugVisualiser(void);
 
+  /// Destructor for debug output class. Stops visualisation thread.
+  ~DebugVisualiser(void);
+
   /// Modifier for the time_delta_ member variable.
   inline void setTimeDelta(const double &time_delta) { time_delta_ = time_delta; };
 
+  /// Sets the rate at which each stream is published, decimated from the control loop rate. A stream rate of zero
+  /// disables the stream and streams missing from the input map are published every control cycle.
+  /// @param[in] stream_rates Map of stream names (as defined in DEBUG_STREAM_NAMES) and publish rates (Hz)
+  void setStreamRates(const std::map<std::string, double> &stream_rates);
+
+  /// Starts visualisation thread which generates and publishes markers from captured state.
+  /// @return Flag denoting if the visualisation thread was started
+  bool startVisualisationThread(void);
+
+  /// Stops visualisation thread.
+  void stopVisualisationThread(void);
+
+  /// Captures state of the robot required by streams which have subscribers and are due in this control cycle and
+  /// hands it to the visualisation thread. Called once per control cycle from the control thread.
+  /// @param[in] model A pointer to the robot model object
+  /// @param[in] walker A pointer to the walk controller object
+  /// @param[in] running Flags if the robot is in the RUNNING state, enabling walking related streams
+  /// @param[in] tip_force Flags if tip force markers are to be published
+  void captureState(std::shared_ptr<Model> model, std::shared_ptr<WalkController> walker,
+                    const bool &running, const bool &tip_force);
+
+  /// Broadcasts static transforms of the odom_ideal -> base_link -> walk_plane frames, in which workspace generation is
+  /// visualised, at the given pose of the robot body.
+  /// @param[in] body_pose The pose of the robot body (i.e. walk_plane -> base_link) during workspace generation
+  void publishWorkspaceFrames(const Pose &body_pose) override;
+
+  /// Captures an intermediate snapshot of workspace generation (the robot model and the partially generated workspace
+  /// of the searching leg) and queues it for the visualisation thread, which publishes queued snapshots one per
+  /// visualisation cycle. Never blocks: snapshots are dropped (without being captured) whilst the queue is full.
+  /// @param[in] model A pointer to the robot model object used in the workspace search
+  /// @param[in] leg A pointer to the leg of the robot model object whose workspace is being generated
+  /// @param[in] body_clearance The vertical offset of the body above the walk plane
+  /// @return Flag denoting if the snapshot was queued
+  bool pushWorkspaceSnapshot(std::shared_ptr<Model> model, std::shared_ptr<Leg> leg,
+                             const double &body_clearance) override;
+
+private:
+  /// Captures state of a leg into a snapshot.
+  /// @param[in] leg A pointer to a leg of the robot model object
+  /// @param[out] leg_state Pointer to the leg snapshot to fill
+  /// @param[in] capture_workspace Flags if the workspace of the leg is to be captured
+  void captureLegState(std::shared_ptr<Leg> leg, LegVisualisationState* leg_state, const bool &capture_workspace);
+
+  /// Counts down decimated control cycles of a stream and checks if it is due for publishing with subscribers.
+  /// @param[in] stream The designation of the stream
+  /// @return Flag denoting if the stream is due
+  bool isStreamDue(const DebugStream &stream);
+
+  /// Loop run by visualisation thread which generates and publishes markers from each newly captured snapshot.
+  void visualisationLoop(void);
+
+  /// Publishes robot model and partially generated workspace markers from a queued workspace generation snapshot.
+  /// @param[in] snapshot The queued snapshot of workspace generation
+  void publishWorkspaceSnapshot(const VisualisationState &snapshot);
+
+  /// Generates and publishes markers of each due stream from a captured snapshot.
+  /// @param[in] state The captured snapshot of the robot
+  void publishState(const VisualisationState &state);
+
   /// Publishes visualisation markers which represent the robot model for display in RVIZ. Consists of line segments.
   /// linking the origin points of each joint and tip of each leg.
-  /// @param[in] model A pointer to the robot model object
-  void generateRobotModel(std::shared_ptr<Model> model);
+  /// @param[in] state The captured snapshot of the robot
+  void generateRobotModel(const VisualisationState &state);
 
   /// Publishes visualisation markers which represent the estimated walking plane.
-  /// @param[in] walk_plane A Vector representing the walk plane
-  /// @param[in] walk_plane_normal A Vector of the normal to the walk plane
-  void generateWalkPlane(const Eigen::Vector3d &walk_plane, const Eigen::Vector3d &walk_plane_normal);
+  /// @param[in] state The captured snapshot of the robot
+  void generateWalkPlane(const VisualisationState &state);
 
   /// Publishes visualisation markers which represent the trajectory of the tip of the input leg.
-  /// @param[in] leg A pointer to the leg associated with the tip trajectory that is to be published
-  void generateTipTrajectory(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of the leg associated with the tip trajectory that is to be published
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateTipTrajectory(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent an estimate of the terrain being traversed.
-  /// @param[in] model A pointer to the robot model object
-  void generateTerrainEstimate(std::shared_ptr<Model> model);
+  /// @param[in] state The captured snapshot of the robot
+  void generateTerrainEstimate(const VisualisationState &state);
 
   /// Publishes visualisation markers which represent the control nodes of the three bezier curves used to control tip.
   /// trajectory of the input leg.
-  /// @param[in] leg A pointer to the leg associated with the tip trajectory that is to be published
-  void generateBezierCurves(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of the leg associated with the tip trajectory that is to be published
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateBezierCurves(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the default tip position of the leg.
-  /// @param[in] leg A pointer to a leg of the robot model object
-  void generateDefaultTipPositions(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of a leg of the robot model object
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateDefaultTipPositions(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publises visualisation markers which represent the target tip position of the leg.
-  /// @param[in] leg A pointer to a leg of the robot model object
-  void generateTargetTipPositions(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of a leg of the robot model object
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateTargetTipPositions(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the 2D walkspace for each leg.
-  /// @param[in] leg A pointer to a leg of the robot model object
+  /// @param[in] leg The captured snapshot of a leg of the robot model object
   /// @param[in] walkspace  A map of walkspace radii for a range of bearings to be visualised
-  void generateWalkspace(std::shared_ptr<Leg> leg, const LimitMap &walkspace);
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateWalkspace(const LegVisualisationState &leg, const LimitMap &walkspace, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the 3D workspace for each leg.
-  /// @param[in] leg A pointer to a leg of the robot model object
+  /// @param[in] leg The captured snapshot of a leg of the robot model object
   /// @param[in] body_clearance The vertical offset of the body above the walk plane
-  void generateWorkspace(std::shared_ptr<Leg> leg, const double &body_clearance);
+  void generateWorkspace(const LegVisualisationState &leg, const double &body_clearance);
 
   /// Publishes visualisation markers which represent requested stride vector for each leg.
-  /// @param[in] leg A pointer to the leg associated with the tip trajectory that is to be published
-  void generateStride(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of the leg associated with the tip trajectory that is to be published
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateStride(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the estimated tip force vector for input leg.
-  /// @param[in] leg A pointer to the leg associated with the tip trajectory that is to be published
-  void generateTipForce(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of the leg associated with the tip trajectory that is to be published
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateTipForce(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the estimated percentage of max torque in each joint.
-  /// @param[in] leg A pointer to the leg associated with the tip trajectory that is to be published
-  void generateJointTorques(std::shared_ptr<Leg> leg);
+  /// @param[in] leg The captured snapshot of the leg associated with the tip trajectory that is to be published
+  /// @param[in] stamp The time at which the snapshot was captured
+  void generateJointTorques(const LegVisualisationState &leg, const ros::Time &stamp);
 
   /// Publishes visualisation markers which represent the estimate of the gravitational acceleration vector.
-  /// @param[in] gravity_estimate An estimate of the gravitational acceleration vector
-  void generateGravity(const Eigen::Vector3d& gravity_estimate);
+  /// @param[in] state The captured snapshot of the robot
+  void generateGravity(const VisualisationState &state);
 
-private:
-  ros::Publisher robot_model_publisher_;          ///< Publisher for topic "/shc/visualisation/robot_model"
-  ros::Publisher tip_trajectory_publisher_;       ///< Publisher for topic "/shc/visualisation/tip_trajectories"
-  ros::Publisher bezier_curve_publisher_;         ///< Publisher for topic "/shc/visualisation/bezier_curves"
-  ros::Publisher default_tip_position_publisher_; ///< Publisher for topic "/shc/visualisation/default_tip_positions"
-  ros::Publisher target_tip_position_publisher_;  ///< Publisher for topic "/shc/visualisation/target_tip_positions"
-  ros::Publisher walkspace_publisher_;            ///< Publisher for topic "/shc/visualisation/walkspace"
-  ros::Publisher workspace_publisher_;            ///< Publisher for topic "/shc/visualisation/workspace"
-  ros::Publisher walk_plane_publisher_;           ///< Publisher for topic "/shc/visualisation/walk_plane"
-  ros::Publisher stride_publisher_;               ///< Publisher for topic "/shc/visualisation/stride"
-  ros::Publisher tip_force_publisher_;            ///< Publisher for topic "/shc/visualisation/tip_force"
-  ros::Publisher joint_torque_publisher_;         ///< Publisher for topic "/shc/visualisation/joint_torque"
-  ros::Publisher tip_rotation_publisher_;         ///< Publisher for topic "/shc/visualisation/tip_rotation"
-  ros::Publisher gravity_publisher_;              ///< Publisher for topic "/shc/visualisation/gravity"
-  ros::Publisher terrain_publisher_;              ///< Publisher for topic "/shc/visualisation/terrain"
+  /// Publishes static workspace and walkspace markers of each leg whose input has changed since last published, or of
+  /// all legs if a new subscriber has connected since last published.
+  /// @param[in] state The captured snapshot of the robot
+  void generateStaticMarkers(const VisualisationState &state);
+
+  ros::Publisher publishers_[DEBUG_STREAM_COUNT]; ///< Publishers for topics "/shc/debug/<stream name>"
+  ros::Publisher tip_rotation_publisher_;         ///< Publisher for topic "/shc/debug/tip_rotation"
 
   double time_delta_ = 0.0;   ///< Time period of main loop cycle used for marker duration
   int tip_position_id_ = 0;   ///< Id for tip trajectory markers
   int terrain_marker_id_ = 0; ///< Id for terrain markers
   double marker_scale_ = 0.0; ///< Value used to scale marker sizes based on estimate of robot 'size'
 
+  std::array<int, DEBUG_STREAM_COUNT> stream_decimation_; ///< Number of control cycles between publishes of each stream
+  std::array<int, DEBUG_STREAM_COUNT> stream_countdown_;  ///< Control cycles until next publish of each stream
+  VisualisationState captured_state_;                     ///< Snapshot of robot state captured on control thread
+  LatestValue<VisualisationState> state_output_;          ///< Slot handing captured snapshots to visualisation thread
+
+  WorkspaceSnapshotQueue workspace_snapshot_queue_; ///< Queue of workspace generation snapshots for visualisation
+
+  std::thread visualisation_thread_;                        ///< Thread generating and publishing markers
+  std::atomic<bool> visualisation_thread_running_{ false }; ///< Flags if the visualisation thread is running
+
+  VisualisationState published_state_;                             ///< Snapshot of last published static markers
+  std::array<int, DEBUG_STREAM_COUNT> published_subscriber_count_; ///< Subscriber count of stream at last publish
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
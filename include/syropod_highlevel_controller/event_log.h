@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_EVENT_LOG_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_EVENT_LOG_H
+
+#include "standard_includes.h"
+#include "realtime_loop.h"
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+
+#define EVENT_QUEUE_SIZE 1024     ///< Maximum number of events queued for the event log thread
+#define EVENT_LOG_RATE 50.0       ///< Rate at which the event log thread consumes queued events (Hz)
+#define EVENT_VALUE_COUNT 2       ///< Number of values recorded with each event
+#define EVENT_UNDEFINED_ID -1     ///< Value of event leg/joint id numbers and axis denoting not applicable
+#define EVENT_LOG_MAGIC "SHCEVT1" ///< Identifier written at the start of binary event log files (with trailing '\0')
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for types of events recorded by the control thread in place of formatted warnings.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum EventType
+{
+  IK_VELOCITY_CLAMPING_EVENT,   ///< Joint velocity clamped by IK (values: desired, limit)
+  IK_POSITION_CLAMPING_EVENT,   ///< Joint position clamped by IK (values: desired, limit)
+  IK_DEVIATION_EVENT,           ///< Tip position from IK deviates from desired along axis (values: current, desired)
+  WORKPLANE_UNDEFINED_EVENT,    ///< Requested workplane does not exist within leg workspace (values: height)
+  WALKSPACE_RADIUS_EVENT,       ///< Unable to generate walkspace radius (values: bearing, workplane height)
+  LINEAR_SPEED_CLAMPING_EVENT,  ///< Input linear speed clamped to maximum (values: input, maximum)
+  ANGULAR_SPEED_CLAMPING_EVENT, ///< Input angular speed clamped to maximum (values: input, maximum)
+  LEG_MANIPULATION_LIMIT_EVENT, ///< Manually manipulated leg unable to move further due to IK or joint limits
+  TIP_STATES_MISSING_EVENT,     ///< Rough terrain mode enabled without tip state messages for touchdown detection
+  EVENT_TYPE_COUNT,             ///< Misc enum defining number of Event Types
+};
+
+/// Names of event types as reported in event counts (indexed by EventType)
+const char* const EVENT_TYPE_NAMES[EVENT_TYPE_COUNT] =
+{
+  "ik_velocity_clamping", "ik_position_clamping", "ik_deviation", "workplane_undefined", "walkspace_radius",
+  "linear_speed_clamping", "angular_speed_clamping", "leg_manipulation_limit", "tip_states_missing",
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This struct contains a compact binary record of an event, as queued for the event log thread and written to binary
+/// event log files.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Event
+{
+  uint64_t cycle_ = 0;                              ///< The control cycle in which the event occurred
+  int16_t type_ = 0;                                ///< The type of event (EventType)
+  int16_t leg_id_number_ = EVENT_UNDEFINED_ID;      ///< The id number of the leg of the event
+  int16_t joint_id_number_ = EVENT_UNDEFINED_ID;    ///< The id number of the joint (within leg) of the event
+  int16_t axis_ = EVENT_UNDEFINED_ID;               ///< The axis (0 = x, 1 = y, 2 = z) of the event
+  double values_[EVENT_VALUE_COUNT] = { 0.0, 0.0 }; ///< Values of the event (as per EventType)
+};
+
+typedef boost::lockfree::spsc_queue<Event, boost::lockfree::capacity<EVENT_QUEUE_SIZE>> EventQueue;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class records events on the control thread without formatting text. Events are queued as compact binary
+/// records in a lock-free single producer/single consumer ring buffer, from which a background thread formats them to
+/// rosconsole, aggregates counts per event type and optionally writes them to a binary event log file. Recording never
+/// blocks or allocates: events are dropped (and counted) whilst the queue is full or the thread is not running.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class EventLog
+{
+public:
+  /// Destructor for event log object. Stops the event log thread.
+  ~EventLog(void) { stopEventLogThread(); };
+
+  /// Accessor for the control cycle number stamped on recorded events.
+  /// @return The current control cycle number
+  inline uint64_t getCycle(void) { return cycle_; };
+
+  /// Accessor for count of events of a type consumed by the event log thread.
+  /// @param[in] type The type of event
+  /// @return The count of events of the type since the thread was started
+  inline uint64_t getEventCount(const EventType &type) { return event_counts_[type]; };
+
+  /// Accessor for count of events dropped whilst the queue was full or the thread was not running.
+  /// @return The count of dropped events since the thread was last started
+  inline uint64_t getDroppedCount(void) { return dropped_count_; };
+
+  /// Advances the control cycle number stamped on recorded events (control thread only).
+  inline void advanceCycle(void) { cycle_++; };
+
+  /// Records an event for the event log thread (control thread only). Never blocks or allocates.
+  /// @param[in] type The type of event
+  /// @param[in] leg_id_number The id number of the leg of the event
+  /// @param[in] joint_id_number The id number of the joint (within leg) of the event
+  /// @param[in] axis The axis of the event
+  /// @param[in] value_1 The first value of the event
+  /// @param[in] value_2 The second value of the event
+  /// @return Flag denoting if the event was queued
+  inline bool record(const EventType &type, const int &leg_id_number = EVENT_UNDEFINED_ID,
+                     const int &joint_id_number = EVENT_UNDEFINED_ID, const int &axis = EVENT_UNDEFINED_ID,
+                     const double &value_1 = 0.0, const double &value_2 = 0.0)
+  {
+    if (!event_log_thread_running_)
+    {
+      dropped_count_++;
+      return false;
+    }
+    Event event;
+    event.cycle_ = cycle_;
+    event.type_ = type;
+    event.leg_id_number_ = leg_id_number;
+    event.joint_id_number_ = joint_id_number;
+    event.axis_ = axis;
+    event.values_[0] = value_1;
+    event.values_[1] = value_2;
+    bool pushed = event_queue_.push(event);
+    if (!pushed)
+    {
+      dropped_count_++;
+    }
+    return pushed;
+  };
+
+  /// Starts the event log thread, which consumes queued events at EVENT_LOG_RATE.
+  /// @param[in] leg_names The names of the legs of the model (indexed by leg id number)
+  /// @param[in] joint_names The names of the joints of each leg (indexed by leg id number and joint id number - 1)
+  /// @param[in] log_file The binary event log file to which events are written (empty to disable)
+  /// @return Flag denoting if the thread was started
+  bool startEventLogThread(const std::vector<std::string> &leg_names,
+                           const std::vector<std::vector<std::string>> &joint_names, const std::string &log_file = "");
+
+  /// Stops the event log thread, consuming any events remaining in the queue.
+  void stopEventLogThread(void);
+
+private:
+  /// Consumes queued events at EVENT_LOG_RATE until the event log thread is stopped.
+  void eventLogLoop(void);
+
+  /// Consumes all events currently queued: counts, logs and writes each event.
+  void consumeEvents(void);
+
+  /// Formats an event to rosconsole, with throttling for event types previously reported by throttled warnings.
+  /// @param[in] event The event to be logged
+  void logEvent(const Event &event);
+
+  /// Accessor for the name of the leg of an event.
+  /// @param[in] event The event
+  /// @return The name of the leg of the event, or "unknown" if undefined
+  const char* getLegName(const Event &event);
+
+  /// Accessor for the name of the joint of an event.
+  /// @param[in] event The event
+  /// @return The name of the joint of the event, or "unknown" if undefined
+  const char* getJointName(const Event &event);
+
+  uint64_t cycle_ = 0;                       ///< The control cycle number stamped on recorded events
+  EventQueue event_queue_;                   ///< Queue of events passed to the event log thread
+  std::atomic<uint64_t> dropped_count_{ 0 }; ///< Count of events dropped whilst queue full or thread not running
+
+  /// Count of consumed events of each type
+  std::array<std::atomic<uint64_t>, EVENT_TYPE_COUNT> event_counts_{};
+
+  std::vector<std::string> leg_names_;                ///< Names of legs (indexed by leg id number)
+  std::vector<std::vector<std::string>> joint_names_; ///< Names of joints (indexed by leg and joint id number - 1)
+  FILE* log_file_ = NULL;                             ///< Binary event log file (NULL if disabled)
+
+  std::thread event_log_thread_;                        ///< Thread consuming queued events
+  std::atomic<bool> event_log_thread_running_{ false }; ///< Flags if the event log thread is running
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_EVENT_LOG_H
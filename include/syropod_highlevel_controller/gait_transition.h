@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_GAIT_TRANSITION_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_GAIT_TRANSITION_H
+
+#include "standard_includes.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Object containing parameters which define the timing of the step cycle.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct StepCycle
+{
+  double frequency_;  ///< The frequency of the step cycle in Hz
+  int period_;        ///< The length of the entire step cycle in iterations
+  int swing_period_;  ///< The length of the swing period of the step cycle in iterations
+  int stance_period_; ///< The length of the stance period of the step cycle in iterations
+  int stance_end_;    ///< The iteration at which the stance period ends
+  int swing_start_;   ///< The iteration at which the swing period starts
+  int swing_end_;     ///< The iteration at which the swing period ends
+  int stance_start_;  ///< The iteration at which the stance period starts
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class plans the transition between the step cycles and phase offsets of two gaits whilst walking. The stance
+/// and swing periods are blended from those of the current gait to those of the new gait over the requested number of
+/// step cycles whilst the phase of each leg is shifted toward its new phase offset by holding phase during stance. Lift
+/// off is also held whilst an adjacent leg (by leg id number) swings, unless the pair already swing simultaneously in
+/// either gait. The entire transition is simulated when planned such that it is refused (rather than started) if the
+/// legs cannot reach their new phase offsets within the requested number of step cycles or if support is not
+/// maintained at every iteration.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class GaitTransition
+{
+public:
+  /// Plans a gait transition from the current step cycle and leg phases to a target step cycle and phase offsets.
+  /// Schedules of step cycle blending and phase holding are simulated in turn until one is found which maintains
+  /// support, otherwise the plan is left empty.
+  /// @param[in] current_step The current step cycle
+  /// @param[in] target_step The step cycle of the new gait
+  /// @param[in] phases The current phase of each leg, indexed by leg id number
+  /// @param[in] target_offsets The phase offset of each leg in the new gait, indexed by leg id number
+  /// @param[in] transition_cycles The number of step cycles within which the transition must complete
+  /// @return Flag denoting if a transition which maintains support was found
+  bool generate(const StepCycle &current_step, const StepCycle &target_step,
+                const std::vector<int> &phases, const std::vector<int> &target_offsets,
+                const int &transition_cycles);
+
+  /// Clears the planned transition.
+  void clear(void);
+
+  /// Accessor for the number of iterations in the planned transition.
+  /// @return The number of iterations in the planned transition (zero if no transition is planned)
+  inline int getIterationCount(void) { return static_cast<int>(cycle_index_.size()); };
+
+  /// Accessor for the step cycle in effect at the start of the planned transition.
+  /// @return The step cycle in effect at the start of the planned transition
+  inline const StepCycle& getInitialStepCycle(void) { return step_cycles_.front(); };
+
+  /// Accessor for the step cycle in effect after the given iteration of the planned transition.
+  /// @param[in] iteration The iteration of the planned transition
+  /// @return The step cycle in effect after the given iteration
+  inline const StepCycle& getStepCycle(const int &iteration) { return step_cycles_[cycle_index_[iteration]]; };
+
+  /// Accessor for the phase of a leg at the start of the planned transition.
+  /// @param[in] leg_id The id number of the leg
+  /// @return The phase of the leg at the start of the planned transition
+  inline int getInitialPhase(const int &leg_id) { return initial_phases_[leg_id]; };
+
+  /// Accessor for the phase of a leg after the given iteration of the planned transition.
+  /// @param[in] iteration The iteration of the planned transition
+  /// @param[in] leg_id The id number of the leg
+  /// @return The phase of the leg after the given iteration, with respect to the step cycle then in effect
+  inline int getPhase(const int &iteration, const int &leg_id) { return phases_[iteration * leg_count_ + leg_id]; };
+
+  /// Accessor for the body velocity scaler accommodating the blended stance periods and held phase of the transition.
+  /// @return The ratio of body velocity limits during the planned transition to those of the new gait
+  inline double getVelocityScaler(void) { return velocity_scaler_; };
+
+  /// Generates a step cycle object from the lengths of its periods.
+  /// @param[in] stance_end The iteration at which the stance period ends
+  /// @param[in] stance_period The length of the stance period in iterations
+  /// @param[in] swing_period The length of the swing period in iterations
+  /// @param[in] time_delta The time period of each iteration
+  /// @return The generated step cycle object
+  static StepCycle generateStepCycle(const int &stance_end, const int &stance_period, const int &swing_period,
+                                     const double &time_delta);
+
+  /// Determines if the given phase lies within the swing period of the given step cycle.
+  /// @param[in] step The step cycle
+  /// @param[in] phase The phase
+  /// @return Flag denoting if the phase lies within the swing period
+  static inline bool isSwing(const StepCycle &step, const int &phase)
+  {
+    return phase >= step.swing_start_ && phase < step.swing_end_;
+  };
+
+  /// Maps a phase from one step cycle to another whilst maintaining progress through the current swing or stance
+  /// period. Equivalent to LegStepper::updatePhase for a leg which has completed its first step.
+  /// @param[in] from The step cycle of the given phase
+  /// @param[in] to The step cycle to which the phase is mapped
+  /// @param[in] phase The phase with respect to the original step cycle
+  /// @return The phase with respect to the new step cycle
+  static int remapPhase(const StepCycle &from, const StepCycle &to, const int &phase);
+
+private:
+  /// Simulates a transition for the given schedule, populating the plan.
+  /// @param[in] current_step The current step cycle
+  /// @param[in] target_step The step cycle of the new gait
+  /// @param[in] phases The current phase of each leg, indexed by leg id number
+  /// @param[in] target_offsets The phase offset of each leg in the new gait, indexed by leg id number
+  /// @param[in] blend The ratio of the blend from current to new stance and swing periods for each step cycle
+  /// @param[in] hold_start The progress through the transition (0.0->1.0) at which phase holds begin
+  /// @param[in] hold_end The progress through the transition (0.0->1.0) by which phase holds are scheduled to end
+  /// @return Flag denoting if the simulated transition maintains support and completes within the step cycles
+  bool simulate(const StepCycle &current_step, const StepCycle &target_step,
+                const std::vector<int> &phases, const std::vector<int> &target_offsets,
+                const std::vector<double> &blend, const double &hold_start, const double &hold_end);
+
+  /// Finds the reference phase minimising the largest hold required for legs to achieve the given phase offsets and
+  /// populates the hold (phase error) required of each leg with respect to it.
+  /// @param[in] step The step cycle in effect
+  /// @param[in] phases The phase of each leg
+  /// @param[in] offsets The desired phase offset of each leg
+  /// @param[out] errors The hold required of each leg
+  /// @return The largest hold required of any leg
+  int calculatePhaseErrors(const StepCycle &step, const std::vector<int> &phases,
+                           const std::vector<int> &offsets, std::vector<int> &errors);
+
+  /// Populates the pairs of adjacent legs which swing simultaneously whilst walking in a steady state step cycle.
+  /// @param[in] step The step cycle
+  /// @param[in] phases The phase of each leg in the step cycle
+  /// @param[out] overlapping Flags denoting if each leg and its clockwise adjacent leg swing simultaneously
+  void findSwingOverlap(const StepCycle &step, const std::vector<int> &phases, std::vector<bool> &overlapping);
+
+  int leg_count_ = 0;                 ///< The number of legs in the planned transition
+  std::vector<StepCycle> step_cycles_; ///< The step cycle in effect at the start of and during each planned cycle
+  std::vector<int> cycle_index_;       ///< The index of the step cycle in effect after each planned iteration
+  std::vector<int> initial_phases_;    ///< The phase of each leg at the start of the planned transition
+  std::vector<int> phases_;            ///< The phase of each leg after each planned iteration
+  double velocity_scaler_ = 1.0;       ///< Scales body velocity during the planned transition
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_GAIT_TRANSITION_H
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_INPUT_LOG_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_INPUT_LOG_H
+
+#include "standard_includes.h"
+#include "ros_interface.h"
+#include <ros/serialization.h>
+
+#include <cstdint>
+
+#define INPUT_LOG_MAGIC "SHCINP1" ///< Identifier written at the start of input log files (with trailing '\0')
+#define INPUT_LOG_VERSION 1       ///< Version of the input log file format
+#define INPUT_RECORD_ALIGNMENT 8  ///< Alignment of records within input log files (bytes)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for types of records of an input log, in the order in which they are consumed by the control thread.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum InputRecordType
+{
+  SENSOR_DATA_RECORD,      ///< Sensor data sampled by the control thread (payload: packed doubles)
+  CALLBACK_RECORD,         ///< Input message processed by a control thread callback (payload: serialised message)
+  MODEL_INIT_RECORD,       ///< Initialisation of the model (payload: use default joint positions flag as uint8)
+  CONTROL_CYCLE_RECORD,    ///< Run of a control cycle (no payload)
+  OUTPUT_RECORD,           ///< Desired joint positions after a control cycle (payload: double per sensor joint)
+  INPUT_RECORD_TYPE_COUNT, ///< Misc enum defining number of Input Record Types
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Designation for the control thread callbacks whose input messages are recorded in callback records.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum InputChannel
+{
+  NO_INPUT_CHANNEL,              ///< Record is not a callback record
+  SYSTEM_STATE_INPUT,            ///< Topic /syropod_remote/system_state (std_msgs::Int8)
+  ROBOT_STATE_INPUT,             ///< Topic /syropod_remote/robot_state (std_msgs::Int8)
+  BODY_VELOCITY_INPUT,           ///< Topic /syropod_remote/desired_velocity (geometry_msgs::Twist)
+  BODY_POSE_INPUT,               ///< Topic /syropod_remote/desired_pose (geometry_msgs::Twist)
+  POSING_MODE_INPUT,             ///< Topic /syropod_remote/posing_mode (std_msgs::Int8)
+  POSE_RESET_INPUT,              ///< Topic /syropod_remote/pose_reset_mode (std_msgs::Int8)
+  GAIT_SELECTION_INPUT,          ///< Topic /syropod_remote/gait_selection (std_msgs::Int8)
+  CRUISE_CONTROL_INPUT,          ///< Topic /syropod_remote/cruise_control_mode (std_msgs::Int8)
+  PLANNER_MODE_INPUT,            ///< Topic /syropod_remote/planner_mode (std_msgs::Int8)
+  PRIMARY_LEG_SELECTION_INPUT,   ///< Topic /syropod_remote/primary_leg_selection (std_msgs::Int8)
+  SECONDARY_LEG_SELECTION_INPUT, ///< Topic /syropod_remote/secondary_leg_selection (std_msgs::Int8)
+  PRIMARY_LEG_STATE_INPUT,       ///< Topic /syropod_remote/primary_leg_state (std_msgs::Int8)
+  SECONDARY_LEG_STATE_INPUT,     ///< Topic /syropod_remote/secondary_leg_state (std_msgs::Int8)
+  PRIMARY_TIP_VELOCITY_INPUT,    ///< Topic /syropod_remote/primary_tip_velocity (geometry_msgs::Point)
+  SECONDARY_TIP_VELOCITY_INPUT,  ///< Topic /syropod_remote/secondary_tip_velocity (geometry_msgs::Point)
+  PRIMARY_TIP_POSE_INPUT,        ///< Topic /syropod_manipulation/primary_tip_pose (geometry_msgs::Pose)
+  SECONDARY_TIP_POSE_INPUT,      ///< Topic /syropod_manipulation/secondary_tip_pose (geometry_msgs::Pose)
+  PARAMETER_SELECTION_INPUT,     ///< Topic /syropod_remote/parameter_selection (std_msgs::Int8)
+  PARAMETER_ADJUST_INPUT,        ///< Topic /syropod_remote/parameter_adjustment (std_msgs::Int8)
+  TARGET_CONFIGURATION_INPUT,    ///< Topic /target_configuration (sensor_msgs::JointState)
+  TARGET_BODY_POSE_INPUT,        ///< Topic /target_body_pose (geometry_msgs::Pose)
+  TARGET_TIP_POSE_INPUT,         ///< Topic /target_tip_poses (syropod_highlevel_controller::TargetTipPose)
+  INPUT_CHANNEL_COUNT,           ///< Misc enum defining number of Input Channels
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This struct contains the header written at the start of input log files, describing the controller configuration
+/// against which the log was recorded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct InputLogHeader
+{
+  char magic_[8] = INPUT_LOG_MAGIC;      ///< Identifier of input log files
+  uint32_t version_ = INPUT_LOG_VERSION; ///< Version of the input log file format
+  uint32_t joint_count_ = 0;             ///< Number of sensor joints of the recorded model
+  uint32_t leg_count_ = 0;               ///< Number of legs of the recorded model
+  uint32_t reserved_ = 0;                ///< Reserved (padding)
+  double time_delta_ = 0.0;              ///< Control loop period of the recorded controller (seconds)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This struct contains the header of each record of an input log. The payload follows the header directly and is
+/// padded to INPUT_RECORD_ALIGNMENT such that records (and doubles within payloads) remain aligned when mapped.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct InputRecordHeader
+{
+  uint64_t cycle_ = 0;   ///< The control cycle number in which the record was consumed
+  uint16_t type_ = 0;    ///< The type of record (InputRecordType)
+  uint16_t channel_ = 0; ///< The callback of the record (InputChannel)
+  uint32_t size_ = 0;    ///< The size of the payload, excluding padding (bytes)
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class records every input consumed by the control thread to an input log file, in the order consumed, such
+/// that the controller may later be driven deterministically from the log. Records are written via a buffered stream
+/// and so recording is intended for diagnostic sessions rather than unattended real-time operation.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class InputRecorder
+{
+public:
+  /// Destructor for input recorder object. Closes the input log file.
+  ~InputRecorder(void) { close(); };
+
+  /// Flags if the recorder is recording to an input log file.
+  /// @return Flag denoting if an input log file is open
+  inline bool isRecording(void) { return file_ != NULL; };
+
+  /// Opens an input log file for recording and writes the file header.
+  /// @param[in] log_file The input log file to which inputs are recorded
+  /// @param[in] header The header describing the recorded controller configuration
+  /// @return Flag denoting if the file was opened
+  bool open(const std::string &log_file, const InputLogHeader &header);
+
+  /// Flushes and closes the input log file.
+  void close(void);
+
+  /// Writes a record to the input log file.
+  /// @param[in] type The type of record
+  /// @param[in] cycle The control cycle number in which the record was consumed
+  /// @param[in] channel The callback of the record
+  /// @param[in] payload Pointer to the payload of the record
+  /// @param[in] size The size of the payload (bytes)
+  void record(const InputRecordType &type, const uint64_t &cycle,
+              const InputChannel &channel = NO_INPUT_CHANNEL, const void* payload = NULL, const size_t &size = 0);
+
+  /// Writes a callback record of a serialised ros message to the input log file.
+  /// @param[in] cycle The control cycle number in which the message was processed
+  /// @param[in] channel The callback processing the message
+  /// @param[in] message The ros message
+  template <class M>
+  inline void recordMessage(const uint64_t &cycle, const InputChannel &channel, const M &message)
+  {
+    uint32_t size = ros::serialization::serializationLength(message);
+    message_buffer_.resize(size);
+    ros::serialization::OStream stream(message_buffer_.data(), size);
+    ros::serialization::serialize(stream, message);
+    record(CALLBACK_RECORD, cycle, channel, message_buffer_.data(), size);
+  };
+
+private:
+  FILE* file_ = NULL;                   ///< Input log file (NULL if not recording)
+  std::vector<uint8_t> message_buffer_; ///< Buffer reused for serialisation of ros messages
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class reads records of an input log file mapped into memory, without copying payloads.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class InputLogReader
+{
+public:
+  /// Destructor for input log reader object. Unmaps the input log file.
+  ~InputLogReader(void) { close(); };
+
+  /// Accessor for the header of the input log file.
+  /// @return Pointer to the header of the mapped input log file
+  inline const InputLogHeader* getHeader(void) { return reinterpret_cast<const InputLogHeader*>(data_); };
+
+  /// Accessor for size of the input log file remaining after the last record read.
+  /// @return The unread size of the input log file, non-zero at the end of a truncated file (bytes)
+  inline size_t getRemaining(void) { return size_ - offset_; };
+
+  /// Maps an input log file into memory and validates its header.
+  /// @param[in] log_file The input log file
+  /// @return Flag denoting if the file was mapped and is a valid input log file
+  bool open(const std::string &log_file);
+
+  /// Unmaps the input log file.
+  void close(void);
+
+  /// Reads the next record of the input log file.
+  /// @param[out] record Pointer to the header of the record
+  /// @param[out] payload Pointer to the payload of the record
+  /// @return Flag denoting if a complete record was read, false at the end of the file
+  bool next(const InputRecordHeader** record, const uint8_t** payload);
+
+  /// Deserialises the ros message of a callback record.
+  /// @param[in] record The header of the callback record
+  /// @param[in] payload Pointer to the payload of the callback record
+  /// @param[out] message The deserialised ros message
+  template <class M>
+  static inline void decodeMessage(const InputRecordHeader &record, const uint8_t* payload, M* message)
+  {
+    ros::serialization::IStream stream(const_cast<uint8_t*>(payload), record.size_);
+    ros::serialization::deserialize(stream, *message);
+  };
+
+private:
+  const uint8_t* data_ = NULL; ///< The mapped input log file
+  size_t size_ = 0;            ///< The size of the mapped input log file (bytes)
+  size_t offset_ = 0;          ///< The offset of the next record to be read (bytes)
+};
+
+/// Calculates the size of a record payload padded to the record alignment.
+/// @param[in] size The size of the payload (bytes)
+/// @return The padded size of the payload (bytes)
+inline size_t paddedRecordSize(const size_t &size)
+{
+  return (size + INPUT_RECORD_ALIGNMENT - 1) & ~size_t(INPUT_RECORD_ALIGNMENT - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_INPUT_LOG_H
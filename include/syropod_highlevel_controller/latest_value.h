@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_LATEST_VALUE_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_LATEST_VALUE_H
+
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class template provides a lock-free slot holding the latest value written by a single writer thread for a
+/// single reader thread (triple buffering). The writer never blocks and the reader always reads a complete value,
+/// with intermediate values overwritten if the writer is faster than the reader. Values are copied into preallocated
+/// buffers so writing and reading do not allocate provided assignment of T does not allocate (e.g. equally sized
+/// Eigen arrays).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <class T>
+class LatestValue
+{
+public:
+  /// Resets all buffers of the slot to an initial value. Not thread safe, must be called before reading/writing.
+  /// @param[in] value The initial value
+  inline void reset(const T &value)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      buffers_[i] = value;
+    }
+    write_index_ = 0;
+    middle_index_ = 1;
+    read_index_ = 2;
+  };
+
+  /// Writes a new latest value to the slot (writer thread only).
+  /// @param[in] value The new latest value
+  inline void write(const T &value)
+  {
+    buffers_[write_index_] = value;
+    write_index_ = middle_index_.exchange(write_index_ | NEW_VALUE_FLAG) & INDEX_MASK;
+  };
+
+  /// Reads the latest value from the slot (reader thread only).
+  /// @param[out] value Pointer to the object to which the latest value is copied
+  /// @return Flag denoting if a new value had been written since the previous read
+  inline bool read(T *value)
+  {
+    bool new_value = (middle_index_.load() & NEW_VALUE_FLAG);
+    if (new_value)
+    {
+      read_index_ = middle_index_.exchange(read_index_) & INDEX_MASK;
+    }
+    *value = buffers_[read_index_];
+    return new_value;
+  };
+
+private:
+  static const int NEW_VALUE_FLAG = 4; ///< Flag set on middle index when it refers to a newly written buffer
+  static const int INDEX_MASK = 3;     ///< Mask to extract buffer index from middle index
+
+  T buffers_[3];                         ///< Buffers for values being written, exchanged and read
+  int write_index_ = 0;                  ///< Index of buffer owned by writer
+  std::atomic<int> middle_index_{ 1 };   ///< Index (and new value flag) of buffer exchanged between writer and reader
+  int read_index_ = 2;                   ///< Index of buffer owned by reader
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_LATEST_VALUE_H
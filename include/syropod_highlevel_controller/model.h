@@ -12,7 +12,8 @@
 #include "standard_includes.h"
 #include "parameters_and_states.h"
 #include "pose.h"
-#include "syropod_highlevel_controller/LegState.h"
+#include "cycle_arena.h"
+#include "event_log.h"
 
 #define IK_TOLERANCE 0.005          ///< Tolerance between desired & resultant tip position from IK/FK(m)
 #define HALF_BODY_DEPTH 0.05        ///< Threshold used to estimate if leg tip has broken the plane of the robot body(m)
@@ -24,6 +25,7 @@
 #define MAX_WORKSPACE_RADIUS 1.0 ///< Maximum radius allowed in workspace polygedron plane (m)
 #define WORKSPACE_LAYERS 10      ///< Number of planes in workspace polyhedron
 
+class Model;
 class Leg;
 class Joint;
 class Link;
@@ -34,7 +36,28 @@ class LegStepper;
 class PoseController;
 class LegPoser;
 
-class DebugVisualiser;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class is the interface through which workspace generation of the robot model is visualised for debugging
+/// purposes, implemented by the debug visualiser of the node such that the model does not depend on ros.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class WorkspaceVisualiser
+{
+public:
+  /// Destructor for workspace visualiser object.
+  virtual ~WorkspaceVisualiser(void) = default;
+
+  /// Publishes the frames in which workspace generation is visualised, fixed at the given pose of the robot body.
+  /// @param[in] body_pose The pose of the robot body (i.e. walk_plane -> base_link) during workspace generation
+  virtual void publishWorkspaceFrames(const Pose &body_pose) = 0;
+
+  /// Captures an intermediate snapshot of workspace generation and queues it for visualisation. Must not block.
+  /// @param[in] model A pointer to the robot model object used in the workspace search
+  /// @param[in] leg A pointer to the leg of the robot model object whose workspace is being generated
+  /// @param[in] body_clearance The vertical offset of the body above the walk plane
+  /// @return Flag denoting if the snapshot was queued
+  virtual bool pushWorkspaceSnapshot(std::shared_ptr<Model> model, std::shared_ptr<Leg> leg,
+                                     const double &body_clearance) = 0;
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This struct contains data from IMU hardware.
@@ -60,8 +83,9 @@ class Model : public std::enable_shared_from_this<Model>
 public:
   /// Contructor for robot model object - initialises member variables from parameters.
   /// @param[in] params A pointer to the parameter data structure
-  /// @param[in] debug_visualiser A pointer to debug visualiser object
-  Model(const Parameters& params, std::shared_ptr<DebugVisualiser> debug_visualiser);
+  /// @param[in] workspace_visualiser A pointer to workspace visualiser object (may be NULL if visualisation is not
+  /// required)
+  Model(const Parameters& params, std::shared_ptr<WorkspaceVisualiser> workspace_visualiser);
   
   /// Copy Constructor for a robot model object. Initialises member variables from existing Model object.
   /// @param[in] model A pointer to a existing reference robot model object
@@ -71,9 +95,19 @@ public:
   /// @return Pointer to leg container object
   inline LegContainer* getLegContainer(void) { return &leg_container_; };
   
-  /// Accessor for debug visualiser pointer.
-  /// @return Pointer to debug visualiser object
-  inline std::shared_ptr<DebugVisualiser> getDebugVisualiser(void) { return debug_visualiser_; };
+  /// Accessor for workspace visualiser pointer.
+  /// @return Pointer to workspace visualiser object
+  inline std::shared_ptr<WorkspaceVisualiser> getWorkspaceVisualiser(void) { return workspace_visualiser_; };
+
+  /// Accessor for cycle arena, from which transient data of model and controller updates is allocated. The arena is
+  /// reset at the start of each control cycle hence allocations from it must not be held across cycles. Functions
+  /// allocating from the arena reclaim their allocations on return via a CycleArenaScope.
+  /// @return Pointer to cycle arena object
+  inline CycleArena* getCycleArena(void) { return &cycle_arena_; };
+
+  /// Accessor for event log, to which events of model and controller updates are recorded by the control thread.
+  /// @return Pointer to event log object
+  inline EventLog* getEventLog(void) { return &event_log_; };
 
   /// Accessor for leg count (number of legs in robot model).
   /// @return Number of legs in the robot model
@@ -158,6 +192,12 @@ public:
   /// Generates workspace polyhedron for each leg in model.
   void generateWorkspaces(void);
   
+  /// Starts the event log thread, which reports events recorded to the event log using the names of the legs and
+  /// joints of the generated model. Events recorded whilst the thread is not running are discarded.
+  /// @param[in] log_file The binary event log file to which events are written (empty to disable)
+  /// @return Flag denoting if the event log thread was started
+  bool startEventLog(const std::string& log_file);
+
   /// Updates model configuration by applying inverse kinematics to solve desired tip poses generated from walk/pose
   /// controllers.
   void updateModel(void);
@@ -167,15 +207,17 @@ public:
   Eigen::Vector3d estimateGravity(void);
 
 private:
-  const Parameters& params_;                     ///< Pointer to parameter structure for storing parameter variables
-  std::shared_ptr<DebugVisualiser> debug_visualiser_; ///< Pointer to debug visualiser object
-  LegContainer leg_container_;                   ///< The container map for all robot model leg objects
+  const Parameters& params_;                                 ///< Pointer to parameter structure
+  std::shared_ptr<WorkspaceVisualiser> workspace_visualiser_; ///< Pointer to workspace visualiser object
+  LegContainer leg_container_;                               ///< The container map for all robot model leg objects
   
   int leg_count_;                ///< The number of leg objects within the robot model
   double time_delta_;            ///< The time period of the ros cycle
   Pose current_pose_;            ///< Current pose of robot model body (i.e. walk_plane -> base_link)
   Pose default_pose_;            ///< Default pose of robot model body (i.e. only body clearance above walk plane)
   ImuData imu_data_;             ///< Imu data structure
+  CycleArena cycle_arena_;       ///< Arena for transient data of a control cycle
+  EventLog event_log_;           ///< Log of events recorded by the control thread
   
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -186,7 +228,6 @@ public:
 /// application of both forward and inverse kinematics. This class contains all child Joint, Link and Tip objects
 /// associated with the leg.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-typedef std::vector<double> state_type; // Impedance state used in admittance controller
 typedef std::map<int, double> Workplane;
 typedef std::map<double, Workplane> Workspace;
 typedef Eigen::aligned_allocator<std::pair<const int, std::shared_ptr<Joint>>> JointAlignedAllocator;
@@ -225,7 +266,7 @@ public:
   
   /// Accessor for the workspace polyhedron.
   /// @return the workspace polyhedron of the leg
-  inline Workspace getWorkspace(void) { return workspace_; };
+  inline const Workspace& getWorkspace(void) { return workspace_; };
 
   /// Accessor for the cuurent state of this leg.
   /// @return The current state of the leg
@@ -267,10 +308,6 @@ public:
   /// @return The virtual damping ratio value used in the admittance control model of this leg
   inline double getVirtualDampingRatio(void) { return virtual_damping_ratio_; };
 
-  /// Accessor for the admittance state object for this leg.
-  /// @return The admittance state object for the leg
-  inline state_type* getAdmittanceState(void) { return &admittance_state_; };
-
   /// Accessor for the container of Joint objects associated with this leg.
   /// @return The container of Joint objects associated with the leg
   inline JointContainer* getJointContainer(void) { return &joint_container_; };
@@ -323,14 +360,6 @@ public:
   /// @param[in] leg_state The new state of this leg
   inline void setLegState(const LegState& leg_state) { leg_state_ = leg_state; };
 
-  /// Modifier for the publisher of leg state messages.
-  /// @param[in] publisher The new ros publisher to publish leg state messages
-  inline void setStatePublisher(const ros::Publisher& publisher) { leg_state_publisher_ = publisher; };
-
-  /// Modifier for the publisher of ASC state messages.
-  /// @param[in] publisher The new ros publisher to publish ASC state messages
-  inline void setASCStatePublisher(const ros::Publisher& publisher) { asc_leg_state_publisher_ = publisher; };
-
   /// Modifier for the LegStepper object associated with this leg.
   /// @param[in] leg_stepper A pointer to the new LegStepper object for this leg
   inline void setLegStepper(std::shared_ptr<LegStepper> leg_stepper) { leg_stepper_ = leg_stepper; };
@@ -379,14 +408,6 @@ public:
   /// @param[in] damping_ratio The new virtual damping ratio value
   inline void setVirtualDampingRatio(const double& damping_ratio) { virtual_damping_ratio_ = damping_ratio; };
 
-  /// Publishes the given message via the leg state pubisher object.
-  /// @param[in] msg The leg state message to be published
-  inline void publishState(const syropod_highlevel_controller::LegState& msg) { leg_state_publisher_.publish(msg); };
-
-  /// Publishes the given message via the ASC leg state pubisher object.
-  /// @param[in] msg The ASC leg state message to be published
-  inline void publishASCState(const std_msgs::Bool& msg) { asc_leg_state_publisher_.publish(msg); };
-
   /// Generates child joint/link/tip objects and copies state from reference leg if provided.
   /// Separated from constructor due to shared_from_this() constraints.
   /// @param[in] leg A pointer to an existing reference robot model leg object
@@ -465,16 +486,18 @@ public:
   /// the Damped Least Squares method to generate a change in joint position for each joint.
   /// @param[in] delta The iterative change in tip position and rotation
   /// @param[in] solve_rotation Flag denoting if IK should solve for rotation as well rather than just position
-  /// @return The position delta for each joint in the model to achieve desired tip position delta. 
+  /// @param[out] joint_position_delta The position delta for each joint in the model to achieve desired tip position
+  /// delta. Must be sized to the joint count of this leg.
   /// @todo Calculate optimal DLS coefficient (this value currently works sufficiently)
-  Eigen::VectorXd solveIK(const Eigen::MatrixXd& delta, const bool& solve_rotation);
+  void solveIK(const Eigen::Matrix<double, 6, 1>& delta, const bool& solve_rotation,
+               Eigen::Ref<Eigen::VectorXd> joint_position_delta);
   
   /// Updates the joint positions of each joint in this leg based on the input vector. Clamps joint velocities and
   /// positions based on limits and calculates a ratio of proximity of joint position to limits.
   /// @param[in] delta The iterative change in joint position for each joint
   /// @param[in] simulation Flag denoting if this execution is for simulation purposes rather than normal use
   /// @return The ratio of the proximity of the joint position to it's limits (i.e. 0.0 = at limit, 1.0 = furthest away)
-  double updateJointPositions(const Eigen::VectorXd& delta, const bool& simulation);
+  double updateJointPositions(const Eigen::Ref<const Eigen::VectorXd>& delta, const bool& simulation);
 
   /// Applies inverse kinematics solution to achieve desired tip position. Clamps joint positions and velocities
   /// within limits and applies forward kinematics to update tip position. Returns an estimate of the chance of solving
@@ -508,14 +531,10 @@ private:
   
   Workspace workspace_;         ///< Polyhedron (planes of radii) representing workspace of this leg
 
-  ros::Publisher leg_state_publisher_;     ///< The ros publisher object that publishes state messages for this leg
-  ros::Publisher asc_leg_state_publisher_; ///< The ros publisher object that publishes ASC state messages for this leg
-
   Eigen::Vector3d admittance_delta_; ///< The admittance controller tip position offset vector
   double virtual_mass_;              ///< The virtual mass of the admittance controller virtual model of this leg
   double virtual_stiffness_;         ///< The virtual stiffness of the admittance controller virtual model of this leg
   double virtual_damping_ratio_;     ///< The virtual damping ratio of the admittance controller virtual model of leg
-  state_type admittance_state_;      ///< The admittance state of the admittance controller virtual model of this leg
 
   Pose desired_tip_pose_;        ///< Desired tip pose before applying Inverse/Forward kinematics
   Pose current_tip_pose_;        ///< Current tip pose according to the model
@@ -623,8 +642,6 @@ public:
   Eigen::Matrix4d current_transform_;          ///< The current transformation matrix between previous joint and joint
   Eigen::Matrix4d identity_transform_;         ///< The identity transformation matrix between previous joint and joint
 
-  ros::Publisher desired_position_publisher_;  ///< The ros publisher for publishing desired position values
-
   const double min_position_ = 0.0;            ///< The minimum position allowed for this joint
   const double max_position_ = 0.0;            ///< The maximum position allowed for this joint
   const double offset_ = 0.0;                  ///< The position offset applied at output of SHC
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_PARAMETER_TREE_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_PARAMETER_TREE_H
+
+#include "standard_includes.h"
+#include <xmlrpcpp/XmlRpcValue.h>
+
+/// Converts a scalar parameter value to a string, as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is of a convertible type
+bool convertParameter(XmlRpc::XmlRpcValue &value, std::string* data);
+
+/// Converts a scalar parameter value to a double (from double or int), as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is of a convertible type
+bool convertParameter(XmlRpc::XmlRpcValue &value, double* data);
+
+/// Converts a scalar parameter value to an int (from int or rounded double), as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is of a convertible type
+bool convertParameter(XmlRpc::XmlRpcValue &value, int* data);
+
+/// Converts a scalar parameter value to a bool, as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is of a convertible type
+bool convertParameter(XmlRpc::XmlRpcValue &value, bool* data);
+
+/// Casts an element of a list or dictionary parameter value, permitting casts between bool, int and double as per
+/// ros::NodeHandle::getParam.
+/// @param[in] value The element value
+/// @param[out] data The cast value
+/// @return Flag denoting if the element value is of a castable type
+template <typename T>
+inline bool castParameterElement(XmlRpc::XmlRpcValue &value, T* data)
+{
+  switch (value.getType())
+  {
+    case (XmlRpc::XmlRpcValue::TypeBoolean):
+      *data = T(bool(value));
+      return true;
+    case (XmlRpc::XmlRpcValue::TypeInt):
+      *data = T(int(value));
+      return true;
+    case (XmlRpc::XmlRpcValue::TypeDouble):
+      *data = T(double(value));
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Casts an element of a list or dictionary parameter value to a string.
+/// @param[in] value The element value
+/// @param[out] data The cast value
+/// @return Flag denoting if the element value is a string
+inline bool castParameterElement(XmlRpc::XmlRpcValue &value, std::string* data)
+{
+  return convertParameter(value, data);
+}
+
+/// Converts a list parameter value to a vector, as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is a list of castable elements
+template <typename T>
+inline bool convertParameter(XmlRpc::XmlRpcValue &value, std::vector<T>* data)
+{
+  if (value.getType() != XmlRpc::XmlRpcValue::TypeArray)
+  {
+    return false;
+  }
+  std::vector<T> converted(value.size());
+  for (int i = 0; i < value.size(); ++i)
+  {
+    if (!castParameterElement(value[i], &converted[i]))
+    {
+      return false;
+    }
+  }
+  data->swap(converted);
+  return true;
+}
+
+/// Converts a dictionary parameter value to a map, as per ros::NodeHandle::getParam.
+/// @param[in] value The parameter value
+/// @param[out] data The converted value
+/// @return Flag denoting if the parameter value is a dictionary of castable elements
+template <typename T>
+inline bool convertParameter(XmlRpc::XmlRpcValue &value, std::map<std::string, T>* data)
+{
+  if (value.getType() != XmlRpc::XmlRpcValue::TypeStruct)
+  {
+    return false;
+  }
+  std::map<std::string, T> converted;
+  for (XmlRpc::XmlRpcValue::iterator it = value.begin(); it != value.end(); ++it)
+  {
+    if (!castParameterElement(it->second, &converted[it->first]))
+    {
+      return false;
+    }
+  }
+  data->swap(converted);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class holds a namespace of the ros parameter server fetched as a single XmlRpc tree, from which parameters are
+/// looked up and converted without further requests to the parameter server. Parameters outside the fetched namespace
+/// (or any parameter if the namespace was not fetched) are requested from the parameter server individually.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class ParameterTree
+{
+public:
+  /// Accessor for the root namespace of the fetched tree.
+  /// @return The root namespace of the fetched tree, or an empty string if no tree has been fetched
+  inline std::string getRoot(void) { return root_; };
+
+  /// Fetches a namespace of the ros parameter server (and all parameters within) in a single request.
+  /// @param[in] root The namespace to fetch, relative to the node namespace (e.g. "syropod")
+  /// @return Flag denoting if the namespace was fetched
+  bool fetch(const std::string &root);
+
+  /// Acquires a parameter from the fetched tree, or from the parameter server if outside the fetched namespace.
+  /// Conversion of the parameter value to the data type follows ros::NodeHandle::getParam.
+  /// @param[in] key The name of the parameter, relative to the node namespace (e.g. "syropod/parameters/time_delta")
+  /// @param[out] data The parameter data, unchanged if the parameter does not exist or is of an unconvertible type
+  /// @return Flag denoting if the parameter exists and was converted
+  template <typename T>
+  inline bool getParam(const std::string &key, T &data)
+  {
+    XmlRpc::XmlRpcValue* value;
+    if (!find(key, &value))
+    {
+      XmlRpc::XmlRpcValue requested_value;
+      return getCoreInterface()->getParameter(key, &requested_value) && convertParameter(requested_value, &data);
+    }
+    return value != NULL && convertParameter(*value, &data);
+  };
+
+private:
+  /// Finds a parameter within the fetched tree.
+  /// @param[in] key The name of the parameter, relative to the node namespace
+  /// @param[out] value Pointer to the parameter value within the tree, or NULL if the parameter does not exist
+  /// @return Flag denoting if the key lies within the fetched namespace
+  bool find(const std::string &key, XmlRpc::XmlRpcValue** value);
+
+  std::string root_;         ///< The fetched namespace (empty if not fetched)
+  XmlRpc::XmlRpcValue tree_; ///< The fetched namespace and all parameters within
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_PARAMETER_TREE_H
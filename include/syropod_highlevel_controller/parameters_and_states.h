@@ -10,6 +10,7 @@
 #define SYROPOD_HIGHLEVEL_CONTROLLER_PARAMETERS_AND_STATES_H
 
 #include "standard_includes.h"
+#include "parameter_tree.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Designation for potential states of the entire top-level controller system.
@@ -203,11 +204,25 @@ public:
                    const std::string &base_parameter_name = "syropod/parameters/",
                    const bool &required_input = true)
   {
-    ros::NodeHandle n;
+    ParameterTree tree; // Not fetched, hence parameter is requested from ros parameter server
+    init(tree, name_input, base_parameter_name, required_input);
+  }
+
+  /// Initialisation function which self populates parameter data from a parameter tree previously fetched from the
+  /// ros parameter server, avoiding a parameter server request per parameter.
+  /// @param[in] tree The parameter tree from which to acquire the parameter
+  /// @param[in] name_input The unique name of the parameter to look for on ros parameter server
+  /// @param[in] base_parameter_name The base parameter name prepended to 'name_input' common to all parameters
+  /// @param[in] required_input Bool denoting if this parameter is required to be initialised
+  inline void init(ParameterTree &tree,
+                   const std::string &name_input,
+                   const std::string &base_parameter_name = "syropod/parameters/",
+                   const bool &required_input = true)
+  {
     name = name_input;
     required = required_input;
-    initialised = n.getParam(base_parameter_name + name_input, data);
-    ROS_ERROR_COND(!initialised && required_input, "Error reading parameter/s %s from rosparam."
+    initialised = tree.getParam(base_parameter_name + name_input, data);
+    SHC_ERROR_COND(!initialised && required_input, "Error reading parameter/s %s from rosparam."
                    " Check config file is loaded and type is correct\n", name.c_str());
   }
 
@@ -235,12 +250,26 @@ public:
                    const std::string& base_parameter_name = "syropod/parameters/",
                    const bool& required_input = true)
   {
-    ros::NodeHandle n;
+    ParameterTree tree; // Not fetched, hence parameter is requested from ros parameter server
+    init(tree, name_input, base_parameter_name, required_input);
+  }
+
+  /// Initialisation function which self populates parameter data from a parameter tree previously fetched from the
+  /// ros parameter server, avoiding a parameter server request per parameter.
+  /// @param[in] tree The parameter tree from which to acquire the parameter
+  /// @param[in] name_input The unique name of the parameter to look for on ros parameter server
+  /// @param[in] base_parameter_name The base parameter name prepended to 'name_input' common to all parameters
+  /// @param[in] required_input Bool denoting if this parameter is required to be initialised
+  inline void init(ParameterTree& tree,
+                   const std::string& name_input,
+                   const std::string& base_parameter_name = "syropod/parameters/",
+                   const bool& required_input = true)
+  {
     name = name_input;
     required = required_input;
-    initialised = n.getParam(base_parameter_name + name_input, data);
-    ROS_ERROR_COND(!initialised && required_input, "Error reading parameter/s %s%s from rosparam."
-                   " Check config file is loaded and type is correct\n", name.c_str());
+    initialised = tree.getParam(base_parameter_name + name_input, data);
+    SHC_ERROR_COND(!initialised && required_input, "Error reading parameter/s %s%s from rosparam."
+                   " Check config file is loaded and type is correct\n", base_parameter_name.c_str(), name.c_str());
 
     if (initialised)
     {
@@ -258,10 +287,37 @@ public:
   double default_value; ///< The default value of this adjustable parameter
   double adjust_step;   ///< The allowable increment or decrement of the current value of this adjustable parameter
 
+  ParameterSelection selection = NO_PARAMETER_SELECTION; ///< The designation of this adjustable parameter
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains the parameter objects which define a single gait. Allows the parameters of every gait to be
+/// acquired once from the ros parameter server and then switched between without further parameter server requests.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct GaitParameters
+{
+  Parameter<int> stance_phase;                             ///< The ratio of the entire step cycle which is in 'stance'
+  Parameter<int> swing_phase;                              ///< The ratio of the entire step cycle which is in 'swing'
+  Parameter<int> phase_offset;                             ///< The phase offset between step cycles of successive legs
+  Parameter<std::map<std::string, int>> offset_multiplier; ///< The leg dependent multiplier for the step cycle offset
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains a set of PID controller gains.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct PIDGains
+{
+  double p = 0.0; ///< The proportional gain
+  double i = 0.0; ///< The integral gain
+  double d = 0.0; ///< The derivative gain
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This structure contains the parameter objects for all parameters associated with control of the robot, as well as a
 /// map object of adjustable parameters. It is used to easily pass parameters amongst controller objects.
@@ -273,13 +329,19 @@ struct Parameters
   AdjustableMapType adjustable_map;  ///< Map between adjustable parameter designations and associated Parameter object
 
   // Control parameters
-  Parameter<double> time_delta;        ///< The period of time between successive ros cycles
-  Parameter<bool> imu_posing;          ///< Flag denoting if the imu posing feature is on/off
-  Parameter<bool> auto_posing;         ///< Flag denoting if the auto posing feature is on/off
-  Parameter<bool> manual_posing;       ///< Flag denoting if the manual posing feature is on/off
-  Parameter<bool> inclination_posing;  ///< Flag denoting if the inclination posing feature is on/off
-  Parameter<bool> rough_terrain_mode;  ///< Flag denoting if rough terrain mode is on/off (affects various systems)
-  Parameter<bool> admittance_control;  ///< Flag denoting if the admittance control feature is on/off
+  Parameter<double> time_delta;          ///< The period of time between successive ros cycles
+  Parameter<double> output_rate;         ///< The frequency at which interpolated joint setpoints are published
+  Parameter<int> output_priority;        ///< The SCHED_FIFO priority of the output thread (0 = unset)
+  Parameter<bool> real_time_loop;        ///< Flag denoting if the control loop runs in real-time mode
+  Parameter<int> real_time_priority;     ///< The SCHED_FIFO priority of the control loop in real-time mode (0 = unset)
+  Parameter<int> real_time_cpu;          ///< The CPU core the control loop is pinned to in real-time mode (-1 = unset)
+  Parameter<bool> real_time_lock_memory; ///< Flag denoting if process memory is locked in real-time mode
+  Parameter<bool> imu_posing;            ///< Flag denoting if the imu posing feature is on/off
+  Parameter<bool> auto_posing;           ///< Flag denoting if the auto posing feature is on/off
+  Parameter<bool> manual_posing;         ///< Flag denoting if the manual posing feature is on/off
+  Parameter<bool> inclination_posing;    ///< Flag denoting if the inclination posing feature is on/off
+  Parameter<bool> rough_terrain_mode;    ///< Flag denoting if rough terrain mode is on/off (affects various systems)
+  Parameter<bool> admittance_control;    ///< Flag denoting if the admittance control feature is on/off
 
   // Motor Interface parameters
   Parameter<bool> individual_control_interface;   ///< Flag requesting the individual desired joint position format
@@ -317,6 +379,10 @@ struct Parameters
   Parameter<bool> gravity_aligned_tips;             ///< Flag denoting if tip should align with gravity direction
   Parameter<double> touchdown_threshold;            ///< Threshold of tip force before touchdown is recognized
   Parameter<double> liftoff_threshold;              ///< Threshold of tip force before liftoff is recognized
+  Parameter<int> gait_transition_cycles;            ///< Step cycles over which gait changes whilst walking (0 = stop)
+  Parameter<bool> free_gait;                        ///< Flag denoting if lift off is triggered by reach and stability
+  Parameter<double> free_gait_reach_margin;         ///< Remaining stance reach (ratio of walkspace) to trigger lift off
+  Parameter<double> free_gait_stability_margin;     ///< Minimum support polygon stability margin allowing lift off
   Parameter<std::map<std::string, double>> linear_cruise_velocity;  ///< Set values used in cruise control mode if used
   Parameter<std::map<std::string, double>> leg_stance_positions[8]; ///< Array of maps of default tip stance positions
 
@@ -336,6 +402,7 @@ struct Parameters
   Parameter<bool> dynamic_stiffness;         ///< Flag denoting whether the virtual stiffness variable is dynamic
   Parameter<bool> use_joint_effort;          ///< Flag denoting whether the tip force input is derived from joint effort
   Parameter<double> integrator_step_time;    ///< The step time used in admittance controller calculations
+  Parameter<double> admittance_rate;         ///< The frequency of the admittance thread (0.0 = in control loop)
   AdjustableParameter virtual_mass;          ///< The virtual mass value used in admittance controller calculations
   AdjustableParameter virtual_stiffness;     ///< The virtual stiffness value used in admittance controller calculations
   Parameter<double> load_stiffness_scaler;   ///< The value used to scale the virtual stiffness value for loaded legs
@@ -375,6 +442,53 @@ struct Parameters
   Parameter<bool> debug_workspace_calc;      ///< Flag determining if workspace calculations output debug info
   Parameter<bool> debug_IK;                  ///< Flag determining if inverse kinematics engine outputs debug info
   Parameter<bool> debug_rviz;                ///< Flag determining if visualisation markers are output for debugging
+  Parameter<std::map<std::string, double>> debug_rviz_rates; ///< Publish rates of each debug visualisation stream
+
+  // Diagnostic parameters
+  Parameter<double> timing_diagnostics_period;  ///< The period at which timing diagnostics are published (0.0 = off)
+  Parameter<double> leg_states_rate;            ///< The frequency at which aggregated leg states are published
+  Parameter<bool> publish_joint_frames;         ///< Flag denoting if joint frames are broadcast to the tf tree
+  Parameter<std::string> allocation_guard;      ///< Action upon heap allocation in the RUNNING loop (off/log/abort)
+  Parameter<double> allocation_guard_warmup;    ///< Time in RUNNING state before the allocation guard is armed
+  Parameter<std::string> event_log_file;        ///< Binary file to which control thread events are logged (optional)
+  Parameter<std::string> input_record_file;     ///< Binary file to which control thread inputs are recorded (optional)
+  Parameter<std::string> transition_cache_file; ///< Binary file caching the start up transition sequence (optional)
+
+  // Resolved parameters (typed forms of dictionary parameters read by the control loop)
+  Eigen::Vector3d max_translation_limit = Eigen::Vector3d::Zero(); ///< Resolved max_translation (x, y, z)
+  Eigen::Vector3d max_rotation_limit = Eigen::Vector3d::Zero();    ///< Resolved max_rotation (roll, pitch, yaw)
+  PIDGains rotation_gains;                                         ///< Resolved rotation_pid_gains (p, i, d)
+  std::vector<int> leg_offset_multiplier; ///< Resolved offset_multiplier, indexed by leg id number (leg_id order)
+
+  /// Resolves dictionary parameters read by the control loop into typed parameters, avoiding string keyed lookups
+  /// each control cycle. Must be called upon any change to the dictionary parameters (i.e. loading or gait change).
+  inline void resolve(void)
+  {
+    if (max_translation.initialised)
+    {
+      max_translation_limit = Eigen::Vector3d(max_translation.data.at("x"),
+                                              max_translation.data.at("y"),
+                                              max_translation.data.at("z"));
+    }
+    if (max_rotation.initialised)
+    {
+      max_rotation_limit = Eigen::Vector3d(max_rotation.data.at("roll"),
+                                           max_rotation.data.at("pitch"),
+                                           max_rotation.data.at("yaw"));
+    }
+    if (rotation_pid_gains.initialised)
+    {
+      rotation_gains.p = rotation_pid_gains.data.at("p");
+      rotation_gains.i = rotation_pid_gains.data.at("i");
+      rotation_gains.d = rotation_pid_gains.data.at("d");
+    }
+    leg_offset_multiplier.assign(leg_id.data.size(), 0);
+    for (int l = 0; l < int(leg_id.data.size()) && offset_multiplier.initialised; ++l)
+    {
+      SHC_ASSERT(offset_multiplier.data.count(leg_id.data[l]));
+      leg_offset_multiplier[l] = offset_multiplier.data.at(leg_id.data[l]);
+    }
+  };
 
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
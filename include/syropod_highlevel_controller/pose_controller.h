@@ -23,9 +23,26 @@
 #define STABILITY_THRESHOLD 100        ///< Rotation correction magnitude threshold, ensuring imu posing PID is not unstable.
 #define TRANSITION_STEP_THRESHOLD 20   ///< Number of allowed transition steps before executeSequence() deemed a failure
 #define IMU_POSING_DEADBAND 0.0        ///< Rotation deadband for which imu posing assumes correct rotation (radians)
+#define TRANSITION_CACHE_MAGIC "SHCTRN1" ///< Identifier written at the start of transition cache files (with '\0')
+#define TRANSITION_CACHE_VERSION 1       ///< Version of the transition cache file format
 
 class AutoPoser;
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This struct contains the header written at the start of transition cache files, describing the robot configuration
+/// for which the cached start up transition sequence was generated. The header is followed by the transition poses of
+/// each leg (in leg id number order) as doubles: position (x, y, z) and rotation (w, x, y, z) of each transition pose.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TransitionCacheHeader
+{
+  char magic_[8] = TRANSITION_CACHE_MAGIC;      ///< Identifier of transition cache files
+  uint32_t version_ = TRANSITION_CACHE_VERSION; ///< Version of the transition cache file format
+  uint32_t leg_count_ = 0;                      ///< Number of legs of the robot model
+  uint32_t transition_step_count_ = 0;          ///< Number of transition steps in the cached sequence
+  uint32_t reserved_ = 0;                       ///< Reserved (padding)
+  uint64_t configuration_key_ = 0;              ///< Hash of the robot configuration the sequence was generated for
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This class has two purposes. One is to manage functions which iteratively execute robot leg posing sequences, both
 /// via direct joint control, and via tip position control and inverse kinematics (IK). Such sequences include the
@@ -165,6 +182,20 @@ public:
   /// @todo Make sequential leg stepping coordination an option instead of only simultaneous (direct) & groups (tripod)
   int executeSequence(const SequenceSelection &sequence);
 
+  /// Generates a key identifying the robot configuration upon which the start up transition sequence depends, i.e. the
+  /// joint limits, unpacked joint positions and DH parameters of each leg and the default tip pose of each leg.
+  /// @return The configuration key (FNV-1a hash of the robot configuration)
+  uint64_t generateTransitionCacheKey(void);
+
+  /// Loads a start up transition sequence from the transition cache file (parameter 'transition_cache_file') and adds
+  /// the cached transition poses to the leg poser of each leg, following the initial transition pose. The cache is only
+  /// loaded if it was generated for the current robot configuration and from the current initial tip positions.
+  /// @return Flag denoting if a valid transition sequence was loaded from the transition cache file
+  bool loadTransitionSequence(void);
+
+  /// Saves the transition sequence generated during the first start up sequence to the transition cache file.
+  void saveTransitionSequence(void);
+
   /// Iterates through legs in robot model and, in simulation, moves them in a linear trajectory directly from
   /// their current tip position to its default tip position (as defined by the walk controller). The joint states for
   /// each leg are saved for the deafult tip position and then the joint moved inpdependently from initial position to
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_REALTIME_LOOP_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_REALTIME_LOOP_H
+
+#include "standard_includes.h"
+
+#include <time.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class paces a loop on an absolute monotonic timeline using clock_nanosleep, such that sleep durations do not
+/// accumulate drift from the time spent computing each cycle. It optionally configures the calling thread for
+/// real-time execution (SCHED_FIFO priority, CPU affinity and locked process memory) and tracks the timing of each
+/// cycle: the jitter of each cycle start from its scheduled time, the compute time of each cycle and the number of
+/// cycles which overran their deadline (the scheduled start of the following cycle).
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class RealTimeLoop
+{
+public:
+  /// Constructor for real-time loop object.
+  /// @param[in] period The period of each loop cycle
+  RealTimeLoop(const double &period);
+
+  /// Accessor for count of completed cycles since timing statistics were last reset.
+  /// @return Count of completed cycles
+  inline int getCycleCount(void) { return cycle_count_; };
+
+  /// Accessor for count of cycles which overran their deadline since timing statistics were last reset.
+  /// @return Count of deadline overruns
+  inline int getOverrunCount(void) { return overrun_count_; };
+
+  /// Accessor for count of scheduled cycles which were skipped due to deadline overruns.
+  /// @return Count of skipped cycles
+  inline int getSkippedCycleCount(void) { return skipped_cycle_count_; };
+
+  /// Accessor for start jitter of the current cycle.
+  /// @return Delay between the scheduled and actual start of the current cycle
+  inline double getJitter(void) { return jitter_; };
+
+  /// Accessor for the maximum cycle start jitter since timing statistics were last reset.
+  /// @return Maximum delay between the scheduled and actual start of a cycle
+  inline double getMaxJitter(void) { return max_jitter_; };
+
+  /// Accessor for the mean cycle start jitter since timing statistics were last reset.
+  /// @return Mean delay between the scheduled and actual start of a cycle
+  inline double getMeanJitter(void) { return cycle_count_ > 0 ? jitter_sum_ / cycle_count_ : 0.0; };
+
+  /// Accessor for compute time of the previous cycle.
+  /// @return Time between the start of the previous cycle and the call to sleep() which ended it
+  inline double getComputeTime(void) { return compute_time_; };
+
+  /// Accessor for the maximum cycle compute time since timing statistics were last reset.
+  /// @return Maximum time between the start of a cycle and the call to sleep() which ended it
+  inline double getMaxComputeTime(void) { return max_compute_time_; };
+
+  /// Configures the calling thread for real-time execution. Failures are reported but otherwise ignored such that the
+  /// loop may still run without the required privileges.
+  /// @param[in] priority SCHED_FIFO priority of the calling thread (a value of zero leaves the policy unchanged)
+  /// @param[in] cpu CPU core to which the calling thread is pinned (a value of -1 leaves the affinity unchanged)
+  /// @param[in] lock_memory Flag denoting if all current and future memory of the process is locked into RAM
+  /// @return Flag denoting if all requested configuration was applied successfully
+  bool configure(const int &priority, const int &cpu, const bool &lock_memory);
+
+  /// Starts the loop timeline, scheduling the first cycle to start now.
+  void start(void);
+
+  /// Ends the current cycle and sleeps until the scheduled start of the next cycle. If the current cycle has overrun
+  /// its deadline, the overrun is counted and any missed cycles are skipped such that the timeline is not run back to
+  /// back to catch up.
+  void sleep(void);
+
+  /// Resets all timing statistics.
+  void resetStatistics(void);
+
+private:
+  /// Calculates the difference between two points on the monotonic timeline.
+  /// @param[in] end The later point on the timeline
+  /// @param[in] start The earlier point on the timeline
+  /// @return The time from start to end (seconds)
+  double timeDifference(const timespec &end, const timespec &start);
+
+  /// Advances a point on the monotonic timeline by the loop period.
+  /// @param[in,out] time The point on the timeline to advance
+  void advance(timespec* time);
+
+  long period_nsec_;         ///< Period of each loop cycle (nanoseconds)
+  timespec scheduled_start_; ///< Scheduled start time of the current cycle
+  timespec cycle_start_;     ///< Actual start time of the current cycle
+
+  int cycle_count_ = 0;           ///< Count of completed cycles
+  int overrun_count_ = 0;         ///< Count of cycles which overran their deadline
+  int skipped_cycle_count_ = 0;   ///< Count of scheduled cycles skipped due to overruns
+  double jitter_ = 0.0;           ///< Start jitter of the current cycle
+  double max_jitter_ = 0.0;       ///< Maximum cycle start jitter
+  double jitter_sum_ = 0.0;       ///< Sum of cycle start jitter used to calculate mean
+  double compute_time_ = 0.0;     ///< Compute time of the previous cycle
+  double max_compute_time_ = 0.0; ///< Maximum cycle compute time
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_REALTIME_LOOP_H
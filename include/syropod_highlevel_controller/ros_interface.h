@@ -0,0 +1,80 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SYROPOD_HIGHLEVEL_CONTROLLER_ROS_INTERFACE_H
+#define SYROPOD_HIGHLEVEL_CONTROLLER_ROS_INTERFACE_H
+
+#include "standard_includes.h"
+
+#include <ros/ros.h>
+#include <ros/console.h>
+#include <ros/assert.h>
+#include <ros/exceptions.h>
+
+#include <dynamic_reconfigure/server.h>
+
+#include <std_msgs/Bool.h>
+#include <std_msgs/Int8.h>
+#include <std_msgs/Float64.h>
+#include <std_msgs/Float32MultiArray.h>
+#include <std_msgs/UInt16.h>
+
+#include <sensor_msgs/Imu.h>
+#include <sensor_msgs/Joy.h>
+
+#include <visualization_msgs/Marker.h>
+#include <visualization_msgs/MarkerArray.h>
+
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+#include <tf2_ros/transform_broadcaster.h>
+#include <tf2_ros/transform_listener.h>
+#include <tf2_ros/static_transform_broadcaster.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This class implements the interface of the core library to its host using ros: parameters are looked up from the
+/// parameter server, messages are logged via rosconsole and time and shutdown follow those of the node.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class RosInterface : public CoreInterface
+{
+public:
+  /// Looks up a parameter from the ros parameter server.
+  /// @param[in] key The name of the parameter, relative to the node namespace
+  /// @param[out] value Pointer to the value to populate with the parameter
+  /// @return Flag denoting if the parameter was found
+  bool getParameter(const std::string &key, XmlRpc::XmlRpcValue* value) override;
+
+  /// Determines if messages of the given level are logged, as per the level of the rosconsole logger of the package.
+  /// @param[in] level The level of the message
+  /// @return Flag denoting if messages of the given level are logged
+  bool isLogEnabled(const LogLevel &level) override;
+
+  /// Logs a formatted message via rosconsole, attributed to the source location from which it was logged.
+  /// @param[in] level The level of the message
+  /// @param[in] file The source file from which the message was logged
+  /// @param[in] line The line of the source file from which the message was logged
+  /// @param[in] function The function from which the message was logged
+  /// @param[in] message The formatted message
+  void log(const LogLevel &level, const char* file, const int &line, const char* function,
+           const char* message) override;
+
+  /// Accessor for the current ros time (simulated time if in use).
+  /// @return The current ros time (seconds)
+  double now(void) override;
+
+  /// Determines if the node is running.
+  /// @return Flag denoting if the node is running, as per ros::ok()
+  bool ok(void) override;
+
+  /// Shuts down the node.
+  void shutdown(void) override;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#endif // SYROPOD_HIGHLEVEL_CONTROLLER_ROS_INTERFACE_H
@@ -9,22 +9,9 @@
 #ifndef SYROPOD_HIGHLEVEL_CONTROLLER_STANDARD_INCLUDES_H
 #define SYROPOD_HIGHLEVEL_CONTROLLER_STANDARD_INCLUDES_H
 
-#include <ros/ros.h>
-#include <ros/console.h>
-#include <ros/assert.h>
-#include <ros/exceptions.h>
+#include "core_interface.h"
 
-#include <dynamic_reconfigure/server.h>
-
-#include <std_msgs/Bool.h>
-#include <std_msgs/Int8.h>
-#include <std_msgs/Float64.h>
-#include <std_msgs/Float32MultiArray.h>
-#include <std_msgs/UInt16.h>
-
-#include <sensor_msgs/Imu.h>
 #include <sensor_msgs/JointState.h>
-#include <sensor_msgs/Joy.h>
 
 #include <geometry_msgs/Twist.h>
 #include <geometry_msgs/Point.h>
@@ -32,13 +19,6 @@
 #include <geometry_msgs/Transform.h>
 #include <geometry_msgs/TransformStamped.h>
 
-#include <visualization_msgs/Marker.h>
-#include <visualization_msgs/MarkerArray.h>
-
-#include <tf2_ros/transform_broadcaster.h>
-#include <tf2_ros/transform_listener.h>
-#include <tf2_ros/static_transform_broadcaster.h>
-
 #include <Eigen/StdVector>
 #include <Eigen/Geometry>
 
@@ -48,10 +28,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
 
 #define UNASSIGNED_VALUE double(INT_MAX) ///< Value used to determine if variable has been assigned
 #define PROGRESS_COMPLETE 100            ///< Value denoting 100% and a completion of progress of various functions
-#define THROTTLE_PERIOD 5                ///< Default throttle period for all throttled rosconsole messages (seconds)
+#define THROTTLE_PERIOD 5                ///< Default throttle period for all throttled log messages (seconds)
 
 #define UNDEFINED_ROTATION Eigen::Quaterniond(0, 0, 0, 0)
 #define UNDEFINED_POSITION Eigen::Vector3d(double(INT_MAX), double(INT_MAX), double(INT_MAX))
@@ -105,7 +88,7 @@ inline int roundToEvenInt(const double& x) { return (int(x) % 2 == 0 ? int(x) :
 template <class T>
 inline T clamped(const T& value, const T& min_value, const T& max_value)
 {
-  ROS_ASSERT(min_value <= max_value);
+  SHC_ASSERT(min_value <= max_value);
   return std::max(min_value, std::min(value, max_value));
 }
 
@@ -200,7 +183,7 @@ inline Eigen::Vector3d getRejection(const Eigen::Vector3d& a, const Eigen::Vecto
 template <class T>
 inline T interpolate(const T& origin, const T& target, const double& control_input)
 {
-  ROS_ASSERT(control_input >= 0.0 && control_input <= 1.0);
+  SHC_ASSERT(control_input >= 0.0 && control_input <= 1.0);
   return (1.0 - control_input) * origin + control_input * target;
 }
 
@@ -388,7 +371,7 @@ inline Eigen::Vector3d cubicBezierCurveThroughControlPoint(const T *points, cons
   }
   else
   {
-    ROS_WARN("Something terribly wrong is happening. New Control points for the Cubic Bezier is NOT being generated as expected.");
+    SHC_WARN("Something terribly wrong is happening. New Control points for the Cubic Bezier is NOT being generated as expected.");
     return Eigen::Vector3d(0, 0, 0);
   }
 }
@@ -452,7 +435,7 @@ inline Eigen::Vector3d quarticBezierCurveThroughControlPoint(const T *points, co
   }
   else
   {
-    ROS_WARN("Something terribly wrong. New Control points for the Quartic Bezier is NOT being generated as expected.");
+    SHC_WARN("Something terribly wrong. New Control points for the Quartic Bezier is NOT being generated as expected.");
     return Eigen::Vector3d(0, 0, 0);
   }
 }
@@ -10,10 +10,12 @@
 #define SYROPOD_HIGHLEVEL_CONTROLLER_STATE_CONTROLLER_H
 
 #include "standard_includes.h"
+#include "ros_interface.h"
 #include "parameters_and_states.h"
 
 #include "syropod_highlevel_controller/DynamicConfig.h"
 #include "syropod_highlevel_controller/TipState.h"
+#include "syropod_highlevel_controller/LegStateArray.h"
 #include "syropod_highlevel_controller/TargetTipPose.h"
 
 #include "walk_controller.h"
@@ -22,9 +24,65 @@
 
 #include "debug_visualiser.h"
 #include "admittance_controller.h"
+#include "latest_value.h"
+#include "realtime_loop.h"
+#include "cycle_timing.h"
+#include "input_log.h"
 
-#define MAX_MANUAL_LEGS 2 ///< Maximum number of legs able to be manually manipulated simultaneously
-#define PACK_TIME 2.0     ///< Joint transition time during pack/unpack sequences (seconds @ step frequency == 1.0)
+#include <ros/callback_queue.h>
+#include <ros/spinner.h>
+
+#include <chrono>
+#include <cinttypes>
+
+#define MAX_MANUAL_LEGS 2     ///< Maximum number of legs able to be manually manipulated simultaneously
+#define PACK_TIME 2.0         ///< Joint transition time during pack/unpack sequences (seconds @ step frequency == 1.0)
+#define ODOM_PROBE_PERIOD 1.0 ///< Period between probes of the tf tree for a perception odom transform (seconds)
+
+#define SENSOR_RECORD_IMU_SIZE 11 ///< Number of doubles of IMU data packed in sensor data records
+#define SENSOR_RECORD_LEG_SIZE 11 ///< Number of doubles of tip state data per leg packed in sensor data records
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains the segment of the desired trajectory of all joints between the two most recent control
+/// cycles, from which the output thread interpolates desired joint positions when running in multi-rate mode. Joint
+/// data is indexed in the order of the output joints, with arrays sized when the output thread is started so that
+/// passing segments between threads does not allocate.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct OutputSegment
+{
+  std::chrono::steady_clock::time_point start_time_; ///< The time at which the segment started
+  Eigen::ArrayXd offset_;                            ///< Offset added to positions published on individual publishers
+  Eigen::ArrayXd start_position_;                    ///< The desired joint positions at the start of the segment
+  Eigen::ArrayXd end_position_;                      ///< The desired joint positions at the end of the segment
+  Eigen::ArrayXd start_velocity_;                    ///< The desired joint velocities at the start of the segment
+  Eigen::ArrayXd end_velocity_;                      ///< The desired joint velocities at the end of the segment
+  Eigen::ArrayXd effort_;                            ///< The desired joint efforts over the segment
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// This structure contains the latest data received from the IMU, joint state and tip state sensor topics. It is
+/// written by the sensor callbacks on the sensor spinner thread and sampled by the control loop at the start of each
+/// cycle. Joint data is indexed by sensor joint index and tip data by leg id number, with arrays sized on construction
+/// of the state controller so that passing the data between threads does not allocate.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SensorData
+{
+  bool imu_received_ = false;                                           ///< Flags if IMU data has been received
+  Eigen::Quaterniond imu_orientation_ = Eigen::Quaterniond::Identity(); ///< The latest IMU orientation
+  Eigen::Vector3d imu_linear_acceleration_ = Eigen::Vector3d::Zero();   ///< The latest IMU linear acceleration
+  Eigen::Vector3d imu_angular_velocity_ = Eigen::Vector3d::Zero();      ///< The latest IMU angular velocity
+  Eigen::ArrayXd joint_position_;                                       ///< Latest position of each joint (with offset)
+  Eigen::ArrayXd joint_velocity_;                                       ///< The latest velocity of each joint
+  Eigen::ArrayXd joint_effort_;                                         ///< The latest effort of each joint
+  Eigen::Array<uint, Eigen::Dynamic, 1> wrench_count_;                  ///< Number of tip wrenches received of each leg
+  Eigen::Array<double, 3, Eigen::Dynamic> tip_force_;                   ///< Latest measured tip force of each leg
+  Eigen::Array<double, 3, Eigen::Dynamic> tip_torque_;                  ///< Latest measured tip torque of each leg
+  Eigen::Array<uint, Eigen::Dynamic, 1> step_plane_count_;              ///< Number of step planes received of each leg
+  Eigen::Array<double, 3, Eigen::Dynamic> step_plane_;                  ///< Latest step plane of each leg
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// This class creates and initialises all ros publishers/subscriptions; sub-controllers: Walk Controller,
@@ -41,7 +99,8 @@ class StateController
 {
 public:
   /// StateController class constructor. Initialises parameters, creates robot model object, sets up ros topic
-  /// subscriptions and advertisments.
+  /// subscriptions and advertisments. Sensor topic subscriptions are serviced by a separate callback queue and
+  /// spinner thread.
   StateController(void);
 
   /// StateController object destructor.
@@ -51,33 +110,90 @@ public:
   /// @return Parameter data structure which contains parameter variables
   inline const Parameters& getParameters(void) { return params_; };
 
+  /// Accessor for robot model member.
+  /// @return Pointer to robot model object
+  inline std::shared_ptr<Model> getModel(void) { return model_; };
+
+  /// Accessor for walk controller member.
+  /// @return Pointer to walk controller object
+  inline std::shared_ptr<WalkController> getWalker(void) { return walker_; };
+
+  /// Accessor for pose controller member.
+  /// @return Pointer to pose controller object
+  inline std::shared_ptr<PoseController> getPoser(void) { return poser_; };
+
+  /// Accessor for admittance controller member.
+  /// @return Pointer to admittance controller object
+  inline std::shared_ptr<AdmittanceController> getAdmittance(void) { return admittance_; };
+
   /// Accessor for system state member.
   /// @return Current state of the system
   inline SystemState getSystemState(void) { return system_state_; };
 
+  /// Accessor for robot state member.
+  /// @return Current state of the robot
+  inline RobotState getRobotState(void) { return robot_state_; };
+
+  /// Accessor for planner step member.
+  /// @return The step of the plan currently requested from or being executed for the planner interface
+  inline int getPlanStep(void) { return plan_step_; };
+
   /// Returns true if all joint objects in model have been initialised with a current position.
   /// @return Flag denoting whether all joint objects in model have been initialised with a current position
   inline bool jointPositionsInitialised(void) { return joint_positions_initialised_; };
 
+  /// Accessor for timing statistics of a stage of the control cycle.
+  /// @param[in] stage The timed stage of the control cycle
+  /// @return Pointer to timing statistics of the stage, or NULL if timing diagnostics are disabled
+  inline TimingStatistics* getStageTiming(const TimingStage &stage)
+  {
+    return params_.timing_diagnostics_period.data > 0.0 ? &stage_timing_[stage] : NULL;
+  };
+
+  /// Accessor for heap allocation statistics of a stage of the control cycle.
+  /// @param[in] stage The tracked stage of the control cycle
+  /// @return Pointer to allocation statistics of the stage, or NULL if timing diagnostics are disabled or heap
+  /// allocation tracking is not compiled in
+  inline AllocationStatistics* getStageAllocations(const TimingStage &stage)
+  {
+    bool tracked = allocationTrackingEnabled() && params_.timing_diagnostics_period.data > 0.0;
+    return tracked ? &stage_allocations_[stage] : NULL;
+  };
+
   /// Initialises the model by calling the model object function initLegs().
   /// @param[in] use_default_joint_positions Flag indicating whether to use default joint positions or not
   inline void initModel(const bool &use_default_joint_positions = false)
   {
+    uint8_t use_default = use_default_joint_positions;
+    input_recorder_.record(MODEL_INIT_RECORD, cycle_count_, NO_INPUT_CHANNEL, &use_default, sizeof(uint8_t));
     model_->initLegs(use_default_joint_positions);
   };
 
   /// StateController initialiser function. Initialises member variables: robot state, gait selection and initalisation
-  /// flag and creates sub controller objects: WalkController, PoseController and AdmittanceController.
+  /// flag and creates sub controller objects: WalkController and PoseController.
   void init(void);
 
+  /// Samples the latest sensor data written by the sensor callbacks and applies it to the robot model, giving the
+  /// control cycle a consistent view of all sensors. Called once at the start of each cycle of the main ros loop.
+  void updateSensorData(void);
+
+  /// Applies the sampled sensor data to the joint, IMU and leg objects of the robot model.
+  void applySensorData(void);
+
   /// Acquires parameter values from the ros param server and initialises parameter objects. Also sets up dynamic
   /// reconfigure server.
   void initParameters(void);
 
-  /// Acquires gait selection defined parameter values from the ros param server and initialises parameter objects.
+  /// Sets gait parameter objects from the gait parameters preloaded for the gait selection. Gait parameters which have
+  /// not been preloaded are acquired from the ros param server.
   /// @param[in] gait_selection The desired gait used to acquire associated parameters off the parameter server
   void initGaitParameters(const GaitDesignation &gait_selection);
 
+  /// Finds the gait designation associated with a gait type name.
+  /// @param[in] gait_type The gait type name, e.g. "tripod_gait"
+  /// @return The associated gait designation (GAIT_UNDESIGNATED if not a designated gait)
+  GaitDesignation getGaitDesignation(const std::string &gait_type);
+
   /// Acquires auto pose parameter values from the ros param server and initialises parameter objects.
   void initAutoPoseParameters(void);
 
@@ -85,6 +201,31 @@ public:
   /// Coordinates with other controllers to update based on current robot state, also calls for state transitions.
   void loop(void);
 
+  /// Runs a single cycle of the main ros loop: updates the state controller and publishes all outputs if the system
+  /// is operational, then publishes timing diagnostics. Sensor data is expected to have been sampled beforehand.
+  void runControlCycle(void);
+
+  /// Prepares the state controller to be driven from a recorded input log in place of live inputs. Stops servicing
+  /// sensor topics and recording of inputs. Control thread callbacks are only invoked by replayed records provided
+  /// the caller does not spin the global callback queue.
+  /// @param[in] header The header of the input log
+  /// @return Flag denoting if the input log was recorded against a matching model and control loop period
+  bool startReplay(const InputLogHeader &header);
+
+  /// Replays a record of an input log in the order it was consumed by the recorded controller: applies sampled
+  /// sensor data, invokes the callback of an input message, initialises the model or runs a control cycle.
+  /// @param[in] record The header of the record
+  /// @param[in] payload Pointer to the payload of the record
+  /// @return Flag denoting if the record was valid and replayed
+  bool replayInput(const InputRecordHeader &record, const uint8_t* payload);
+
+  /// Calculates the deviation of the current desired joint positions from those of a recorded output record.
+  /// @param[in] record The header of the output record
+  /// @param[in] payload Pointer to the payload of the output record
+  /// @return The maximum absolute deviation of any joint (zero if bitwise identical, infinite if the record is
+  /// invalid or the positions differ in being finite)
+  double calculateOutputDeviation(const InputRecordHeader &record, const uint8_t* payload);
+
   /// Handles transitions of robot state and moves the robot as required for the new state.
   /// The transition from one state to another may require several iterations through this function before ending.
   void transitionRobotState(void);
@@ -94,13 +235,17 @@ public:
   /// Updates the walk/pose controllers tip positions and applies inverse kinematics to the leg objects.
   void runningState(void);
 
-  /// Updates adjustment of parameters.
-  /// @todo Implement smooth "whilst walking" adjustment of step_frequency and body_clearance
+  /// Updates adjustment of parameters. Step frequency adjustments retime the step cycle of each leg in place whilst
+  /// walking, only slowing the robot if the current body velocity exceeds the limits of the new step frequency.
+  /// @todo Implement smooth "whilst walking" adjustment of body_clearance
   void adjustParameter(void);
 
   /// Handles a gait change event. Forces robot velocity input to zero until it is in a STOPPED walk state and then
   /// updates gait parameters based on the new gait selection and reinitialises the walk controller with the new
-  /// parameters. If required the pose controller is reinitialised with new 'auto posing' parameters.
+  /// parameters. If required the pose controller is reinitialised with new 'auto posing' parameters. If gait
+  /// transition cycles are set the gait is instead changed whilst walking, with the step cycle blended and leg phases
+  /// shifted toward the phase offsets of the new gait within the requested number of step cycles. If this transition
+  /// would not maintain support the Syropod is stopped to change gait.
   void changeGait(void);
 
   /// Handles a leg toggle event. Forces robot velocity input to zero until it is in a STOPPED walk state and then
@@ -113,15 +258,34 @@ public:
   void executePlan(void);
 
   /// Iterates through leg objects and either collates joint state information for combined publishing and/or publishes
-  /// the desired joint position on the leg member publisher object.
+  /// the desired joint position on the leg member publisher object. If the output thread is running, the desired joint
+  /// positions are instead appended to the trajectory segment published by the output thread.
   void publishDesiredJointState(void);
 
+  /// Starts the output thread if the output rate parameter is set above the control loop frequency (multi-rate mode).
+  /// Must be called after the model has been initialised with joint positions.
+  /// @return Flag denoting whether the output thread was started
+  bool startOutputThread(void);
+
+  /// Stops the output thread, if running, and waits for it to finish.
+  void stopOutputThread(void);
+
+  /// Loop of the output thread. Publishes desired joint positions, interpolated along the latest trajectory segment
+  /// via cubic Hermite splines, at the output rate until the output thread is stopped. Segments are timed and the loop
+  /// paced on the monotonic clock. Publishing is paused whilst the system is suspended. The thread is set to SCHED_FIFO
+  /// scheduling if an output priority is set.
+  void outputLoop(void);
+
   /// Debugging functions
 
   /// Iterates through leg objects and collates state information for publishing on custom leg state message topic.
   /// @todo Remove ASC state messages in line with requested hardware changes to use legState message variable/s
   void publishLegState(void);
 
+  /// Collates state information of all legs into a single preallocated aggregated leg state message and publishes it
+  /// at the leg states rate. Tip poses are those calculated during the control cycle and a single timestamp is used.
+  void publishLegStates(void);
+
   /// Publishes current desired linear and angular body velocity for debugging.
   void publishVelocity(void);
 
@@ -134,15 +298,37 @@ public:
   /// Publishes imu pose rotation absement, position and velocity errors used in the PID controller, for debugging.
   void publishRotationPoseError(void);
 
-  /// Publishes transforms linking world, base_link and walk_plane frames.
+  /// Publishes timing statistics of the control loop when running in real-time mode: cycle start jitter (current,
+  /// mean and max), compute time (previous and max), deadline overrun count, skipped cycle count and cycle count.
+  /// @param[in] loop The real-time loop object pacing the control loop
+  void publishLoopTiming(RealTimeLoop &loop);
+
+  /// Publishes timing statistics (sample count, min, mean, 99th percentile and max duration) of each timed stage of
+  /// the control cycle as diagnostics once per timing diagnostics period, resetting statistics after each publish.
+  /// Usage of the cycle arena of the model (capacity, peak usage and heap fallbacks) and counts of events recorded to
+  /// the event log of the model are also published.
+  void publishTimingDiagnostics(void);
+
+  /// Publishes transforms linking world, base_link, walk_plane, joint and tip frames in a single batched broadcast
+  /// with a shared timestamp. Availability of an odom transform from perception is probed at a low rate (see
+  /// ODOM_PROBE_PERIOD), with the ideal odometry transform broadcast in its absence.
   void publishFrameTransforms(void);
 
+  /// Generates the preallocated set of frame transforms broadcast each cycle, which includes the ideal odometry
+  /// transform only in the absence of an odom transform from perception and joint transforms only if requested.
+  void generateFrameTransforms(void);
+
   /// Generates transforms for external leg stepper targets based on frame id and time.
   void generateExternalTargetTransforms(void);
 
-  /// Sets up velocities for and calls debug output object to publish various debugging visualations via rviz.
+  /// Captures robot state for the debug visualiser to publish various debugging visualations via rviz.
   void RVIZDebugging(void);
 
+  /// Calculates the time remaining until the end of the next (or current) swing period of a leg.
+  /// @param[in] leg_stepper The leg stepper object of the leg
+  /// @return The time until the end of the next (or current) swing period of the leg
+  double calculateTimeToSwingEnd(std::shared_ptr<LegStepper> leg_stepper);
+
   /// Callback handling the desired system state. Sends message to user interface when system enters OPERATIONAL state.
   /// @param[in] input The Int8 standard message provided by the subscribed ros topic "syropod_remote/system_state"
   /// @see parameters_and_states.h
@@ -244,18 +430,19 @@ public:
   /// @see config/dynamic_parameter.cfg
   void dynamicParameterCallback(syropod_highlevel_controller::DynamicConfig &config, const uint32_t &level);
 
-  /// Callback handling the transformation of IMU data from imu frame to base link frame.
+  /// Callback handling the transformation of IMU data from imu frame to base link frame. Runs on the sensor spinner
+  /// thread and only writes to the latest sensor data slot.
   /// @param[in] data The Imu sensor message provided by the subscribed ros topic "/SYROPOD_TYPE/imu/data"
   void imuCallback(const sensor_msgs::Imu &data);
 
-  /// Callback which handles acquisition of joint states from motor drivers. Attempts to populate joint objects with
-  /// available current position/velocity/effort and flags if all joint objects have received an initial current
-  /// position.
+  /// Callback which handles acquisition of joint states from motor drivers. Runs on the sensor spinner thread and
+  /// writes available current position/velocity/effort of each joint to the latest sensor data slot.
   /// @param[in] joint_states The JointState sensor message provided by the subscribed ros topic "/joint_states"
   void jointStatesCallback(const sensor_msgs::JointState &joint_states);
 
-  /// Callback which handles acquisition of tip states from external sensors. Attempts to populate leg objects with
-  /// available current tip force/torque values and range to walk surface.
+  /// Callback which handles acquisition of tip states from external sensors. Runs on the sensor spinner thread and
+  /// writes available current tip force/torque values and range to walk surface to the latest sensor data slot.
+  /// Measured tip forces are also passed directly to the admittance thread if running.
   /// @param[in] tip_states The TipState sensor message provided by the subscribed ros topic "/tip_states"
   void tipStatesCallback(const syropod_highlevel_controller::TipState &tip_states);
 
@@ -271,6 +458,27 @@ public:
   /// @param[in] msg The target tip pose message
   void targetTipPoseCallback(const syropod_highlevel_controller::TargetTipPose &msg);
 
+  /// Records the input message of a control thread callback to the input log, if recording.
+  /// @param[in] channel The callback processing the message
+  /// @param[in] input The input message
+  template <class M>
+  inline void recordInput(const InputChannel &channel, const M &input)
+  {
+    if (input_recorder_.isRecording())
+    {
+      input_recorder_.recordMessage(cycle_count_, channel, input);
+    }
+  };
+
+  /// Packs sensor data into the record buffer as doubles for a sensor data record (see config/readme.md).
+  /// @param[in] sensor_data The sensor data to be packed
+  void packSensorData(const SensorData &sensor_data);
+
+  /// Unpacks the doubles of a sensor data record into sensor data.
+  /// @param[in] data Pointer to the packed doubles of the sensor data record
+  /// @param[out] sensor_data The unpacked sensor data
+  void unpackSensorData(const double* data, SensorData* sensor_data);
+
 private:
   ros::Subscriber system_state_subscriber_;            ///< Subscriber for topic /syropod_remote/system_state
   ros::Subscriber robot_state_subscriber_;             ///< Subscriber for topic /syropod_remote/robot_state
@@ -302,31 +510,55 @@ private:
   ros::Subscriber joint_state_subscriber_; ///< Subscriber for topic /joint_states
   ros::Subscriber tip_state_subscriber_;   ///< Subscriber for topic /tip_states
 
+  ros::CallbackQueue sensor_callback_queue_;          ///< Callback queue for sensor topic subscriptions
+  std::shared_ptr<ros::AsyncSpinner> sensor_spinner_; ///< Spinner thread servicing the sensor callback queue
+  std::map<std::string, int> sensor_joint_indices_;   ///< Map of joint id names to sensor joint indices
+  std::map<std::string, int> sensor_leg_indices_;     ///< Map of leg id names to leg id numbers
+  std::vector<std::shared_ptr<Joint>> sensor_joints_; ///< Joint objects in order of sensor joint index
+  SensorData sensor_input_;                           ///< Sensor data accumulated by sensor callbacks (spinner only)
+  SensorData sensor_sample_;                          ///< Sensor data sampled at the start of the current cycle
+  LatestValue<SensorData> sensor_data_;               ///< Latest sensor data passed from spinner to control loop
+
+  Eigen::Array<uint, Eigen::Dynamic, 1> applied_wrench_count_;     ///< Number of tip wrenches applied of each leg
+  Eigen::Array<uint, Eigen::Dynamic, 1> applied_step_plane_count_; ///< Number of step planes applied of each leg
+
   ros::Publisher desired_joint_state_publisher_; ///< Publisher for topic /desired_joint_state
   ros::Publisher velocity_publisher_;            ///< Publisher for topic /shc/velocity
   ros::Publisher pose_publisher_;                ///< Publisher for topic /shc/pose
   ros::Publisher walkspace_publisher_;           ///< Publisher for topic /shc/walkspace
   ros::Publisher rotation_pose_error_publisher_; ///< Publisher for topic /shc/rotation_pose_error
+  ros::Publisher loop_timing_publisher_;         ///< Publisher for topic /shc/loop_timing
+  ros::Publisher timing_diagnostics_publisher_;  ///< Publisher for topic /diagnostics
+  ros::Publisher leg_states_publisher_;          ///< Publisher for topic /shc/leg_states
   ros::Publisher plan_step_request_publisher_;   ///< Publisher for topic /shc/plan_step_request
 
+  std::map<int, ros::Publisher> leg_state_publishers_;              ///< Publishers for topics /shc/<leg>/state
+  std::map<int, ros::Publisher> asc_leg_state_publishers_;          ///< Publishers for topics /leg_state_<leg>_bool
+  std::map<std::string, ros::Publisher> joint_position_publishers_; ///< Publishers for topics /<joint>/command
+
   tf2_ros::Buffer transform_buffer_;
   std::shared_ptr<tf2_ros::TransformListener> transform_listener_;
   tf2_ros::TransformBroadcaster transform_broadcaster_;
+  std::vector<geometry_msgs::TransformStamped> frame_transforms_; ///< Preallocated frame transforms broadcast per cycle
+  bool odom_available_ = false;                                   ///< Flags if odom transform exists in tf tree
+  ros::Time odom_probe_time_;                                     ///< Time at which tf tree last probed for odom
 
   boost::recursive_mutex mutex_; ///< Mutex used in setup of dynamic reconfigure server
   dynamic_reconfigure::Server<syropod_highlevel_controller::DynamicConfig>* dynamic_reconfigure_server_;
 
-  std::shared_ptr<Model> model_;                     ///< Pointer to robot model object
-  std::shared_ptr<WalkController> walker_;           ///< Pointer to walk controller object
-  std::shared_ptr<PoseController> poser_;            ///< Pointer to pose controller object
-  std::shared_ptr<AdmittanceController> admittance_; ///< Pointer to admittance controller object
-  DebugVisualiser debug_visualiser_;                 ///< Debug class object used for RVIZ visualization
-  Parameters params_;                                ///< Parameter data structure for storing parameter variables
+  std::shared_ptr<Model> model_;                      ///< Pointer to robot model object
+  std::shared_ptr<WalkController> walker_;            ///< Pointer to walk controller object
+  std::shared_ptr<PoseController> poser_;             ///< Pointer to pose controller object
+  std::shared_ptr<AdmittanceController> admittance_;  ///< Pointer to admittance controller object
+  std::shared_ptr<DebugVisualiser> debug_visualiser_; ///< Pointer to debug visualiser object
+  Parameters params_;                                 ///< Parameter data structure for storing parameter variables
+  ParameterTree parameter_tree_;                      ///< Syropod parameters fetched from the ros parameter server
+  std::map<std::string, GaitParameters> gait_parameters_; ///< Map of preloaded gait parameters for each gait name
 
    bool initialised_ = false; ///< Flags if the state controller has initialised
 
-  SystemState system_state_ = SUSPENDED;     ///< Current state of the entire high-level controller system
-  SystemState new_system_state_ = SUSPENDED; ///< Desired state of the entire high_level controller system
+  std::atomic<SystemState> system_state_{ SUSPENDED }; ///< Current state of the entire high-level controller system
+  SystemState new_system_state_ = SUSPENDED;           ///< Desired state of the entire high_level controller system
 
   RobotState robot_state_ = UNKNOWN;         ///< Current state of the robot
   RobotState new_robot_state_ = UNKNOWN;     ///< Desired state of the robot
@@ -348,7 +580,7 @@ private:
   std::shared_ptr<Leg> secondary_leg_;                        ///< Pointer to leg object of secondary leg selection
 
   int manual_leg_count_ = 0;             ///< Count of legs that are currently in manual manipulation mode
-  double cruise_control_end_time_ = 0.0; ///< End time of cruise control mode used for limiting purposes
+  uint64_t cruise_control_end_cycle_ = 0; ///< End control cycle of cruise control mode used for limiting purposes
 
   bool gait_change_flag_ = false;            ///< Flags that the gait is changing
   bool toggle_primary_leg_state_ = false;    ///< Flags that the primary selected leg state is toggling
@@ -376,6 +608,27 @@ private:
   Pose primary_pose_input_;   ///< Input for the desired pose of primary leg tip 
   Pose secondary_pose_input_; ///< Input for the desired pose of secondary the leg tip
 
+  std::vector<std::string> output_joint_names_;      ///< Names of the joints published by the output thread, in order
+  std::vector<ros::Publisher> output_publishers_;    ///< Individual desired position publishers of the output joints
+  OutputSegment output_segment_;                     ///< Current trajectory segment generated by the control loop
+  LatestValue<OutputSegment> output_segment_input_;  ///< Latest trajectory segment passed to the output thread
+  std::thread output_thread_;                        ///< Thread publishing desired joint positions at the output rate
+  std::atomic<bool> output_thread_running_{ false }; ///< Flags if the output thread is running
+
+  std::array<TimingStatistics, TIMING_STAGE_COUNT> stage_timing_; ///< Timing statistics of each control cycle stage
+  ros::Time timing_diagnostics_time_;                              ///< Time at which timing diagnostics last published
+
+  std::array<AllocationStatistics, TIMING_STAGE_COUNT> stage_allocations_; ///< Heap allocations of each cycle stage
+  AllocationGuardMode allocation_guard_mode_ = ALLOCATION_GUARD_OFF;        ///< Allocation guard action in RUNNING loop
+  int running_cycle_count_ = 0;                                            ///< Count of cycles in RUNNING state
+
+  syropod_highlevel_controller::LegStateArray leg_states_msg_; ///< Preallocated aggregated leg state message
+  ros::Time leg_states_time_;                                  ///< Time at which aggregated leg states last published
+
+  InputRecorder input_recorder_;      ///< Recorder of inputs consumed by the control thread to an input log file
+  std::vector<double> record_buffer_; ///< Buffer reused for packing sensor data and output records
+  uint64_t cycle_count_ = 0;          ///< Count of control cycles run, stamped on records of the input log
+
 public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };
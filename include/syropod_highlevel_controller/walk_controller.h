@@ -13,23 +13,23 @@
 #include "parameters_and_states.h"
 #include "pose.h"
 #include "model.h"
+#include "gait_transition.h"
 
-class DebugVisualiser;
 typedef std::map<int, double> LimitMap;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// Object containing parameters which define the timing of the step cycle.
+/// Object containing the per-leg timing of the current swing and stance periods. Generated from the step cycle when the
+/// step state of a leg changes (or the step cycle itself changes) rather than every iteration.
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-struct StepCycle
+struct StepTimetable
 {
-  double frequency_;  ///< The frequency of the step cycle in Hz
-  int period_;        ///< The length of the entire step cycle in iterations
-  int swing_period_;  ///< The length of the swing period of the step cycle in iterations
-  int stance_period_; ///< The length of the stance period of the step cycle in iterations
-  int stance_end_;    ///< The iteration at which the stance period ends
-  int swing_start_;   ///< The iteration at which the swing period starts
-  int swing_end_;     ///< The iteration at which the swing period ends
-  int stance_start_;  ///< The iteration at which the stance period starts
+  int modified_stance_start_ = 0;  ///< The iteration at which the (possibly shortened) stance period starts
+  int modified_stance_period_ = 0; ///< The length of the (possibly shortened) stance period in iterations
+  int swing_iterations_ = 0;       ///< The number of iterations in the entire swing period (always even)
+  int stance_iterations_ = 0;      ///< The number of iterations in the modified stance period
+  double swing_delta_t_ = 0.0;     ///< The bezier time input delta for each iteration of EACH swing bezier curve
+  double stance_delta_t_ = 0.0;    ///< The bezier time input delta for each iteration of the stance bezier curve
+  double stride_scaler_ = 1.0;     ///< Ratio of modified stance period to standard stance period
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,7 +40,7 @@ struct ExternalTarget
   Pose pose_;              ///< The target tip pose
   double swing_clearance_; ///< The height of the swing trajectory clearance normal to walk plane
   std::string frame_id_;   ///< The target tip pose reference frame id
-  ros::Time time_;         ///< The ros time of the request for the target tip pose
+  double time_ = 0.0;      ///< The time of the request for the target tip pose (seconds)
   Pose transform_;         ///< The transform between reference frames at time of request and current time
   bool defined_ = false;   ///< Flag denoting if external target object has been defined
 };
@@ -65,7 +65,7 @@ public:
 
   /// Accessor for step timing object.
   /// @return Step cycle timing object
-  inline StepCycle getStepCycle(void) { return step_; };
+  inline const StepCycle& getStepCycle(void) { return step_; };
 
   /// Accessor for ros cycle time period.
   /// @return ROS cycle time period
@@ -95,9 +95,13 @@ public:
   /// @return Walk cycle state
   inline WalkState getWalkState(void) { return walk_state_; };
 
+  /// Returns true if a planned transition to a new gait is in progress.
+  /// @return Flag denoting if a planned transition to a new gait is in progress
+  inline bool isTransitioningGait(void) { return gait_transition_iteration_ < gait_transition_.getIterationCount(); };
+
   /// Accessor for walkspace.
   /// @return Walkspace
-  inline LimitMap getWalkspace(void) { return walkspace_; };
+  inline const LimitMap& getWalkspace(void) { return walkspace_; };
 
   /// Accessor for walk plane estimate.
   /// @return Walk plane estimate
@@ -115,6 +119,10 @@ public:
   /// @return Model current pose
   inline Pose getModelCurrentPose(void) { return model_->getCurrentPose(); };
 
+  /// Accessor for the event log of the robot model, to which events of the walk controller are recorded.
+  /// @return Pointer to the event log of the robot model
+  inline EventLog* getEventLog(void) { return model_->getEventLog(); };
+
   /// Modifier for posing state.
   /// @param[in] state The new posing state
   inline void setPoseState(const PosingState &state) { pose_state_ = state; };
@@ -185,6 +193,35 @@ public:
   /// @return Generated step cycle object
   StepCycle generateStepCycle(const bool set_step_cycle = true);
 
+  /// Calculates the phase offset of a leg for the given step cycle from the phase offset parameters of the gait.
+  /// @param[in] step Step cycle timing object
+  /// @param[in] leg_id The id number of the leg
+  /// @return The phase offset of the leg
+  int generatePhaseOffset(const StepCycle &step, const int &leg_id);
+
+  /// Plans and starts a transition to the step cycle and phase offsets of a newly selected gait whilst walking. The
+  /// stance and swing periods are blended over the requested number of step cycles whilst the phase of each leg is
+  /// held during stance to shift it toward its new phase offset. Body velocity is scaled down to accomodate the
+  /// resulting extension of stance periods. The transition is refused if it cannot be completed within the requested
+  /// number of step cycles without adjacent legs swinging simultaneously (see GaitTransition).
+  /// @param[in] transition_cycles The number of step cycles within which the gait transition must complete
+  /// @return Flag denoting if the gait transition was started
+  bool generateGaitTransition(const int &transition_cycles);
+
+  /// Calculates the stability margin of the support polygon formed by the tips of legs currently in stance, defined as
+  /// the minimum distance from the body origin (assumed centre of gravity) to the polygon edges on the walk plane.
+  /// @param[in] lifting_leg An optional leg to exclude from the support polygon (i.e. a leg about to lift off)
+  /// @return The stability margin (negative if outside the polygon or if fewer than three legs are in stance)
+  double calculateStabilityMargin(std::shared_ptr<Leg> lifting_leg = NULL);
+
+  /// Determines lift off of a leg in stance from its remaining reach and the stability of the remaining support
+  /// polygon (free gait). The leg is lifted off early by advancing its phase to the end of stance once its remaining
+  /// reach falls below the reach margin, provided the stability margin is maintained, otherwise its stance period is
+  /// extended by holding phase at the end of stance.
+  /// @param[in] leg_stepper The leg stepper object of the leg for which to determine lift off
+  /// @return Flag denoting if the step phase of the leg should be iterated this iteration
+  bool updateFreeGait(std::shared_ptr<LegStepper> leg_stepper);
+
   /// Given an input linear velocity vector and angular velocity, this function calculates a stride bearing then
   /// an interpolation of the two limits at the bearings (defined by the input limit map) bounding the stride bearing.
   /// This is calculated for each leg and the minimum value returned.
@@ -266,6 +303,10 @@ private:
   int legs_at_correct_phase_ = 0;            ///< A count of legs currently at the correct phase per walk cycle state
   int legs_completed_first_step_ = 0;        ///< A count of legs whcih have currently completed their first step
   bool return_to_default_attempted_ = false; ///< Flags whether a leg has already attempted to return to default
+  double transition_velocity_scaler_ = 1.0;  ///< Scales body velocity whilst legs hold phase during gait transition
+  int free_gait_stalled_legs_ = 0;           ///< A count of legs out of reach but unable to lift off in free gait
+  GaitTransition gait_transition_;           ///< The planned transition to a new gait whilst walking
+  int gait_transition_iteration_ = 0;        ///< The current iteration of the planned gait transition
 
   // Iteration variables
   LegContainer::iterator leg_it_;     ///< Leg iteration member variable used to minimise code
@@ -340,6 +381,10 @@ public:
   /// @return Current phase offset of the step cycle
   inline int getPhaseOffset(void) { return phase_offset_; };
 
+  /// Accessor for the timing of the current swing and stance periods of this leg.
+  /// @return Timing of the current swing and stance periods of this leg
+  inline const StepTimetable& getTimetable(void) { return timetable_; };
+
   /// Accessor for the current stride vector used in the step cycle.
   /// @return Current stride vector used in the step cycle
   inline Eigen::Vector3d getStrideVector(void) { return stride_vector_; };
@@ -400,9 +445,16 @@ public:
   /// @param[in] tip_pose The new default tip pose
   inline void setDefaultTipPose(const Pose &tip_pose) { default_tip_pose_ = tip_pose; };
 
-  /// Modifier for the current state of step cycle.
+  /// Modifier for the current state of step cycle. Regenerates the step timetable if the state has changed.
   /// @param[in] step_state The new state of the step cycle
-  inline void setStepState(const StepState &step_state) { step_state_ = step_state; };
+  inline void setStepState(const StepState &step_state)
+  {
+    if (step_state != step_state_)
+    {
+      step_state_ = step_state;
+      updateTimetable();
+    }
+  };
 
   /// Modifier for the phase of the step cycle.
   /// @param[in] phase The new phase
@@ -418,11 +470,19 @@ public:
 
   /// Modifier for the phase offset of the step cycle.
   /// @param[in] phase_offset The new phase offset
-  inline void setPhaseOffset(const int &phase_offset) { phase_offset_ = phase_offset; };
+  inline void setPhaseOffset(const int &phase_offset)
+  {
+    phase_offset_ = phase_offset;
+    updateTimetable();
+  };
 
   /// Modifier for the flag denoting if the leg has completed its first step.
   /// @param[in] completed_first_step The new value for the flag
-  inline void setCompletedFirstStep(const bool &completed_first_step) { completed_first_step_ = completed_first_step; };
+  inline void setCompletedFirstStep(const bool &completed_first_step)
+  {
+    completed_first_step_ = completed_first_step;
+    updateTimetable();
+  };
 
   /// Modifier for the flag denoting if the leg in in the correct phase.
   /// @param[in] at_correct_phase The new value for the flag
@@ -440,19 +500,32 @@ public:
   /// @param[in] external_default The new externally set default tip pose object
   inline void setExternalDefault(const ExternalTarget &external_default) { external_default_ = external_default; };
 
-  /// Updates phase for new step cycle parameters.
+  /// Updates phase for new step cycle parameters. Progress through the current swing or stance period is maintained so
+  /// that changes to the ratio of swing and stance periods (i.e. gait changes whilst walking) are continuous.
   void updatePhase(void);
 
   /// Iterates the step phase and updates the progress variables.
   void iteratePhase(void);
 
+  /// Updates the step state and the progress variables for the current phase.
+  void updateProgress(void);
+
   /// Updates the Step state of this LegStepper according to the phase.
   void updateStepState(void);
 
+  /// Generates the timing of the swing and stance periods of this leg from the step cycle, phase offset and step state.
+  /// Called on step state transitions and step cycle changes so that tip trajectory updates need not recalculate it.
+  void updateTimetable(void);
+
   /// Updates the stride vector for this leg based on desired linear and angular velocity, with reference to the
   /// estimated walk plane. Also updates the swing clearance vector with reference to the estimated walk plane.
   void updateStride(void);
 
+  /// Calculates the remaining reach of the tip along the direction of stance motion (opposite the stride vector) before
+  /// it exits the walkspace, as a ratio of the walkspace radius in that direction.
+  /// @return The ratio of walkspace radius remaining along the direction of stance motion
+  double calculateRemainingReach(void);
+
   /// Calculates the lateral change in distance from identity tip position to new default tip position for a leg.
   /// @return The change from identity tip position to the new default tip position
   Eigen::Vector3d calculateStanceSpanChange(void);
@@ -494,8 +567,8 @@ private:
   bool completed_first_step_ = false; ///< Flag denoting if the leg has completed its first step
   bool touchdown_detection_ = false;  ///< Flag denoting whether touchdown detection is enabled
 
-  int phase_ = 0;    ///< Step cycle phase
-  int phase_offset_; ///< Step cycle phase offset
+  int phase_ = 0;        ///< Step cycle phase
+  int phase_offset_ = 0; ///< Step cycle phase offset
 
   double step_progress_ = 0.0;    ///< The progress of the entire step cycle (0.0->1.0 || -1.0)
   double swing_progress_ = -1.0;  ///< The progress of the swing period in the step cycle. (0.0->1.0 || -1.0)
@@ -512,8 +585,7 @@ private:
   Eigen::Vector3d stride_vector_;     ///< The desired stride vector
   Eigen::Vector3d swing_clearance_;   ///< Position relative to the default tip position to achieve during swing period
 
-  double swing_delta_t_ = 0.0;
-  double stance_delta_t_ = 0.0;
+  StepTimetable timetable_; ///< Timing of the current swing and stance periods of this leg
 
   Pose identity_tip_pose_; ///< The user defined tip pose assuming a identity walk plane
   Pose default_tip_pose_;  ///< The default tip pose per the walk controller, updated with walk plane
@@ -15,52 +15,215 @@ AdmittanceController::AdmittanceController(std::shared_ptr<Model> model, const P
   : model_(model)
   , params_(params)
 {
+  int leg_count = model_->getLegCount();
+  discretisations_.resize(leg_count);
+  characteristics_.stiffness_ = Eigen::ArrayXd::Zero(leg_count);
+  applied_admittance_delta_ = AdmittanceArray3Xd::Zero(3, leg_count);
+  state_transition_ = AdmittanceArray4Xd::Zero(4, leg_count);
+  input_response_ = AdmittanceArray2Xd::Zero(2, leg_count);
+  admittance_state_ = AdmittanceArray2Xd::Zero(2, leg_count);
+  tip_force_ = AdmittanceArray3Xd::Zero(3, leg_count);
+  force_input_ = AdmittanceArray3Xd::Zero(3, leg_count);
+  admittance_delta_ = AdmittanceArray3Xd::Zero(3, leg_count);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AdmittanceController::~AdmittanceController(void)
+{
+  stopAdmittanceThread();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void AdmittanceController::updateAdmittance(void)
 {
-  // Get current force value on leg and run admittance calculations to get a vertical tip offset (deltaZ)
-  LegContainer::iterator leg_it;
-  for (leg_it = model_->getLegContainer()->begin(); leg_it != model_->getLegContainer()->end(); ++leg_it)
+  updateCharacteristics();
+  bool use_calculated_tip_force = params_.use_joint_effort.data;
+  int leg_count = model_->getLegCount();
+
+  // Pass characteristics and calculated tip forces to admittance thread and apply latest offsets generated by thread
+  if (admittance_thread_running_)
   {
-    std::shared_ptr<Leg> leg = leg_it->second;
-    Eigen::Vector3d admittance_delta = Eigen::Vector3d::Zero();
-    bool use_calculated_tip_force = params_.use_joint_effort.data;
-    Eigen::Vector3d tip_force = use_calculated_tip_force ? leg->getTipForceCalculated() : leg->getTipForceMeasured();
-    tip_force *= params_.force_gain.current_value;
-    for (int i = 0; i < 3; ++i)
+    characteristics_input_.write(characteristics_);
+    for (int l = 0; l < leg_count && use_calculated_tip_force; ++l)
     {
-      double force_input = std::max(tip_force[i], 0.0); // Use vertical component of tip force vector //TODO
-      double damping = params_.virtual_damping_ratio.current_value;
-      double stiffness = params_.virtual_stiffness.current_value;
-      double mass = params_.virtual_mass.current_value;
-      double step_time = params_.integrator_step_time.data;
-      state_type* admittance_state = leg->getAdmittanceState();
-      double virtual_damping = damping * 2 * sqrt(mass * stiffness);
-      boost::numeric::odeint::runge_kutta4<state_type> stepper;
-      integrate_const(stepper,
-                      [&](const state_type & x, state_type & dxdt, double t)
-                      {
-                        dxdt[0] = x[1];
-                        dxdt[1] = -force_input / mass - virtual_damping / mass * x[1] - stiffness / mass * x[0];
-                      }, 
-                      *admittance_state,
-                      0.0,
-                      step_time,
-                      step_time / 30);
-      
-      // Deadbanding
-      double delta = clamped(-(*admittance_state)[0], -0.2, 0.2);
-      double delta_direction = delta / abs(delta);
-      if (abs(delta) > ADMITTANCE_DEADBAND)
-      {
-        admittance_delta[i] = delta_direction * (abs(delta) - ADMITTANCE_DEADBAND) / (1 - ADMITTANCE_DEADBAND);
-      }
+      pushTipForce(l, model_->getLegByIDNumber(l)->getTipForceCalculated());
     }
-    leg->setAdmittanceDelta(admittance_delta);
+    admittance_delta_output_.read(&applied_admittance_delta_);
   }
+  // Get current force value on each leg and run admittance calculations to get vertical tip offsets (deltaZ)
+  else
+  {
+    for (int l = 0; l < leg_count; ++l)
+    {
+      std::shared_ptr<Leg> leg = model_->getLegByIDNumber(l);
+      Eigen::Vector3d tip_force = use_calculated_tip_force ? leg->getTipForceCalculated() : leg->getTipForceMeasured();
+      tip_force_.col(l) = tip_force.array();
+    }
+    integrateAdmittance(characteristics_);
+    applied_admittance_delta_ = admittance_delta_;
+  }
+
+  for (int l = 0; l < leg_count; ++l)
+  {
+    model_->getLegByIDNumber(l)->setAdmittanceDelta(applied_admittance_delta_.col(l).matrix());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AdmittanceController::startAdmittanceThread(void)
+{
+  if (admittance_thread_running_ || params_.admittance_rate.data <= 0.0)
+  {
+    return false;
+  }
+
+  admittance_thread_running_ = true;
+  updateCharacteristics();
+  characteristics_input_.reset(characteristics_);
+  admittance_delta_output_.reset(admittance_delta_);
+  admittance_thread_ = std::thread(&AdmittanceController::admittanceLoop, this);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdmittanceController::stopAdmittanceThread(void)
+{
+  admittance_thread_running_ = false;
+  if (admittance_thread_.joinable())
+  {
+    admittance_thread_.join();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AdmittanceController::pushTipForce(const int &leg_id_number, const Eigen::Vector3d &tip_force)
+{
+  if (!admittance_thread_running_)
+  {
+    return false;
+  }
+
+  TipForceSample sample;
+  sample.leg_id_number_ = leg_id_number;
+  sample.tip_force_ = tip_force;
+  bool pushed = tip_force_queue_.push(sample);
+  SHC_WARN_COND(!pushed, "\n[SHC] Admittance thread tip force queue is full, tip force sample dropped.\n");
+  return pushed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdmittanceController::updateCharacteristics(void)
+{
+  characteristics_.mass_ = params_.virtual_mass.current_value;
+  characteristics_.damping_ratio_ = params_.virtual_damping_ratio.current_value;
+  characteristics_.force_gain_ = params_.force_gain.current_value;
+
+  // Integrator step time is defined per control cycle and is scaled to maintain dynamics at the admittance rate
+  characteristics_.step_time_ = params_.integrator_step_time.data;
+  if (admittance_thread_running_)
+  {
+    characteristics_.step_time_ /= (params_.time_delta.data * params_.admittance_rate.data);
+  }
+
+  bool dynamic_stiffness = params_.dynamic_stiffness.data;
+  for (int l = 0; l < model_->getLegCount(); ++l)
+  {
+    std::shared_ptr<Leg> leg = model_->getLegByIDNumber(l);
+    characteristics_.stiffness_[l] =
+        dynamic_stiffness ? leg->getVirtualStiffness() : params_.virtual_stiffness.current_value;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdmittanceController::integrateAdmittance(const AdmittanceCharacteristics &characteristics)
+{
+  // Regenerate discretisation of each leg if system characteristics have changed
+  for (uint l = 0; l < discretisations_.size(); ++l)
+  {
+    AdmittanceDiscretisation &discretisation = discretisations_[l];
+    if (updateDiscretisation(characteristics.mass_, characteristics.stiffness_[l], characteristics.damping_ratio_,
+                             characteristics.step_time_, &discretisation))
+    {
+      state_transition_.col(l) << discretisation.state_transition_(0, 0), discretisation.state_transition_(0, 1),
+                                  discretisation.state_transition_(1, 0), discretisation.state_transition_(1, 1);
+      input_response_.col(l) = discretisation.input_response_.array();
+    }
+  }
+  force_input_ = (tip_force_ * characteristics.force_gain_).max(0.0); // Use vertical component of tip force //TODO
+
+  // Run admittance calculations for all legs to get tip offsets (deltaZ)
+  for (int i = 0; i < 3; ++i)
+  {
+    Eigen::Array<double, 1, Eigen::Dynamic> position = admittance_state_.row(0);
+    Eigen::Array<double, 1, Eigen::Dynamic> velocity = admittance_state_.row(1);
+    admittance_state_.row(0) = state_transition_.row(0) * position + state_transition_.row(1) * velocity +
+                               input_response_.row(0) * force_input_.row(i);
+    admittance_state_.row(1) = state_transition_.row(2) * position + state_transition_.row(3) * velocity +
+                               input_response_.row(1) * force_input_.row(i);
+
+    // Clamping and deadbanding
+    Eigen::Array<double, 1, Eigen::Dynamic> delta = (-admittance_state_.row(0)).max(-0.2).min(0.2);
+    admittance_delta_.row(i) = delta.sign() * (delta.abs() - ADMITTANCE_DEADBAND).max(0.0) / (1 - ADMITTANCE_DEADBAND);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void AdmittanceController::admittanceLoop(void)
+{
+  RealTimeLoop loop(1.0 / params_.admittance_rate.data);
+  AdmittanceCharacteristics characteristics;
+  TipForceSample sample;
+  while (admittance_thread_running_ && getCoreInterface()->ok())
+  {
+    characteristics_input_.read(&characteristics);
+    while (tip_force_queue_.pop(sample))
+    {
+      tip_force_.col(sample.leg_id_number_) = sample.tip_force_.array();
+    }
+    integrateAdmittance(characteristics);
+    admittance_delta_output_.write(admittance_delta_);
+    loop.sleep();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool AdmittanceController::updateDiscretisation(const double &mass, const double &stiffness,
+                                                const double &damping_ratio, const double &step_time,
+                                                AdmittanceDiscretisation *discretisation)
+{
+  if (discretisation->mass_ == mass && discretisation->stiffness_ == stiffness &&
+      discretisation->damping_ratio_ == damping_ratio && discretisation->step_time_ == step_time)
+  {
+    return false;
+  }
+  SHC_ASSERT(mass > 0.0 && stiffness >= 0.0);
+
+  // Augmented system matrix [A B; 0 0] for state [position, velocity] and force input
+  double virtual_damping = damping_ratio * 2 * sqrt(mass * stiffness);
+  Eigen::Matrix3d augmented_system = Eigen::Matrix3d::Zero();
+  augmented_system(0, 1) = 1.0;
+  augmented_system(1, 0) = -stiffness / mass;
+  augmented_system(1, 1) = -virtual_damping / mass;
+  augmented_system(1, 2) = -1.0 / mass;
+
+  // Exponential of augmented system over step time yields state transition and (zero-order hold) input response
+  Eigen::Matrix3d augmented_exponential = (augmented_system * step_time).exp();
+  discretisation->state_transition_ = augmented_exponential.block<2, 2>(0, 0);
+  discretisation->input_response_ = augmented_exponential.block<2, 1>(0, 2);
+  discretisation->mass_ = mass;
+  discretisation->stiffness_ = stiffness;
+  discretisation->damping_ratio_ = damping_ratio;
+  discretisation->step_time_ = step_time;
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
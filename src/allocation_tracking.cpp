@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/allocation_tracking.h"
+
+#ifdef SHC_TRACK_ALLOCATIONS
+
+#include <errno.h>
+#include <execinfo.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Allocation tracking interposes the malloc family of the C library rather than only replacing the global operator
+// new/delete: operator new allocates through malloc, whereas Eigen allocates dynamic matrices directly through malloc.
+// All functions forward to the glibc implementations. Thread-local state uses the initial-exec model such that
+// accessing it never allocates, which requires this file to be linked into the executable.
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* pointer);
+}
+
+#define TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+
+/// Running count of heap allocations made by this thread
+static thread_local AllocationCounts thread_counts TLS_INITIAL_EXEC;
+
+/// Action of the allocation guard of this thread upon a heap allocation
+static thread_local AllocationGuardMode thread_guard_mode TLS_INITIAL_EXEC = ALLOCATION_GUARD_OFF;
+
+/// Flags if the allocation guard of this thread has logged an allocation since it was last reset
+static thread_local bool thread_guard_latched TLS_INITIAL_EXEC = false;
+
+/// Flags if the allocation guard of this thread is handling an allocation
+static thread_local bool thread_in_guard TLS_INITIAL_EXEC = false;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Counts a heap allocation made by the calling thread and applies its allocation guard if armed. Allocations made
+/// whilst the guard is handling an allocation (e.g. by the first call to backtrace()) are counted but not guarded, as
+/// are allocations made whilst the guard is latched after logging (which are counted as violations only).
+/// @param[in] size The number of bytes requested by the allocation
+static inline void trackAllocation(const size_t &size)
+{
+  thread_counts.allocations_++;
+  thread_counts.bytes_ += size;
+  if (thread_guard_mode == ALLOCATION_GUARD_OFF || thread_in_guard)
+  {
+    return;
+  }
+  thread_counts.guard_violations_++;
+  if (thread_guard_latched)
+  {
+    return;
+  }
+
+  // Log backtrace to stderr without allocating
+  thread_in_guard = true;
+  const char message[] = "\n[SHC] Heap allocation in guarded section of control loop. Backtrace:\n";
+  ssize_t result = write(STDERR_FILENO, message, sizeof(message) - 1);
+  (void)result;
+  void* frames[ALLOCATION_BACKTRACE_DEPTH];
+  int frame_count = backtrace(frames, ALLOCATION_BACKTRACE_DEPTH);
+  backtrace_symbols_fd(frames, frame_count, STDERR_FILENO);
+  thread_in_guard = false;
+
+  if (thread_guard_mode == ALLOCATION_GUARD_ABORT)
+  {
+    abort();
+  }
+  thread_guard_latched = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+extern "C"
+{
+void* malloc(size_t size) noexcept
+{
+  trackAllocation(size);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept
+{
+  trackAllocation(count * size);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size) noexcept
+{
+  trackAllocation(size);
+  return __libc_realloc(pointer, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+  trackAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+  trackAllocation(size);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+{
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+  {
+    return EINVAL;
+  }
+  trackAllocation(size);
+  *pointer = __libc_memalign(alignment, size);
+  return (*pointer == NULL && size != 0) ? ENOMEM : 0;
+}
+
+void free(void* pointer) noexcept
+{
+  if (pointer != NULL)
+  {
+    thread_counts.deallocations_++;
+  }
+  __libc_free(pointer);
+}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool allocationTrackingEnabled(void)
+{
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AllocationCounts getThreadAllocationCounts(void)
+{
+  return thread_counts;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void armAllocationGuard(const AllocationGuardMode &mode)
+{
+  thread_guard_mode = mode;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void disarmAllocationGuard(void)
+{
+  thread_guard_mode = ALLOCATION_GUARD_OFF;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void resetAllocationGuard(void)
+{
+  thread_guard_latched = false;
+}
+
+#else // SHC_TRACK_ALLOCATIONS
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool allocationTrackingEnabled(void)
+{
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AllocationCounts getThreadAllocationCounts(void)
+{
+  return AllocationCounts();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void armAllocationGuard(const AllocationGuardMode &)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void disarmAllocationGuard(void)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void resetAllocationGuard(void)
+{
+}
+
+#endif // SHC_TRACK_ALLOCATIONS
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+AllocationGuardMode allocationGuardModeFromName(const std::string &name)
+{
+  if (name == "log")
+  {
+    return ALLOCATION_GUARD_LOG;
+  }
+  else if (name == "abort")
+  {
+    return ALLOCATION_GUARD_ABORT;
+  }
+  return ALLOCATION_GUARD_OFF;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/core_interface.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+/// Names of each log level as prefixed to messages logged by the default interface
+static const char* const LOG_LEVEL_NAMES[LOG_LEVEL_COUNT] = { "DEBUG", "INFO", "WARN", "ERROR", "FATAL" };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Accessor for the storage of the interface set by the host, initialised with the default interface.
+/// @return Reference to the pointer to the interface
+static std::shared_ptr<CoreInterface>& coreInterfaceInstance(void)
+{
+  static std::shared_ptr<CoreInterface> core_interface = std::make_shared<CoreInterface>();
+  return core_interface;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CoreInterface::getParameter(const std::string &, XmlRpc::XmlRpcValue*)
+{
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CoreInterface::isLogEnabled(const LogLevel &level)
+{
+  return level != DEBUG_LOG_LEVEL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CoreInterface::log(const LogLevel &level, const char* file, const int &line, const char*, const char* message)
+{
+  fprintf(stderr, "[%s] [%s:%d] %s\n", LOG_LEVEL_NAMES[level], file, line, message);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double CoreInterface::now(void)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool CoreInterface::ok(void)
+{
+  return !shutdown_requested_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CoreInterface::shutdown(void)
+{
+  shutdown_requested_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void setCoreInterface(std::shared_ptr<CoreInterface> core_interface)
+{
+  coreInterfaceInstance() = core_interface;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CoreInterface* getCoreInterface(void)
+{
+  return coreInterfaceInstance().get();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void logMessage(const LogLevel &level, const char* file, const int &line, const char* function,
+                const char* format, ...)
+{
+  char message[LOG_MESSAGE_SIZE];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+  getCoreInterface()->log(level, file, line, function, message);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
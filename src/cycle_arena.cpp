@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/cycle_arena.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CycleArena::CycleArena(const size_t &capacity)
+{
+  capacity_ = capacity;
+  buffer_ = static_cast<char*>(::operator new(capacity_, std::align_val_t(CYCLE_ARENA_ALIGNMENT)));
+  overflow_blocks_.reserve(CYCLE_ARENA_OVERFLOW_RESERVE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+CycleArena::~CycleArena(void)
+{
+  freeOverflow(0);
+  ::operator delete(buffer_, std::align_val_t(CYCLE_ARENA_ALIGNMENT));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void* CycleArena::allocateOverflow(const size_t &size, const size_t &alignment)
+{
+  OverflowBlock block;
+  block.pointer_ = ::operator new(size, std::align_val_t(alignment));
+  block.size_ = size;
+  block.alignment_ = alignment;
+  overflow_blocks_.push_back(block);
+  overflow_bytes_ += size + alignment;
+  overflow_count_++;
+  overflowed_ = true;
+  return block.pointer_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CycleArena::freeOverflow(const size_t &overflow_count)
+{
+  while (overflow_blocks_.size() > overflow_count)
+  {
+    const OverflowBlock &block = overflow_blocks_.back();
+    ::operator delete(block.pointer_, std::align_val_t(block.alignment_));
+    overflow_bytes_ -= block.size_ + block.alignment_;
+    overflow_blocks_.pop_back();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CycleArena::rewind(const CycleArenaMarker &marker)
+{
+  cycle_peak_used_ = std::max(cycle_peak_used_, getUsed());
+  freeOverflow(marker.overflow_count_);
+  offset_ = std::min(offset_, marker.offset_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void CycleArena::reset(void)
+{
+  size_t used = std::max(cycle_peak_used_, getUsed());
+  peak_used_ = std::max(peak_used_, used);
+  freeOverflow(0);
+
+  // Grow region to fit peak usage (with headroom) such that subsequent cycles are served without heap fallback
+  if (overflowed_)
+  {
+    SHC_DEBUG("\nCycle arena capacity (%lu bytes) exceeded by cycle allocations (%lu bytes). Growing capacity.\n",
+              capacity_, used);
+    ::operator delete(buffer_, std::align_val_t(CYCLE_ARENA_ALIGNMENT));
+    capacity_ = std::max(2 * capacity_, 2 * used);
+    buffer_ = static_cast<char*>(::operator new(capacity_, std::align_val_t(CYCLE_ARENA_ALIGNMENT)));
+  }
+  offset_ = 0;
+  overflowed_ = false;
+  cycle_peak_used_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/cycle_timing.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TimingStatistics::addSample(const double &duration)
+{
+  int bucket = 0;
+  if (duration > TIMING_MIN_DURATION)
+  {
+    bucket = static_cast<int>(std::ceil(std::log2(duration / TIMING_MIN_DURATION) * TIMING_BUCKETS_PER_OCTAVE));
+    bucket = clamped(bucket, 0, TIMING_BUCKET_COUNT - 1);
+  }
+  histogram_[bucket]++;
+  sample_count_++;
+  min_ = std::min(min_, duration);
+  max_ = std::max(max_, duration);
+  sum_ += duration;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double TimingStatistics::getPercentile(const double &percentile)
+{
+  int threshold = static_cast<int>(std::ceil(clamped(percentile, 0.0, 1.0) * sample_count_));
+  int count = 0;
+  for (int bucket = 0; bucket < TIMING_BUCKET_COUNT; ++bucket)
+  {
+    count += histogram_[bucket];
+    if (count >= threshold && count > 0)
+    {
+      double upper_bound = TIMING_MIN_DURATION * std::pow(2.0, static_cast<double>(bucket) / TIMING_BUCKETS_PER_OCTAVE);
+      return std::min(upper_bound, max_);
+    }
+  }
+  return max_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void TimingStatistics::reset(void)
+{
+  histogram_.fill(0);
+  sample_count_ = 0;
+  min_ = std::numeric_limits<double>::max();
+  max_ = 0.0;
+  sum_ = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
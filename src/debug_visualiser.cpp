@@ -14,32 +14,401 @@
 DebugVisualiser::DebugVisualiser(void)
 {
   ros::NodeHandle n;
-  robot_model_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/robot_model", 1000);
-  tip_trajectory_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/tip_trajectories", 1000);
-  bezier_curve_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/bezier_curves", 1000);
-  default_tip_position_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/default_tip_positions", 1000);
-  target_tip_position_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/target_tip_positions", 1000);
-  walkspace_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/walkspace", 1000);
-  workspace_publisher_ = n.advertise<visualization_msgs::MarkerArray>("/shc/debug/workspace", 1000);
-  walk_plane_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/walk_plane", 1000);
-  stride_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/stride", 1000);
-  tip_force_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/tip_force", 1000);
-  joint_torque_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/joint_torque", 1000);
+  for (int i = 0; i < DEBUG_STREAM_COUNT; ++i)
+  {
+    std::string topic_name = "/shc/debug/" + std::string(DEBUG_STREAM_NAMES[i]);
+    if (i == WORKSPACE_STREAM)
+    {
+      publishers_[i] = n.advertise<visualization_msgs::MarkerArray>(topic_name, 1000);
+    }
+    else
+    {
+      publishers_[i] = n.advertise<visualization_msgs::Marker>(topic_name, 1000);
+    }
+  }
   tip_rotation_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/tip_rotation", 1000);
-  gravity_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/gravity", 1000);
-  terrain_publisher_ = n.advertise<visualization_msgs::Marker>("/shc/debug/terrain", 1000);
+  stream_decimation_.fill(1);
+  stream_countdown_.fill(0);
+  published_subscriber_count_.fill(0);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
+DebugVisualiser::~DebugVisualiser(void)
 {
-  // Estimate of robot body length used in scaling markers
-  if (marker_scale_ == 0)
+  stopVisualisationThread();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::setStreamRates(const std::map<std::string, double> &stream_rates)
+{
+  ROS_ASSERT(time_delta_ > 0.0);
+  for (int i = 0; i < DEBUG_STREAM_COUNT; ++i)
   {
-    marker_scale_ = model->getLegByIDNumber(0)->getJointByIDNumber(1)->getPoseRobotFrame().position_.norm() * 2.0;
+    std::map<std::string, double>::const_iterator rate_it = stream_rates.find(DEBUG_STREAM_NAMES[i]);
+    if (rate_it == stream_rates.end())
+    {
+      stream_decimation_[i] = 1;
+    }
+    else if (rate_it->second <= 0.0)
+    {
+      stream_decimation_[i] = 0;
+    }
+    else
+    {
+      stream_decimation_[i] = std::max(1, static_cast<int>(roundToInt(1.0 / (rate_it->second * time_delta_))));
+    }
   }
-  
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool DebugVisualiser::startVisualisationThread(void)
+{
+  if (visualisation_thread_running_ || time_delta_ <= 0.0)
+  {
+    return false;
+  }
+
+  // Preallocate snapshots such that capture on the control thread does not allocate once sized
+  captured_state_.due_.fill(false);
+  state_output_.reset(captured_state_);
+  visualisation_thread_running_ = true;
+  visualisation_thread_ = std::thread(&DebugVisualiser::visualisationLoop, this);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::stopVisualisationThread(void)
+{
+  visualisation_thread_running_ = false;
+  if (visualisation_thread_.joinable())
+  {
+    visualisation_thread_.join();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool DebugVisualiser::isStreamDue(const DebugStream &stream)
+{
+  if (stream_decimation_[stream] == 0 || --stream_countdown_[stream] > 0)
+  {
+    return false;
+  }
+  stream_countdown_[stream] = stream_decimation_[stream];
+  return publishers_[stream].getNumSubscribers() > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::captureState(std::shared_ptr<Model> model, std::shared_ptr<WalkController> walker,
+                                   const bool &running, const bool &tip_force)
+{
+  if (!visualisation_thread_running_)
+  {
+    return;
+  }
+
+  // Determine which streams are due this cycle, skipping capture entirely if none are due
+  bool any_due = false;
+  for (int i = 0; i < DEBUG_STREAM_COUNT; ++i)
+  {
+    DebugStream stream = static_cast<DebugStream>(i);
+    bool walking_stream = (stream == DEFAULT_TIP_POSITION_STREAM || stream == TARGET_TIP_POSITION_STREAM ||
+                           stream == WALKSPACE_STREAM || stream == WORKSPACE_STREAM ||
+                           stream == BEZIER_CURVE_STREAM || stream == STRIDE_STREAM);
+    bool enabled = (running || !walking_stream) && (tip_force || stream != TIP_FORCE_STREAM);
+    captured_state_.due_[i] = enabled && isStreamDue(stream);
+    any_due = any_due || captured_state_.due_[i];
+  }
+  if (!any_due)
+  {
+    return;
+  }
+
+  captured_state_.legs_.resize(model->getLegCount());
+  LegContainer::iterator leg_it;
+  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> leg = leg_it->second;
+    captureLegState(leg, &captured_state_.legs_[leg->getIDNumber()], captured_state_.due_[WORKSPACE_STREAM]);
+  }
+  captured_state_.body_rotation_ = model->getCurrentPose().rotation_;
+  captured_state_.gravity_estimate_ = model->estimateGravity();
+  captured_state_.walk_plane_ = walker->getWalkPlane();
+  captured_state_.walk_plane_normal_ = walker->getWalkPlaneNormal();
+  captured_state_.body_clearance_ = walker->getBodyClearance();
+  if (captured_state_.due_[WALKSPACE_STREAM])
+  {
+    captured_state_.walkspace_ = walker->getWalkspace();
+  }
+  captured_state_.stamp_ = ros::Time::now();
+  state_output_.write(captured_state_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::captureLegState(std::shared_ptr<Leg> leg, LegVisualisationState* leg_state,
+                                      const bool &capture_workspace)
+{
+  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+  leg_state->id_number_ = leg->getIDNumber();
+  leg_state->id_name_ = leg->getIDName();
+  leg_state->joint_positions_.resize(leg->getJointCount());
+  leg_state->joint_efforts_.resize(leg->getJointCount());
+  JointContainer::iterator joint_it;
+  int joint_index = 0;
+  for (joint_it = leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+  {
+    std::shared_ptr<Joint> joint = joint_it->second;
+    leg_state->joint_positions_[joint_index] = joint->getPoseRobotFrame().position_;
+    leg_state->joint_efforts_[joint_index] = joint->current_effort_;
+    joint_index++;
+  }
+  leg_state->tip_position_ = leg->getCurrentTipPose().position_;
+  leg_state->tip_force_calculated_ = leg->getTipForceCalculated();
+  leg_state->tip_force_measured_ = leg->getTipForceMeasured();
+  if (capture_workspace)
+  {
+    leg_state->workspace_ = leg->getWorkspace();
+  }
+  if (leg_stepper == NULL)
+  {
+    return;
+  }
+  leg_state->swing_progress_ = leg_stepper->getSwingProgress();
+  leg_state->at_correct_phase_ = leg_stepper->isAtCorrectPhase();
+  leg_state->default_tip_position_ = leg_stepper->getDefaultTipPose().position_;
+  leg_state->target_tip_position_ = leg_stepper->getTargetTipPose().position_;
+  leg_state->identity_tip_position_ = leg_stepper->getIdentityTipPose().position_;
+  leg_state->walk_plane_normal_ = leg_stepper->getWalkPlaneNormal();
+  leg_state->stride_vector_ = leg_stepper->getStrideVector();
+  for (int i = 0; i < CONTROL_NODE_COUNT; ++i)
+  {
+    leg_state->stance_nodes_[i] = leg_stepper->getStanceControlNode(i);
+    leg_state->swing_1_nodes_[i] = leg_stepper->getSwing1ControlNode(i);
+    leg_state->swing_2_nodes_[i] = leg_stepper->getSwing2ControlNode(i);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::visualisationLoop(void)
+{
+  ros::Rate r(1.0 / time_delta_);
+  VisualisationState state;
+  VisualisationState snapshot;
+  while (visualisation_thread_running_ && ros::ok())
+  {
+    // Publish at most one queued workspace generation snapshot per cycle such that the search may be followed
+    if (workspace_snapshot_queue_.pop(snapshot))
+    {
+      publishWorkspaceSnapshot(snapshot);
+    }
+    if (state_output_.read(&state))
+    {
+      publishState(state);
+    }
+    r.sleep();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::publishState(const VisualisationState &state)
+{
+  if (state.legs_.empty())
+  {
+    return;
+  }
+
+  // Estimate of robot body length used in scaling markers (distance to first joint of first leg)
+  if (marker_scale_ == 0 && !state.legs_[0].joint_positions_.empty())
+  {
+    marker_scale_ = state.legs_[0].joint_positions_[0].norm() * 2.0;
+  }
+
+  if (state.due_[ROBOT_MODEL_STREAM])
+  {
+    generateRobotModel(state);
+  }
+  if (state.due_[GRAVITY_STREAM])
+  {
+    generateGravity(state);
+  }
+  if (state.due_[WALK_PLANE_STREAM])
+  {
+    generateWalkPlane(state);
+  }
+  if (state.due_[TERRAIN_STREAM])
+  {
+    generateTerrainEstimate(state);
+  }
+  generateStaticMarkers(state);
+
+  std::vector<LegVisualisationState>::const_iterator leg_it;
+  for (leg_it = state.legs_.begin(); leg_it != state.legs_.end(); ++leg_it)
+  {
+    if (state.due_[TIP_TRAJECTORY_STREAM])
+    {
+      generateTipTrajectory(*leg_it, state.stamp_);
+    }
+    if (state.due_[JOINT_TORQUE_STREAM])
+    {
+      generateJointTorques(*leg_it, state.stamp_);
+    }
+    if (state.due_[DEFAULT_TIP_POSITION_STREAM])
+    {
+      generateDefaultTipPositions(*leg_it, state.stamp_);
+    }
+    if (state.due_[TARGET_TIP_POSITION_STREAM])
+    {
+      generateTargetTipPositions(*leg_it, state.stamp_);
+    }
+    if (state.due_[BEZIER_CURVE_STREAM])
+    {
+      generateBezierCurves(*leg_it, state.stamp_);
+    }
+    if (state.due_[STRIDE_STREAM])
+    {
+      generateStride(*leg_it, state.stamp_);
+    }
+    if (state.due_[TIP_FORCE_STREAM])
+    {
+      generateTipForce(*leg_it, state.stamp_);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::generateStaticMarkers(const VisualisationState &state)
+{
+  bool walkspace_due = state.due_[WALKSPACE_STREAM];
+  bool workspace_due = state.due_[WORKSPACE_STREAM];
+  if (!walkspace_due && !workspace_due)
+  {
+    return;
+  }
+
+  // Republish markers of all legs upon connection of new subscribers, otherwise only upon change of input
+  int walkspace_subscriber_count = publishers_[WALKSPACE_STREAM].getNumSubscribers();
+  int workspace_subscriber_count = publishers_[WORKSPACE_STREAM].getNumSubscribers();
+  bool new_walkspace_subscriber = walkspace_subscriber_count > published_subscriber_count_[WALKSPACE_STREAM];
+  bool new_workspace_subscriber = workspace_subscriber_count > published_subscriber_count_[WORKSPACE_STREAM];
+  bool walkspace_changed = new_walkspace_subscriber || state.walkspace_ != published_state_.walkspace_;
+  bool workspace_changed = new_workspace_subscriber || state.body_clearance_ != published_state_.body_clearance_;
+  if (walkspace_due)
+  {
+    published_subscriber_count_[WALKSPACE_STREAM] = walkspace_subscriber_count;
+    published_state_.walkspace_ = state.walkspace_;
+  }
+  if (workspace_due)
+  {
+    published_subscriber_count_[WORKSPACE_STREAM] = workspace_subscriber_count;
+    published_state_.body_clearance_ = state.body_clearance_;
+  }
+  published_state_.legs_.resize(state.legs_.size());
+
+  for (uint i = 0; i < state.legs_.size(); ++i)
+  {
+    const LegVisualisationState& leg = state.legs_[i];
+    LegVisualisationState& published_leg = published_state_.legs_[i];
+    if (walkspace_due &&
+        (walkspace_changed ||
+         leg.default_tip_position_ != published_leg.default_tip_position_ ||
+         leg.walk_plane_normal_ != published_leg.walk_plane_normal_))
+    {
+      generateWalkspace(leg, state.walkspace_, state.stamp_);
+      published_leg.default_tip_position_ = leg.default_tip_position_;
+      published_leg.walk_plane_normal_ = leg.walk_plane_normal_;
+    }
+    if (workspace_due &&
+        (workspace_changed ||
+         leg.identity_tip_position_ != published_leg.identity_tip_position_ ||
+         leg.workspace_ != published_leg.workspace_))
+    {
+      generateWorkspace(leg, state.body_clearance_);
+      published_leg.identity_tip_position_ = leg.identity_tip_position_;
+      published_leg.workspace_ = leg.workspace_;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::publishWorkspaceFrames(const Pose &body_pose)
+{
+  Pose pose = body_pose;
+  tf2_ros::StaticTransformBroadcaster static_broadcaster;
+  geometry_msgs::TransformStamped static_odom_ideal_to_base_link;
+  static_odom_ideal_to_base_link.header.stamp = ros::Time::now();
+  static_odom_ideal_to_base_link.header.frame_id = "odom_ideal";
+  static_odom_ideal_to_base_link.child_frame_id = "base_link";
+  static_odom_ideal_to_base_link.transform = pose.toTransformMessage();
+  static_broadcaster.sendTransform(static_odom_ideal_to_base_link);
+  geometry_msgs::TransformStamped static_base_link_to_walk_plane = static_odom_ideal_to_base_link;
+  static_base_link_to_walk_plane.header.frame_id = "base_link";
+  static_base_link_to_walk_plane.child_frame_id = "walk_plane";
+  static_base_link_to_walk_plane.transform = (~pose).toTransformMessage();
+  static_broadcaster.sendTransform(static_base_link_to_walk_plane);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool DebugVisualiser::pushWorkspaceSnapshot(std::shared_ptr<Model> model, std::shared_ptr<Leg> leg,
+                                            const double &body_clearance)
+{
+  if (!visualisation_thread_running_ || workspace_snapshot_queue_.write_available() == 0)
+  {
+    return false;
+  }
+
+  VisualisationState snapshot;
+  snapshot.due_.fill(false);
+  snapshot.due_[ROBOT_MODEL_STREAM] = true;
+  snapshot.due_[WORKSPACE_STREAM] = true;
+  snapshot.legs_.resize(model->getLegCount());
+  LegContainer::iterator leg_it;
+  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> model_leg = leg_it->second;
+    captureLegState(model_leg, &snapshot.legs_[model_leg->getIDNumber()], model_leg == leg);
+  }
+  snapshot.body_clearance_ = body_clearance;
+  snapshot.stamp_ = ros::Time::now();
+  return workspace_snapshot_queue_.push(snapshot);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::publishWorkspaceSnapshot(const VisualisationState &snapshot)
+{
+  if (marker_scale_ == 0 && !snapshot.legs_[0].joint_positions_.empty())
+  {
+    marker_scale_ = snapshot.legs_[0].joint_positions_[0].norm() * 2.0;
+  }
+  generateRobotModel(snapshot);
+  std::vector<LegVisualisationState>::const_iterator leg_it;
+  for (leg_it = snapshot.legs_.begin(); leg_it != snapshot.legs_.end(); ++leg_it)
+  {
+    if (!leg_it->workspace_.empty())
+    {
+      generateWorkspace(*leg_it, snapshot.body_clearance_);
+    }
+  }
+
+  // Force republish of final workspace markers which intermediate snapshots have overwritten
+  published_subscriber_count_[WORKSPACE_STREAM] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void DebugVisualiser::generateRobotModel(const VisualisationState &state)
+{
   visualization_msgs::Marker leg_line_list;
   leg_line_list.header.frame_id = "/base_link";
   leg_line_list.header.stamp = ros::Time(0);
@@ -59,10 +428,10 @@ void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
   Eigen::Vector3d previous_body_position = Eigen::Vector3d::Zero();
   Eigen::Vector3d initial_body_position = Eigen::Vector3d::Zero();
 
-  LegContainer::iterator leg_it;
-  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  std::vector<LegVisualisationState>::const_iterator leg_it;
+  for (leg_it = state.legs_.begin(); leg_it != state.legs_.end(); ++leg_it)
   {
-    std::shared_ptr<Leg> leg = leg_it->second;
+    const LegVisualisationState& leg = *leg_it;
 
     // Generate line segment between 1st joint of each leg (creating body)
     point.x = previous_body_position[0];
@@ -70,8 +439,7 @@ void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
     point.z = previous_body_position[2];
     leg_line_list.points.push_back(point);
 
-    std::shared_ptr<Joint> first_joint = leg->getJointContainer()->begin()->second;
-    Eigen::Vector3d first_joint_position = first_joint->getPoseRobotFrame().position_;
+    Eigen::Vector3d first_joint_position = leg.joint_positions_.front();
     point.x = first_joint_position[0];
     point.y = first_joint_position[1];
     point.z = first_joint_position[2];
@@ -80,22 +448,21 @@ void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
     Eigen::Vector3d previous_joint_position = first_joint_position;
     previous_body_position = first_joint_position;
 
-    if (leg->getIDNumber() == 0)
+    if (leg.id_number_ == 0)
     {
       initial_body_position = first_joint_position;
     }
 
     // Generate line segment between joint positions
-    JointContainer::iterator joint_it; //Start at second joint
-    for (joint_it = ++leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+    std::vector<Eigen::Vector3d>::const_iterator joint_it; //Start at second joint
+    for (joint_it = ++leg.joint_positions_.begin(); joint_it != leg.joint_positions_.end(); ++joint_it)
     {
       point.x = previous_joint_position[0];
       point.y = previous_joint_position[1];
       point.z = previous_joint_position[2];
       leg_line_list.points.push_back(point);
 
-      std::shared_ptr<Joint> joint = joint_it->second;
-      Eigen::Vector3d joint_position = joint->getPoseRobotFrame().position_;
+      Eigen::Vector3d joint_position = *joint_it;
       point.x = joint_position[0];
       point.y = joint_position[1];
       point.z = joint_position[2];
@@ -110,7 +477,7 @@ void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
     point.z = previous_joint_position[2];
     leg_line_list.points.push_back(point);
 
-    Eigen::Vector3d tip_position = leg->getCurrentTipPose().position_;
+    Eigen::Vector3d tip_position = leg.tip_position_;
     point.x = tip_position[0];
     point.y = tip_position[1];
     point.z = tip_position[2];
@@ -128,16 +495,16 @@ void DebugVisualiser::generateRobotModel(std::shared_ptr<Model> model)
   point.z = initial_body_position[2];
   leg_line_list.points.push_back(point);
 
-  robot_model_publisher_.publish(leg_line_list);
+  publishers_[ROBOT_MODEL_STREAM].publish(leg_line_list);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateWalkPlane(const Eigen::Vector3d& walk_plane, const Eigen::Vector3d& walk_plane_normal)
+void DebugVisualiser::generateWalkPlane(const VisualisationState &state)
 {
   visualization_msgs::Marker walk_plane_marker;
   walk_plane_marker.header.frame_id = "/walk_plane";
-  walk_plane_marker.header.stamp = ros::Time::now();
+  walk_plane_marker.header.stamp = state.stamp_;
   walk_plane_marker.ns = "walk_plane_marker";
   walk_plane_marker.id = 0;
   walk_plane_marker.type = visualization_msgs::Marker::CUBE;
@@ -152,25 +519,25 @@ void DebugVisualiser::generateWalkPlane(const Eigen::Vector3d& walk_plane, const
   
   walk_plane_marker.pose.position.x = 0.0;
   walk_plane_marker.pose.position.y = 0.0;
-  walk_plane_marker.pose.position.z = walk_plane[2];
+  walk_plane_marker.pose.position.z = state.walk_plane_[2];
   
   Eigen::Quaterniond walk_plane_orientation = Eigen::Quaterniond::FromTwoVectors(Eigen::Vector3d::UnitZ(),
-  walk_plane_normal);
+  state.walk_plane_normal_);
   walk_plane_marker.pose.orientation.w = walk_plane_orientation.w();
   walk_plane_marker.pose.orientation.x = walk_plane_orientation.x();
   walk_plane_marker.pose.orientation.y = walk_plane_orientation.y();
   walk_plane_marker.pose.orientation.z = walk_plane_orientation.z();
   
-  walk_plane_publisher_.publish(walk_plane_marker);
+  publishers_[WALK_PLANE_STREAM].publish(walk_plane_marker);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateTipTrajectory(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateTipTrajectory(const LegVisualisationState &leg, const ros::Time &stamp)
 {
   visualization_msgs::Marker tip_position_marker;
   tip_position_marker.header.frame_id = "/base_link";
-  tip_position_marker.header.stamp = ros::Time::now();
+  tip_position_marker.header.stamp = stamp;
   tip_position_marker.ns = "tip_trajectory_markers";
   tip_position_marker.id = tip_position_id_;
   tip_position_marker.action = visualization_msgs::Marker::ADD;
@@ -181,7 +548,7 @@ void DebugVisualiser::generateTipTrajectory(std::shared_ptr<Leg> leg)
   tip_position_marker.lifetime = ros::Duration(TRAJECTORY_DURATION);
   tip_position_marker.pose = Pose::Identity().toPoseMessage();
 
-  Eigen::Vector3d tip_position = leg->getCurrentTipPose().position_;
+  Eigen::Vector3d tip_position = leg.tip_position_;
   geometry_msgs::Point point;
   point.x = tip_position[0];
   point.y = tip_position[1];
@@ -189,25 +556,24 @@ void DebugVisualiser::generateTipTrajectory(std::shared_ptr<Leg> leg)
   ROS_ASSERT(point.x + point.y + point.z < 1e3); // Check that point has valid values
   tip_position_marker.points.push_back(point);
 
-  tip_trajectory_publisher_.publish(tip_position_marker);
+  publishers_[TIP_TRAJECTORY_STREAM].publish(tip_position_marker);
   tip_position_id_ = (tip_position_id_ + 1) % ID_LIMIT; // Ensures the trajectory marker id does not exceed overflow
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateTerrainEstimate(std::shared_ptr<Model> model)
+void DebugVisualiser::generateTerrainEstimate(const VisualisationState &state)
 {
-  LegContainer::iterator leg_it;
-  for (leg_it = model->getLegContainer()->begin(); leg_it != model->getLegContainer()->end(); ++leg_it)
+  std::vector<LegVisualisationState>::const_iterator leg_it;
+  for (leg_it = state.legs_.begin(); leg_it != state.legs_.end(); ++leg_it)
   {
-    std::shared_ptr<Leg> leg = leg_it->second;
-    if (leg->getLegStepper()->getSwingProgress() == 1.0)
+    if (leg_it->swing_progress_ == 1.0)
     {
-      Eigen::Vector3d tip_position = leg->getCurrentTipPose().position_;
+      Eigen::Vector3d tip_position = leg_it->tip_position_;
       
       visualization_msgs::Marker terrain_marker;
       terrain_marker.header.frame_id = "/base_link";
-      terrain_marker.header.stamp = ros::Time::now();
+      terrain_marker.header.stamp = state.stamp_;
       terrain_marker.ns = "terrain_markers";
       terrain_marker.id = terrain_marker_id_;
       terrain_marker.action = visualization_msgs::Marker::ADD;
@@ -217,7 +583,7 @@ void DebugVisualiser::generateTerrainEstimate(std::shared_ptr<Model> model)
       terrain_marker.scale.z = tip_position[2] + 0.5;
       terrain_marker.color.r = 1; // RED
       terrain_marker.color.a = 0.5;
-      Pose pose(Eigen::Vector3d(0, 0, -terrain_marker.scale.z / 2.0), model->getCurrentPose().rotation_.inverse());
+      Pose pose(Eigen::Vector3d(0, 0, -terrain_marker.scale.z / 2.0), state.body_rotation_.inverse());
       terrain_marker.pose = pose.toPoseMessage();
       
       geometry_msgs::Point point;
@@ -225,21 +591,21 @@ void DebugVisualiser::generateTerrainEstimate(std::shared_ptr<Model> model)
       point.y = tip_position[1];
       point.z = tip_position[2];
       terrain_marker.points.push_back(point);
-      terrain_publisher_.publish(terrain_marker);
-      terrain_marker_id_ = (terrain_marker_id_ + 1) % (model->getLegCount() * 10);
+      publishers_[TERRAIN_STREAM].publish(terrain_marker);
+      terrain_marker_id_ = (terrain_marker_id_ + 1) % (state.legs_.size() * 10);
     }
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateBezierCurves(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateBezierCurves(const LegVisualisationState &leg, const ros::Time &stamp)
 {
   visualization_msgs::Marker swing_1_nodes;
   swing_1_nodes.header.frame_id = "/walk_plane";
-  swing_1_nodes.header.stamp = ros::Time::now();
+  swing_1_nodes.header.stamp = stamp;
   swing_1_nodes.ns = "primary_swing_control_nodes";
-  swing_1_nodes.id = leg->getIDNumber();
+  swing_1_nodes.id = leg.id_number_;
   swing_1_nodes.action = visualization_msgs::Marker::ADD;
   swing_1_nodes.type = visualization_msgs::Marker::SPHERE_LIST;
   swing_1_nodes.scale.x = 0.02 * sqrt(marker_scale_);
@@ -251,9 +617,9 @@ void DebugVisualiser::generateBezierCurves(std::shared_ptr<Leg> leg)
 
   visualization_msgs::Marker swing_2_nodes;
   swing_2_nodes.header.frame_id = "/walk_plane";
-  swing_2_nodes.header.stamp = ros::Time::now();
+  swing_2_nodes.header.stamp = stamp;
   swing_2_nodes.ns = "secondary_swing_control_nodes";
-  swing_2_nodes.id = leg->getIDNumber();
+  swing_2_nodes.id = leg.id_number_;
   swing_2_nodes.action = visualization_msgs::Marker::ADD;
   swing_2_nodes.type = visualization_msgs::Marker::SPHERE_LIST;
   swing_2_nodes.scale.x = 0.02 * sqrt(marker_scale_);
@@ -265,9 +631,9 @@ void DebugVisualiser::generateBezierCurves(std::shared_ptr<Leg> leg)
 
   visualization_msgs::Marker stance_nodes;
   stance_nodes.header.frame_id = "/walk_plane";
-  stance_nodes.header.stamp = ros::Time::now();
+  stance_nodes.header.stamp = stamp;
   stance_nodes.ns = "stance_control_nodes";
-  stance_nodes.id = leg->getIDNumber();
+  stance_nodes.id = leg.id_number_;
   stance_nodes.action = visualization_msgs::Marker::ADD;
   stance_nodes.type = visualization_msgs::Marker::SPHERE_LIST;
   stance_nodes.scale.x = 0.02 * sqrt(marker_scale_);
@@ -277,24 +643,22 @@ void DebugVisualiser::generateBezierCurves(std::shared_ptr<Leg> leg)
   stance_nodes.color.a = 0.5;
   stance_nodes.pose = Pose::Identity().toPoseMessage();
 
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-
-  for (int i = 0; i < 5; ++i) // For each of 5 control nodes
+  for (int i = 0; i < CONTROL_NODE_COUNT; ++i) // For each of 5 control nodes
   {
     geometry_msgs::Point point;
-    Eigen::Vector3d stance_node = leg_stepper->getStanceControlNode(i);
+    Eigen::Vector3d stance_node = leg.stance_nodes_[i];
     point.x = stance_node[0];
     point.y = stance_node[1];
     point.z = stance_node[2];
     ROS_ASSERT(point.x + point.y + point.z < 1e3); // Check that point has valid values
     stance_nodes.points.push_back(point);
-    Eigen::Vector3d swing_1_node = leg_stepper->getSwing1ControlNode(i);
+    Eigen::Vector3d swing_1_node = leg.swing_1_nodes_[i];
     point.x = swing_1_node[0];
     point.y = swing_1_node[1];
     point.z = swing_1_node[2];
     ROS_ASSERT(point.x + point.y + point.z < 1e3); // Check that point has valid values
     swing_1_nodes.points.push_back(point);
-    Eigen::Vector3d swing_2_node = leg_stepper->getSwing2ControlNode(i);
+    Eigen::Vector3d swing_2_node = leg.swing_2_nodes_[i];
     point.x = swing_2_node[0];
     point.y = swing_2_node[1];
     point.z = swing_2_node[2];
@@ -302,50 +666,46 @@ void DebugVisualiser::generateBezierCurves(std::shared_ptr<Leg> leg)
     swing_2_nodes.points.push_back(point);
   }
 
-  bezier_curve_publisher_.publish(stance_nodes);
-  bezier_curve_publisher_.publish(swing_1_nodes);
-  bezier_curve_publisher_.publish(swing_2_nodes);
+  publishers_[BEZIER_CURVE_STREAM].publish(stance_nodes);
+  publishers_[BEZIER_CURVE_STREAM].publish(swing_1_nodes);
+  publishers_[BEZIER_CURVE_STREAM].publish(swing_2_nodes);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateDefaultTipPositions(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateDefaultTipPositions(const LegVisualisationState &leg, const ros::Time &stamp)
 {
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-
   visualization_msgs::Marker default_tip_position;
   default_tip_position.header.frame_id = "/walk_plane";
-  default_tip_position.header.stamp = ros::Time::now();
+  default_tip_position.header.stamp = stamp;
   default_tip_position.ns = "default_tip_position_markers";
-  default_tip_position.id = leg->getIDNumber();
+  default_tip_position.id = leg.id_number_;
   default_tip_position.type = visualization_msgs::Marker::SPHERE;
   default_tip_position.action = visualization_msgs::Marker::ADD;
   default_tip_position.scale.x = 0.04 * sqrt(marker_scale_);
   default_tip_position.scale.y = 0.04 * sqrt(marker_scale_);
   default_tip_position.scale.z = 0.04 * sqrt(marker_scale_);
   default_tip_position.color.g = 1;
-  default_tip_position.color.b = leg_stepper->isAtCorrectPhase() ? 0.0 : 1.0;
+  default_tip_position.color.b = leg.at_correct_phase_ ? 0.0 : 1.0;
   default_tip_position.color.a = 1;
   
   default_tip_position.pose = Pose::Identity().toPoseMessage();
-  default_tip_position.pose.position.x = leg_stepper->getDefaultTipPose().position_[0];
-  default_tip_position.pose.position.y = leg_stepper->getDefaultTipPose().position_[1];
-  default_tip_position.pose.position.z = leg_stepper->getDefaultTipPose().position_[2];
+  default_tip_position.pose.position.x = leg.default_tip_position_[0];
+  default_tip_position.pose.position.y = leg.default_tip_position_[1];
+  default_tip_position.pose.position.z = leg.default_tip_position_[2];
   
-  default_tip_position_publisher_.publish(default_tip_position);
+  publishers_[DEFAULT_TIP_POSITION_STREAM].publish(default_tip_position);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateTargetTipPositions(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateTargetTipPositions(const LegVisualisationState &leg, const ros::Time &stamp)
 {
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-
   visualization_msgs::Marker target_tip_position;
   target_tip_position.header.frame_id = "/walk_plane";
-  target_tip_position.header.stamp = ros::Time::now();
+  target_tip_position.header.stamp = stamp;
   target_tip_position.ns = "target_tip_position_markers";
-  target_tip_position.id = leg->getIDNumber();
+  target_tip_position.id = leg.id_number_;
   target_tip_position.type = visualization_msgs::Marker::SPHERE;
   target_tip_position.action = visualization_msgs::Marker::ADD;
   target_tip_position.scale.x = 0.02 * sqrt(marker_scale_);
@@ -355,24 +715,23 @@ void DebugVisualiser::generateTargetTipPositions(std::shared_ptr<Leg> leg)
   target_tip_position.color.a = 1;
   
   target_tip_position.pose = Pose::Identity().toPoseMessage();
-  target_tip_position.pose.position.x = leg_stepper->getTargetTipPose().position_[0];
-  target_tip_position.pose.position.y = leg_stepper->getTargetTipPose().position_[1];
-  target_tip_position.pose.position.z = leg_stepper->getTargetTipPose().position_[2];
+  target_tip_position.pose.position.x = leg.target_tip_position_[0];
+  target_tip_position.pose.position.y = leg.target_tip_position_[1];
+  target_tip_position.pose.position.z = leg.target_tip_position_[2];
   
-  target_tip_position_publisher_.publish(target_tip_position);
+  publishers_[TARGET_TIP_POSITION_STREAM].publish(target_tip_position);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateWalkspace(std::shared_ptr<Leg> leg, const LimitMap& walkspace)
+void DebugVisualiser::generateWalkspace(const LegVisualisationState &leg, const LimitMap& walkspace,
+                                        const ros::Time &stamp)
 {
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-  
   visualization_msgs::Marker walkspace_marker;
   walkspace_marker.header.frame_id = "/walk_plane";
-  walkspace_marker.header.stamp = ros::Time::now();
+  walkspace_marker.header.stamp = stamp;
   walkspace_marker.ns = "walkspace_markers";
-  walkspace_marker.id = leg->getIDNumber();
+  walkspace_marker.id = leg.id_number_;
   walkspace_marker.type = visualization_msgs::Marker::LINE_STRIP;
   walkspace_marker.action = visualization_msgs::Marker::ADD;
   walkspace_marker.scale.x = 0.002 * sqrt(marker_scale_);
@@ -380,10 +739,10 @@ void DebugVisualiser::generateWalkspace(std::shared_ptr<Leg> leg, const LimitMap
   walkspace_marker.color.b = 1;
   walkspace_marker.color.a = 1;
   Pose pose(Eigen::Vector3d::Zero(), Eigen::Quaterniond::FromTwoVectors(Eigen::Vector3d::UnitZ(),
-                                                                        leg_stepper->getWalkPlaneNormal()));
+                                                                        leg.walk_plane_normal_));
   walkspace_marker.pose = pose.toPoseMessage();
   geometry_msgs::Point origin_point;
-  Eigen::Vector3d walkspace_origin = leg_stepper->getDefaultTipPose().position_;
+  Eigen::Vector3d walkspace_origin = leg.default_tip_position_;
   walkspace_origin = pose.inverseTransformVector(walkspace_origin);
   origin_point.x = walkspace_origin[0];
   origin_point.y = walkspace_origin[1];
@@ -406,15 +765,14 @@ void DebugVisualiser::generateWalkspace(std::shared_ptr<Leg> leg, const LimitMap
       walkspace_marker.points.push_back(point);
     }
   }
-  walkspace_publisher_.publish(walkspace_marker);
+  publishers_[WALKSPACE_STREAM].publish(walkspace_marker);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateWorkspace(std::shared_ptr<Leg> leg, const double& body_clearance)
+void DebugVisualiser::generateWorkspace(const LegVisualisationState &leg, const double &body_clearance)
 {
-  Workspace workspace = leg->getWorkspace();
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+  const Workspace& workspace = leg.workspace_;
   
   visualization_msgs::MarkerArray workspace_cage_marker_array;
   std::map<int, visualization_msgs::Marker> workspace_cage_markers;
@@ -423,7 +781,7 @@ void DebugVisualiser::generateWorkspace(std::shared_ptr<Leg> leg, const double&
   visualization_msgs::Marker workspace_marker;
   workspace_marker.header.frame_id = "/base_link";
   workspace_marker.header.stamp = ros::Time(0);
-  workspace_marker.ns = leg->getIDName() + "_workspace_markers";
+  workspace_marker.ns = leg.id_name_ + "_workspace_markers";
   workspace_marker.type = visualization_msgs::Marker::LINE_STRIP;
   workspace_marker.action = visualization_msgs::Marker::ADD;
   workspace_marker.scale.x = 0.002 * sqrt(marker_scale_);
@@ -439,7 +797,7 @@ void DebugVisualiser::generateWorkspace(std::shared_ptr<Leg> leg, const double&
     Workplane workplane = workspace_it->second;
     workspace_marker.id = workspace_id;
     geometry_msgs::Point origin_point;
-    Eigen::Vector3d identity_tip_position = leg_stepper->getIdentityTipPose().position_ - 
+    Eigen::Vector3d identity_tip_position = leg.identity_tip_position_ - 
     Eigen::Vector3d::UnitZ() * body_clearance;
     Eigen::Vector3d workplane_origin = identity_tip_position + Eigen::Vector3d::UnitZ() * plane_height;
     origin_point.x = workplane_origin[0];
@@ -469,7 +827,7 @@ void DebugVisualiser::generateWorkspace(std::shared_ptr<Leg> leg, const double&
         if (workspace_cage_markers.find(bearing) == workspace_cage_markers.end())
         {
           visualization_msgs::Marker workspace_cage_marker = workspace_marker;
-          workspace_cage_marker.ns = leg->getIDName() + "_workspace_markers";
+          workspace_cage_marker.ns = leg.id_name_ + "_workspace_markers";
           workspace_cage_marker.id = bearing;
           workspace_cage_markers.insert(std::map<int, visualization_msgs::Marker>::value_type(bearing,
           workspace_cage_marker));
@@ -490,29 +848,28 @@ void DebugVisualiser::generateWorkspace(std::shared_ptr<Leg> leg, const double&
     }
   }
   
-  workspace_publisher_.publish(workspace_marker_array);
-  workspace_publisher_.publish(workspace_cage_marker_array);
+  publishers_[WORKSPACE_STREAM].publish(workspace_marker_array);
+  publishers_[WORKSPACE_STREAM].publish(workspace_cage_marker_array);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateStride(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateStride(const LegVisualisationState &leg, const ros::Time &stamp)
 {
-  std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-  Eigen::Vector3d stride_vector = leg_stepper->getStrideVector();
+  Eigen::Vector3d stride_vector = leg.stride_vector_;
 
   visualization_msgs::Marker stride;
   stride.header.frame_id = "/walk_plane";
-  stride.header.stamp = ros::Time::now();
+  stride.header.stamp = stamp;
   stride.ns = "stride_markers";
-  stride.id = leg->getIDNumber();
+  stride.id = leg.id_number_;
   stride.type = visualization_msgs::Marker::ARROW;
   stride.action = visualization_msgs::Marker::ADD;
   geometry_msgs::Point origin;
   geometry_msgs::Point target;
-  origin.x = leg_stepper->getDefaultTipPose().position_[0];
-  origin.y = leg_stepper->getDefaultTipPose().position_[1];
-  origin.z = leg_stepper->getDefaultTipPose().position_[2];
+  origin.x = leg.default_tip_position_[0];
+  origin.y = leg.default_tip_position_[1];
+  origin.z = leg.default_tip_position_[2];
   target = origin;
   target.x += (stride_vector[0] / 2.0);
   target.y += (stride_vector[1] / 2.0);
@@ -526,20 +883,20 @@ void DebugVisualiser::generateStride(std::shared_ptr<Leg> leg)
   stride.color.a = 1;
   stride.pose = Pose::Identity().toPoseMessage();
 
-  stride_publisher_.publish(stride);
+  publishers_[STRIDE_STREAM].publish(stride);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateTipForce(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateTipForce(const LegVisualisationState &leg, const ros::Time &stamp)
 {
   visualization_msgs::Marker tip_force;
   tip_force.header.frame_id = "/base_link";
-  tip_force.header.stamp = ros::Time::now();
-  tip_force.id = leg->getIDNumber();
+  tip_force.header.stamp = stamp;
+  tip_force.id = leg.id_number_;
   tip_force.type = visualization_msgs::Marker::ARROW;
   tip_force.action = visualization_msgs::Marker::ADD;
-  Eigen::Vector3d tip_position = leg->getCurrentTipPose().position_;
+  Eigen::Vector3d tip_position = leg.tip_position_;
   geometry_msgs::Point origin;
   geometry_msgs::Point target;
   origin.x = tip_position[0];
@@ -555,47 +912,45 @@ void DebugVisualiser::generateTipForce(std::shared_ptr<Leg> leg)
   visualization_msgs::Marker tip_force_calculated = tip_force;
   tip_force_calculated.ns = "tip_force_calculated_markers";
   target = origin;
-  target.x += leg->getTipForceCalculated()[0];
-  target.y += leg->getTipForceCalculated()[1];
-  target.z += leg->getTipForceCalculated()[2];
+  target.x += leg.tip_force_calculated_[0];
+  target.y += leg.tip_force_calculated_[1];
+  target.z += leg.tip_force_calculated_[2];
   tip_force_calculated.points.push_back(origin);
   tip_force_calculated.points.push_back(target);
   tip_force_calculated.color.b = 1; // MAGENTA
   tip_force_calculated.color.r = 1;
-  tip_force_publisher_.publish(tip_force_calculated);
+  publishers_[TIP_FORCE_STREAM].publish(tip_force_calculated);
   
   // Tip Force Measured
   visualization_msgs::Marker tip_force_measured = tip_force;
   tip_force_measured.ns = "tip_force_measured_markers";
   target = origin;
-  target.x += leg->getTipForceMeasured()[0];
-  target.y += leg->getTipForceMeasured()[1];
-  target.z += leg->getTipForceMeasured()[2];
+  target.x += leg.tip_force_measured_[0];
+  target.y += leg.tip_force_measured_[1];
+  target.z += leg.tip_force_measured_[2];
   tip_force_measured.points.push_back(origin);
   tip_force_measured.points.push_back(target);
   tip_force_measured.color.b = 1; // CYAN
   tip_force_measured.color.g = 1;
-  tip_force_publisher_.publish(tip_force_measured);
+  publishers_[TIP_FORCE_STREAM].publish(tip_force_measured);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateJointTorques(std::shared_ptr<Leg> leg)
+void DebugVisualiser::generateJointTorques(const LegVisualisationState &leg, const ros::Time &stamp)
 {
-  JointContainer::iterator joint_it;
-  int marker_id = leg->getIDNumber() * leg->getJointCount();
-  for (joint_it = leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+  int marker_id = leg.id_number_ * leg.joint_positions_.size();
+  for (uint i = 0; i < leg.joint_positions_.size(); ++i)
   {
-    std::shared_ptr<Joint> joint = joint_it->second;
     visualization_msgs::Marker joint_torque;
     joint_torque.header.frame_id = "/base_link";
-    joint_torque.header.stamp = ros::Time::now();
+    joint_torque.header.stamp = stamp;
     joint_torque.ns = "joint_torque_markers";
     joint_torque.type = visualization_msgs::Marker::SPHERE;
     joint_torque.action = visualization_msgs::Marker::ADD;
-    Eigen::Vector3d joint_position = joint->getPoseRobotFrame().position_;
+    Eigen::Vector3d joint_position = leg.joint_positions_[i];
     joint_torque.pose = Pose(joint_position, Eigen::Quaterniond::Identity()).toPoseMessage();
-    float torque_maximum_ratio = static_cast<float>(clamped(abs(joint->current_effort_) * 5.0, 0.1, 1.0));
+    float torque_maximum_ratio = static_cast<float>(clamped(abs(leg.joint_efforts_[i]) * 5.0, 0.1, 1.0));
     double sphere_radius = 0.1 * sqrt(marker_scale_) * torque_maximum_ratio;
     
     // Actual value
@@ -607,17 +962,17 @@ void DebugVisualiser::generateJointTorques(std::shared_ptr<Leg> leg)
     joint_torque.color.g = 1.0f - torque_maximum_ratio;
     joint_torque.color.b = 0.0f;
     joint_torque.color.a = 1.0f;
-    joint_torque_publisher_.publish(joint_torque);
+    publishers_[JOINT_TORQUE_STREAM].publish(joint_torque);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void DebugVisualiser::generateGravity(const Eigen::Vector3d& gravity_estimate)
+void DebugVisualiser::generateGravity(const VisualisationState &state)
 {
   visualization_msgs::Marker gravity;
   gravity.header.frame_id = "/base_link";
-  gravity.header.stamp = ros::Time::now();
+  gravity.header.stamp = state.stamp_;
   gravity.ns = "gravity_marker";
   gravity.id = 0;
   gravity.type = visualization_msgs::Marker::ARROW;
@@ -629,7 +984,7 @@ void DebugVisualiser::generateGravity(const Eigen::Vector3d& gravity_estimate)
   origin.y = robot_position[1];
   origin.z = robot_position[2];
   
-  Eigen::Vector3d direction_vector = gravity_estimate.normalized() * 0.1 * sqrt(marker_scale_); // Arrow Length  
+  Eigen::Vector3d direction_vector = state.gravity_estimate_.normalized() * 0.1 * sqrt(marker_scale_); // Arrow Length  
   geometry_msgs::Point target;
   target = origin;
   target.x += direction_vector[0];
@@ -645,7 +1000,7 @@ void DebugVisualiser::generateGravity(const Eigen::Vector3d& gravity_estimate)
   gravity.color.a = 1;
   gravity.pose = Pose::Identity().toPoseMessage();
 
-  gravity_publisher_.publish(gravity);
+  publishers_[GRAVITY_STREAM].publish(gravity);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
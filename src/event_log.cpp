@@ -0,0 +1,180 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/event_log.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool EventLog::startEventLogThread(const std::vector<std::string> &leg_names,
+                                   const std::vector<std::vector<std::string>> &joint_names,
+                                   const std::string &log_file)
+{
+  if (event_log_thread_running_)
+  {
+    return false;
+  }
+
+  leg_names_ = leg_names;
+  joint_names_ = joint_names;
+  for (int i = 0; i < EVENT_TYPE_COUNT; ++i)
+  {
+    event_counts_[i] = 0;
+  }
+  dropped_count_ = 0;
+
+  // Open binary event log file, written as identifier followed by raw event records
+  if (!log_file.empty())
+  {
+    log_file_ = fopen(log_file.c_str(), "wb");
+    if (log_file_ == NULL)
+    {
+      SHC_WARN("\n[SHC] Unable to open event log file %s. Events will not be logged to file.\n", log_file.c_str());
+    }
+    else
+    {
+      fwrite(EVENT_LOG_MAGIC, sizeof(EVENT_LOG_MAGIC), 1, log_file_);
+    }
+  }
+
+  event_log_thread_running_ = true;
+  event_log_thread_ = std::thread(&EventLog::eventLogLoop, this);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EventLog::stopEventLogThread(void)
+{
+  event_log_thread_running_ = false;
+  if (event_log_thread_.joinable())
+  {
+    event_log_thread_.join();
+  }
+  if (log_file_ != NULL)
+  {
+    fclose(log_file_);
+    log_file_ = NULL;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EventLog::eventLogLoop(void)
+{
+  RealTimeLoop loop(1.0 / EVENT_LOG_RATE);
+  while (event_log_thread_running_ && getCoreInterface()->ok())
+  {
+    consumeEvents();
+    loop.sleep();
+  }
+  consumeEvents();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EventLog::consumeEvents(void)
+{
+  Event event;
+  bool consumed = false;
+  while (event_queue_.pop(event))
+  {
+    consumed = true;
+    if (event.type_ >= 0 && event.type_ < EVENT_TYPE_COUNT)
+    {
+      event_counts_[event.type_]++;
+    }
+    if (log_file_ != NULL)
+    {
+      fwrite(&event, sizeof(Event), 1, log_file_);
+    }
+    logEvent(event);
+  }
+  if (consumed && log_file_ != NULL)
+  {
+    fflush(log_file_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void EventLog::logEvent(const Event &event)
+{
+  const char* axis_label[3] = { "x", "y", "z" };
+  const char* axis = (event.axis_ >= 0 && event.axis_ < 3) ? axis_label[event.axis_] : "unknown";
+  switch (event.type_)
+  {
+    case (IK_VELOCITY_CLAMPING_EVENT):
+      SHC_WARN("\nIK Clamping Event (cycle %" PRIu64 "):"
+               "\n\tType: Velocity\tJoint: %s\tDesired: %f rad/s\tLimited to: %f rad/s\n",
+               event.cycle_, getJointName(event), event.values_[0], event.values_[1]);
+      break;
+    case (IK_POSITION_CLAMPING_EVENT):
+      SHC_WARN("\nIK Clamping Event (cycle %" PRIu64 "):"
+               "\n\tType: Position\tJoint: %s\tDesired: %f rad\tLimited to: %f rad\n",
+               event.cycle_, getJointName(event), event.values_[0], event.values_[1]);
+      break;
+    case (IK_DEVIATION_EVENT):
+      SHC_WARN("\nInverse kinematics deviation! Calculated tip %s position of leg %s (%s: %f)"
+               " differs from desired tip position (%s: %f)\n",
+               axis, getLegName(event), axis, event.values_[0], axis, event.values_[1]);
+      break;
+    case (WORKPLANE_UNDEFINED_EVENT):
+      SHC_WARN("\n[SHC] Requested workplane (height %f) does not exist within workspace of leg %s.\n",
+               event.values_[0], getLegName(event));
+      break;
+    case (WALKSPACE_RADIUS_EVENT):
+      SHC_WARN("\n[SHC] Unable to generate radius at bearing %d for leg %s and workplane at height %f.\n",
+               roundToInt(event.values_[0]), getLegName(event), event.values_[1]);
+      break;
+    case (LINEAR_SPEED_CLAMPING_EVENT):
+      SHC_WARN_THROTTLE(THROTTLE_PERIOD,
+                        "\nInput linear speed (%f) exceeds maximum linear speed (%f) and has been clamped.\n",
+                        event.values_[0], event.values_[1]);
+      break;
+    case (ANGULAR_SPEED_CLAMPING_EVENT):
+      SHC_WARN_THROTTLE(THROTTLE_PERIOD,
+                        "\nInput angular velocity (%f) exceeds maximum angular speed (%f) and has been clamped.\n",
+                        event.values_[0], event.values_[1]);
+      break;
+    case (LEG_MANIPULATION_LIMIT_EVENT):
+      SHC_WARN_THROTTLE(THROTTLE_PERIOD, "\nCannot move leg %s any further due to IK or joint limits.\n",
+                        getLegName(event));
+      break;
+    case (TIP_STATES_MISSING_EVENT):
+      SHC_WARN_THROTTLE(THROTTLE_PERIOD, "\n[SHC] Rough terrain mode is enabled but SHC is not receiving"
+                                         "any tip state messages used for touchdown detection.\n");
+      break;
+    default:
+      SHC_WARN("\n[SHC] Unknown event type (%d) recorded in cycle %" PRIu64 ".\n", event.type_, event.cycle_);
+      break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* EventLog::getLegName(const Event &event)
+{
+  bool defined = (event.leg_id_number_ >= 0 && event.leg_id_number_ < int(leg_names_.size()));
+  return defined ? leg_names_[event.leg_id_number_].c_str() : "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+const char* EventLog::getJointName(const Event &event)
+{
+  bool leg_defined = (event.leg_id_number_ >= 0 && event.leg_id_number_ < int(joint_names_.size()));
+  if (!leg_defined)
+  {
+    return "unknown";
+  }
+  const std::vector<std::string> &leg_joint_names = joint_names_[event.leg_id_number_];
+  int index = event.joint_id_number_ - 1;
+  return (index >= 0 && index < int(leg_joint_names.size())) ? leg_joint_names[index].c_str() : "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/gait_transition.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GaitTransition::generate(const StepCycle &current_step, const StepCycle &target_step,
+                              const std::vector<int> &phases, const std::vector<int> &target_offsets,
+                              const int &transition_cycles)
+{
+  clear();
+  if (transition_cycles < 1 || phases.empty() || phases.size() != target_offsets.size())
+  {
+    return false;
+  }
+
+  // Schedules of step cycle blending and phase holding: concurrent, blend then hold and hold then blend (the latter
+  // two suiting transitions which lengthen and shorten stance periods respectively)
+  std::vector<std::vector<double>> blends(3, std::vector<double>(transition_cycles));
+  for (int i = 0; i < transition_cycles; ++i)
+  {
+    double ratio = double(i + 1) / transition_cycles;
+    blends[0][i] = ratio;
+    blends[1][i] = std::min(1.0, 2.0 * ratio);
+    blends[2][i] = std::max(0.0, 2.0 * ratio - 1.0);
+  }
+  double hold_windows[3][2] = {{0.0, 0.8}, {0.5, 0.9}, {0.0, 0.5}};
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (simulate(current_step, target_step, phases, target_offsets, blends[i], hold_windows[i][0], hold_windows[i][1]))
+    {
+      return true;
+    }
+  }
+  clear();
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GaitTransition::clear(void)
+{
+  leg_count_ = 0;
+  step_cycles_.clear();
+  cycle_index_.clear();
+  initial_phases_.clear();
+  phases_.clear();
+  velocity_scaler_ = 1.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+StepCycle GaitTransition::generateStepCycle(const int &stance_end, const int &stance_period, const int &swing_period,
+                                            const double &time_delta)
+{
+  StepCycle step;
+  step.stance_end_ = stance_end;
+  step.swing_start_ = step.stance_end_;
+  step.swing_end_ = step.swing_start_ + swing_period;
+  step.stance_start_ = step.swing_end_;
+  step.period_ = stance_period + swing_period;
+  step.stance_period_ = stance_period;
+  step.swing_period_ = swing_period;
+  step.frequency_ = 1.0 / (step.period_ * time_delta);
+  return step;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int GaitTransition::remapPhase(const StepCycle &from, const StepCycle &to, const int &phase)
+{
+  if (isSwing(from, phase))
+  {
+    double swing_progress = double(phase - from.swing_start_ + 1) / from.swing_period_;
+    int swing_iteration = roundToInt(swing_progress * to.swing_period_);
+    return to.swing_start_ + clamped(swing_iteration, 1, to.swing_period_) - 1;
+  }
+  else
+  {
+    double stance_progress = double(mod(phase - from.stance_start_, from.period_) + 1) / from.stance_period_;
+    int stance_iteration = roundToInt(stance_progress * to.stance_period_);
+    return mod(to.stance_start_ + clamped(stance_iteration, 1, to.stance_period_) - 1, to.period_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool GaitTransition::simulate(const StepCycle &current_step, const StepCycle &target_step,
+                              const std::vector<int> &phases, const std::vector<int> &target_offsets,
+                              const std::vector<double> &blend, const double &hold_start, const double &hold_end)
+{
+  clear();
+  leg_count_ = static_cast<int>(phases.size());
+  int transition_cycles = static_cast<int>(blend.size());
+
+  // Generate step cycles with stance/swing periods (and position of stance end) blended from current to target
+  double time_delta = 1.0 / (current_step.frequency_ * current_step.period_);
+  double current_stance_ratio = double(current_step.stance_end_) / current_step.stance_period_;
+  double target_stance_ratio = double(target_step.stance_end_) / target_step.stance_period_;
+  int transition_iterations = 0;
+  for (int i = 0; i < transition_cycles; ++i)
+  {
+    if (blend[i] >= 1.0 || i == transition_cycles - 1)
+    {
+      step_cycles_.push_back(target_step);
+    }
+    else
+    {
+      double stance_period = current_step.stance_period_ +
+                             blend[i] * (target_step.stance_period_ - current_step.stance_period_);
+      double swing_period = current_step.swing_period_ +
+                            blend[i] * (target_step.swing_period_ - current_step.swing_period_);
+      double stance_ratio = current_stance_ratio + blend[i] * (target_stance_ratio - current_stance_ratio);
+      int stance_end = roundToInt(stance_ratio * roundToEvenInt(stance_period));
+      step_cycles_.push_back(generateStepCycle(stance_end, roundToEvenInt(stance_period),
+                                               roundToEvenInt(swing_period), time_delta));
+    }
+    transition_iterations += step_cycles_.back().period_;
+  }
+
+  // Adjacent legs which already swing simultaneously in either gait are exempt from the support check
+  std::vector<bool> overlapping;
+  std::vector<bool> target_overlapping;
+  findSwingOverlap(current_step, phases, overlapping);
+  findSwingOverlap(target_step, target_offsets, target_overlapping);
+  for (int l = 0; l < leg_count_; ++l)
+  {
+    overlapping[l] = overlapping[l] || target_overlapping[l];
+  }
+
+  std::vector<int> leg_phases(leg_count_);
+  for (int l = 0; l < leg_count_; ++l)
+  {
+    leg_phases[l] = remapPhase(current_step, step_cycles_.front(), phases[l]);
+  }
+  initial_phases_ = leg_phases;
+
+  std::vector<int> offsets(leg_count_);
+  std::vector<int> errors(leg_count_);
+  std::vector<double> initial_errors(leg_count_, -1.0);
+  std::vector<bool> held(leg_count_, false);
+  double max_hold_density = 0.0;
+  double min_stance_ratio = 1.0;
+  int iteration = 0;
+  for (int i = 0; i < transition_cycles; ++i)
+  {
+    const StepCycle &step = step_cycles_[i];
+    std::vector<int> hold_count(leg_count_, 0);
+    min_stance_ratio = std::min(min_stance_ratio, double(target_step.stance_period_) / step.stance_period_);
+    for (int l = 0; l < leg_count_; ++l)
+    {
+      offsets[l] = mod(roundToInt(double(target_offsets[l]) * step.period_ / target_step.period_), step.period_);
+    }
+
+    for (int phase = 0; phase < step.period_; ++phase, ++iteration)
+    {
+      // Phase error of each leg is eliminated in proportion to progress through the hold window of the schedule
+      calculatePhaseErrors(step, leg_phases, offsets, errors);
+      double progress = double(iteration + 1) / transition_iterations;
+      double remaining = 1.0 - clamped((progress - hold_start) / (hold_end - hold_start), 0.0, 1.0);
+      for (int l = 0; l < leg_count_; ++l)
+      {
+        if (initial_errors[l] < 0.0)
+        {
+          initial_errors[l] = double(errors[l]) / step.period_;
+        }
+
+        // Hold phase during stance, at most every other iteration to limit extension of the stance period
+        bool stance = !isSwing(step, leg_phases[l]);
+        bool hold = (stance && !held[l] && errors[l] > roundToInt(remaining * initial_errors[l] * step.period_));
+        held[l] = hold;
+
+        // Hold phase at the end of stance whilst an adjacent leg swings such that support is maintained
+        int next_adjacent_leg = (l + 1) % leg_count_;
+        int previous_adjacent_leg = mod(l - 1, leg_count_);
+        if (stance && isSwing(step, (leg_phases[l] + 1) % step.period_) &&
+            ((isSwing(step, leg_phases[next_adjacent_leg]) && !overlapping[l]) ||
+             (isSwing(step, leg_phases[previous_adjacent_leg]) && !overlapping[previous_adjacent_leg])))
+        {
+          hold = true;
+        }
+        if (hold)
+        {
+          hold_count[l]++;
+        }
+        else
+        {
+          leg_phases[l] = (leg_phases[l] + 1) % step.period_;
+        }
+      }
+
+      // Switch to the next step cycle at the end of each step cycle
+      int cycle_index = i;
+      if (phase == step.period_ - 1 && i < transition_cycles - 1)
+      {
+        cycle_index = i + 1;
+        for (int l = 0; l < leg_count_; ++l)
+        {
+          leg_phases[l] = remapPhase(step, step_cycles_[cycle_index], leg_phases[l]);
+        }
+      }
+      cycle_index_.push_back(cycle_index);
+      phases_.insert(phases_.end(), leg_phases.begin(), leg_phases.end());
+
+      // Refuse transition if adjacent legs swing simultaneously
+      const StepCycle &next_step = step_cycles_[cycle_index];
+      for (int l = 0; l < leg_count_; ++l)
+      {
+        int adjacent_leg = (l + 1) % leg_count_;
+        if (isSwing(next_step, leg_phases[l]) && isSwing(next_step, leg_phases[adjacent_leg]) && !overlapping[l])
+        {
+          return false;
+        }
+      }
+    }
+
+    for (int l = 0; l < leg_count_; ++l)
+    {
+      max_hold_density = std::max(max_hold_density, double(hold_count[l]) / step.stance_period_);
+    }
+  }
+
+  // Refuse transition if legs have not achieved new phase offsets by the end of the requested step cycles
+  if (calculatePhaseErrors(target_step, leg_phases, target_offsets, errors) > 0)
+  {
+    return false;
+  }
+
+  // Stride length must not exceed that of the new gait despite longer (blended or held) stance periods
+  velocity_scaler_ = min_stance_ratio / (1.0 + max_hold_density);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int GaitTransition::calculatePhaseErrors(const StepCycle &step, const std::vector<int> &phases,
+                                         const std::vector<int> &offsets, std::vector<int> &errors)
+{
+  int leg_count = static_cast<int>(phases.size());
+  int reference_phase = 0;
+  int min_max_error = step.period_;
+  for (int r = 0; r < leg_count; ++r)
+  {
+    int test_reference_phase = mod(phases[r] - offsets[r], step.period_);
+    int max_error = 0;
+    for (int l = 0; l < leg_count; ++l)
+    {
+      max_error = std::max(max_error, mod(phases[l] - offsets[l] - test_reference_phase, step.period_));
+    }
+    if (max_error < min_max_error)
+    {
+      min_max_error = max_error;
+      reference_phase = test_reference_phase;
+    }
+  }
+
+  errors.resize(leg_count);
+  for (int l = 0; l < leg_count; ++l)
+  {
+    errors[l] = mod(phases[l] - offsets[l] - reference_phase, step.period_);
+  }
+  return min_max_error;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void GaitTransition::findSwingOverlap(const StepCycle &step, const std::vector<int> &phases,
+                                      std::vector<bool> &overlapping)
+{
+  int leg_count = static_cast<int>(phases.size());
+  overlapping.assign(leg_count, false);
+  for (int phase = 0; phase < step.period_; ++phase)
+  {
+    for (int l = 0; l < leg_count; ++l)
+    {
+      int adjacent_leg = (l + 1) % leg_count;
+      overlapping[l] = overlapping[l] || (isSwing(step, (phases[l] + phase) % step.period_) &&
+                                          isSwing(step, (phases[adjacent_leg] + phase) % step.period_));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
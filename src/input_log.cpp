@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/input_log.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool InputRecorder::open(const std::string &log_file, const InputLogHeader &header)
+{
+  close();
+  file_ = fopen(log_file.c_str(), "wb");
+  if (file_ == NULL)
+  {
+    ROS_WARN("\n[SHC] Unable to open input log file %s. Inputs will not be recorded.\n", log_file.c_str());
+    return false;
+  }
+  fwrite(&header, sizeof(InputLogHeader), 1, file_);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void InputRecorder::close(void)
+{
+  if (file_ != NULL)
+  {
+    fclose(file_);
+    file_ = NULL;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void InputRecorder::record(const InputRecordType &type, const uint64_t &cycle,
+                           const InputChannel &channel, const void* payload, const size_t &size)
+{
+  if (file_ == NULL)
+  {
+    return;
+  }
+
+  InputRecordHeader record;
+  record.cycle_ = cycle;
+  record.type_ = type;
+  record.channel_ = channel;
+  record.size_ = size;
+  fwrite(&record, sizeof(InputRecordHeader), 1, file_);
+  if (size > 0)
+  {
+    const uint8_t padding[INPUT_RECORD_ALIGNMENT] = { 0 };
+    fwrite(payload, size, 1, file_);
+    fwrite(padding, paddedRecordSize(size) - size, 1, file_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool InputLogReader::open(const std::string &log_file)
+{
+  close();
+  int file_descriptor = ::open(log_file.c_str(), O_RDONLY);
+  if (file_descriptor < 0)
+  {
+    ROS_ERROR("\n[SHC] Unable to open input log file %s.\n", log_file.c_str());
+    return false;
+  }
+
+  struct stat file_status;
+  bool valid = (fstat(file_descriptor, &file_status) == 0 && size_t(file_status.st_size) >= sizeof(InputLogHeader));
+  if (valid)
+  {
+    void* data = mmap(NULL, file_status.st_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (data != MAP_FAILED)
+    {
+      data_ = static_cast<const uint8_t*>(data);
+      size_ = file_status.st_size;
+      offset_ = sizeof(InputLogHeader);
+    }
+  }
+  ::close(file_descriptor);
+
+  valid = (data_ != NULL &&
+           memcmp(getHeader()->magic_, INPUT_LOG_MAGIC, sizeof(INPUT_LOG_MAGIC)) == 0 &&
+           getHeader()->version_ == INPUT_LOG_VERSION);
+  if (!valid)
+  {
+    ROS_ERROR("\n[SHC] File %s is not a valid input log (version %d).\n", log_file.c_str(), INPUT_LOG_VERSION);
+    close();
+  }
+  return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void InputLogReader::close(void)
+{
+  if (data_ != NULL)
+  {
+    munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = NULL;
+  }
+  size_ = 0;
+  offset_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool InputLogReader::next(const InputRecordHeader** record, const uint8_t** payload)
+{
+  if (data_ == NULL || size_ - offset_ < sizeof(InputRecordHeader))
+  {
+    return false;
+  }
+
+  // Records truncated at the end of the file (e.g. recording interrupted) are not read
+  const InputRecordHeader* header = reinterpret_cast<const InputRecordHeader*>(data_ + offset_);
+  size_t record_size = sizeof(InputRecordHeader) + paddedRecordSize(header->size_);
+  if (size_ - offset_ < sizeof(InputRecordHeader) + header->size_)
+  {
+    return false;
+  }
+
+  *record = header;
+  *payload = data_ + offset_ + sizeof(InputRecordHeader);
+  offset_ = std::min(size_, offset_ + record_size);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
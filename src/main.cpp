@@ -18,6 +18,7 @@
 int main(int argc, char* argv[])
 {
   ros::init(argc, argv, "shc");
+  setCoreInterface(std::make_shared<RosInterface>());
   ros::NodeHandle n;
 
   StateController state;
@@ -58,6 +59,7 @@ int main(int argc, char* argv[])
   int spin = static_cast<int>(ACQUISTION_TIME / params.time_delta.data); // Spin cycles from time
   while (spin--)
   {
+    state.updateSensorData();
     ROS_INFO_THROTTLE(THROTTLE_PERIOD, "\nAcquiring robot state . . .\n");
     // End wait if joints are intitialised or debugging in rviz (joint states will never initialise)
     if (state.jointPositionsInitialised())
@@ -85,6 +87,7 @@ int main(int argc, char* argv[])
   // Loop waiting for start button press
   while (state.getSystemState() == SUSPENDED)
   {
+    state.updateSensorData();
     if (use_default_joint_positions)
     {
       ROS_WARN_THROTTLE(THROTTLE_PERIOD, "\nFailed to initialise joint position values!\n");
@@ -98,37 +101,51 @@ int main(int argc, char* argv[])
 
   state.init(); // Must be initialised before initialising model with current joint state
   state.initModel(use_default_joint_positions);
+
+  // Stream interpolated desired joint positions from a separate thread if running in multi-rate mode
+  if (state.startOutputThread())
+  {
+    ROS_INFO("\nPublishing desired joint positions at %f Hz (control loop at %f Hz).\n",
+             params.output_rate.data, 1.0 / params.time_delta.data);
+  }
   
   tf2_ros::Buffer transform_buffer_;
   tf2_ros::TransformListener transform_listener(transform_buffer_);
 
+  // Pace main loop on absolute monotonic timeline and configure for real-time execution if running in real-time mode
+  bool real_time = params.real_time_loop.data;
+  RealTimeLoop real_time_loop(params.time_delta.data);
+  if (real_time)
+  {
+    real_time_loop.configure(params.real_time_priority.data,
+                             params.real_time_cpu.data,
+                             params.real_time_lock_memory.data);
+    ROS_INFO("\nControl loop running in real-time mode.\n");
+    real_time_loop.start();
+  }
+
   // Main loop
   while (ros::ok())
   {
-    if (state.getSystemState() != SUSPENDED)
+    // Sample sensor data received by sensor spinner thread once per cycle
+    state.updateSensorData();
+    state.runControlCycle();
+    ros::spinOnce();
+    if (real_time)
     {
-      state.loop();
-      state.publishLegState();
-      state.publishVelocity();
-      state.publishPose();
-      state.publishWalkspace();
-      state.publishRotationPoseError();
-      state.publishFrameTransforms();
-
-      if (params.debug_rviz.data)
+      int overrun_count = real_time_loop.getOverrunCount();
+      real_time_loop.sleep();
+      state.publishLoopTiming(real_time_loop);
+      if (real_time_loop.getOverrunCount() > overrun_count)
       {
-        state.RVIZDebugging();
+        ROS_WARN_THROTTLE(THROTTLE_PERIOD, "\nControl loop overran its deadline (compute time: %f s, period: %f s).\n",
+                          real_time_loop.getComputeTime(), params.time_delta.data);
       }
-
-      state.publishDesiredJointState();
     }
     else
     {
-      ROS_INFO_THROTTLE(THROTTLE_PERIOD, "\nController suspended. Press Logitech button to resume . . .\n");
+      r.sleep();
     }
-
-    ros::spinOnce();
-    r.sleep();
   }
 
   return 0;
@@ -9,13 +9,12 @@
 #include "syropod_highlevel_controller/model.h"
 #include "syropod_highlevel_controller/walk_controller.h"
 #include "syropod_highlevel_controller/pose_controller.h"
-#include "syropod_highlevel_controller/debug_visualiser.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Model::Model(const Parameters &params, std::shared_ptr<DebugVisualiser> debug_visualiser)
+Model::Model(const Parameters &params, std::shared_ptr<WorkspaceVisualiser> workspace_visualiser)
     : params_(params)
-    , debug_visualiser_(debug_visualiser)
+    , workspace_visualiser_(workspace_visualiser)
     , leg_count_(static_cast<int>(params_.leg_id.data.size()))
     , time_delta_(params_.time_delta.data)
     , current_pose_(Pose::Identity())
@@ -30,7 +29,7 @@ Model::Model(const Parameters &params, std::shared_ptr<DebugVisualiser> debug_vi
 
 Model::Model(std::shared_ptr<Model> model)
     : params_(model->params_)
-    , debug_visualiser_(model->debug_visualiser_)
+    , workspace_visualiser_(model->workspace_visualiser_)
     , leg_count_(model->leg_count_)
     , time_delta_(model->time_delta_)
     , current_pose_(model->current_pose_)
@@ -130,11 +129,31 @@ void Model::generateWorkspaces(void)
   for (leg_it = search_model->getLegContainer()->begin(); leg_it != search_model->getLegContainer()->end(); ++leg_it)
   {
     std::shared_ptr<Leg> search_leg = leg_it->second;
-    ROS_INFO("\n[SHC] Generating workspace (%d%%) . . .\n", roundToInt(100.0 * search_leg->getIDNumber() / leg_count_));
+    SHC_INFO("\n[SHC] Generating workspace (%d%%) . . .\n", roundToInt(100.0 * search_leg->getIDNumber() / leg_count_));
     std::shared_ptr<Leg> leg = leg_container_.at(search_leg->getIDNumber());
     leg->setWorkspace(search_leg->generateWorkspace());
   }
-  ROS_INFO("\n[SHC] Generating workspace (100%%) . . .\n");
+  SHC_INFO("\n[SHC] Generating workspace (100%%) . . .\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Model::startEventLog(const std::string &log_file)
+{
+  std::vector<std::string> leg_names(leg_count_);
+  std::vector<std::vector<std::string>> joint_names(leg_count_);
+  LegContainer::iterator leg_it;
+  for (leg_it = leg_container_.begin(); leg_it != leg_container_.end(); ++leg_it)
+  {
+    std::shared_ptr<Leg> leg = leg_it->second;
+    leg_names[leg->getIDNumber()] = leg->getIDName();
+    JointContainer::iterator joint_it;
+    for (joint_it = leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+    {
+      joint_names[leg->getIDNumber()].push_back(joint_it->second->id_name_);
+    }
+  }
+  return event_log_.startEventLogThread(leg_names, joint_names, log_file);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -173,7 +192,7 @@ Leg::Leg(std::shared_ptr<Model> model, const int &id_number, const Parameters &p
     , joint_count_(params_.leg_DOF.data.at(id_name_))
     , leg_state_(WALKING)
     , admittance_delta_(Eigen::Vector3d::Zero())
-    , admittance_state_(std::vector<double>(2))
+    , virtual_stiffness_(params_.virtual_stiffness.current_value)
 {
   desired_tip_pose_ = Pose::Undefined();
   desired_tip_velocity_ = Eigen::Vector3d::Zero();
@@ -195,11 +214,8 @@ Leg::Leg(std::shared_ptr<Leg> leg, std::shared_ptr<Model> model)
     , id_name_(leg->id_name_)
     , joint_count_(leg->joint_count_)
     , leg_state_(leg->leg_state_)
-    , admittance_state_(leg->admittance_state_)
 {
   model_ = (model == NULL ? leg->model_ : model);
-  leg_state_publisher_ = leg->leg_state_publisher_;
-  asc_leg_state_publisher_ = leg->asc_leg_state_publisher_;
   admittance_delta_ = leg->admittance_delta_;
   virtual_mass_ = leg->virtual_mass_;
   virtual_stiffness_ = leg->virtual_stiffness_;
@@ -249,7 +265,6 @@ void Leg::generate(std::shared_ptr<Leg> leg)
       std::shared_ptr<Joint> new_joint = joint_container_.find(old_joint->id_number_)->second;
       new_joint->current_transform_ = old_joint->current_transform_;
       new_joint->identity_transform_ = old_joint->identity_transform_;
-      new_joint->desired_position_publisher_ = old_joint->desired_position_publisher_;
       new_joint->desired_position_ = old_joint->desired_position_;
       new_joint->desired_velocity_ = old_joint->desired_velocity_;
       new_joint->desired_effort_ = old_joint->desired_effort_;
@@ -309,25 +324,14 @@ void Leg::init(const bool &use_default_joint_positions)
 Workspace Leg::generateWorkspace(void)
 {
   bool debug = params_.debug_workspace_calc.data;
-  bool display_debug_visualisation = debug && params_.debug_rviz.data;
+  bool display_debug_visualisation = debug && params_.debug_rviz.data && model_->getWorkspaceVisualiser() != NULL;
   bool workspace_generation_complete = false;
   bool simple_workspace = !params_.rough_terrain_mode.data;
 
   // Publish static transforms for visualisation purposes
   if (display_debug_visualisation)
   {
-    tf2_ros::StaticTransformBroadcaster static_broadcaster;
-    geometry_msgs::TransformStamped static_odom_ideal_to_base_link;
-    static_odom_ideal_to_base_link.header.stamp = ros::Time::now();
-    static_odom_ideal_to_base_link.header.frame_id = "odom_ideal";
-    static_odom_ideal_to_base_link.child_frame_id = "base_link";
-    static_odom_ideal_to_base_link.transform = model_->getCurrentPose().toTransformMessage();
-    static_broadcaster.sendTransform(static_odom_ideal_to_base_link);
-    geometry_msgs::TransformStamped static_base_link_to_walk_plane = static_odom_ideal_to_base_link;
-    static_base_link_to_walk_plane.header.frame_id = "base_link";
-    static_base_link_to_walk_plane.child_frame_id = "walk_plane";
-    static_base_link_to_walk_plane.transform = (~model_->getCurrentPose()).toTransformMessage();
-    static_broadcaster.sendTransform(static_base_link_to_walk_plane);
+    model_->getWorkspaceVisualiser()->publishWorkspaceFrames(model_->getCurrentPose());
   }
 
   // Init maximal/minimal workplanes
@@ -425,7 +429,7 @@ Workspace Leg::generateWorkspace(void)
     within_limits = within_limits && ik_result != 0.0;
 
     // Display debugging messages
-    ROS_DEBUG_COND(debug && search_bearing != 0,
+    SHC_DEBUG_COND(debug && search_bearing != 0,
                    "LEG: %s\tSEARCH: %f:%d:%d\tDISTANCE: %f\tIK_RESULT: %f\tWITHIN LIMITS: %s",
                    id_name_.c_str(), search_height, search_bearing,
                    iteration, distance_from_origin, ik_result, within_limits ? "TRUE" : "FALSE");
@@ -492,15 +496,10 @@ Workspace Leg::generateWorkspace(void)
         }
       }
     }
-    // Display robot model and workspace for debugging purposes
+    // Queue robot model and workspace for display by visualisation thread for debugging purposes
     if (display_debug_visualisation)
     {
-      std::shared_ptr<DebugVisualiser> debug = model_->getDebugVisualiser();
-      debug->generateRobotModel(model_);
-      debug->generateWorkspace(shared_from_this(), params_.body_clearance.data);
-      ros::Rate r(100);
-      ros::spinOnce();
-      r.sleep();
+      model_->getWorkspaceVisualiser()->pushWorkspaceSnapshot(model_, shared_from_this(), params_.body_clearance.data);
     }
     if (workspace_generation_complete)
     {
@@ -516,7 +515,8 @@ Workplane Leg::getWorkplane(const double &height)
   bool within_workspace = (height >= workspace_.begin()->first && height <= workspace_.rbegin()->first);
   if (!within_workspace)
   {
-    ROS_WARN("\n[SHC] Requested workplane does not exist within workspace.\n");
+    model_->getEventLog()->record(WORKPLANE_UNDEFINED_EVENT, id_number_, EVENT_UNDEFINED_ID, EVENT_UNDEFINED_ID,
+                                  height);
     Workplane undefined;
     return undefined;
   }
@@ -526,7 +526,7 @@ Workplane Leg::getWorkplane(const double &height)
   }
 
   // Get bounding existing workplanes within workspace
-  ROS_ASSERT(workspace_.size() > 1);
+  SHC_ASSERT(workspace_.size() > 1);
   Workspace::iterator upper_bound_it = workspace_.upper_bound(height);
   Workspace::iterator lower_bound_it = prev(upper_bound_it);
   double upper_workplane_height = setPrecision(upper_bound_it->first, 3);
@@ -604,7 +604,6 @@ void Leg::updateDefaultConfiguration(void)
 
 void Leg::generateDesiredJointStateMsg(sensor_msgs::JointState *joint_state_msg)
 {
-  joint_state_msg->header.stamp = ros::Time::now();
   JointContainer::iterator joint_it;
   for (joint_it = joint_container_.begin(); joint_it != joint_container_.end(); ++joint_it)
   {
@@ -659,24 +658,26 @@ void Leg::setDesiredTipPose(const Pose &tip_pose, bool apply_delta)
 
   desired_tip_pose_ = use_poser_tip_pose ? leg_poser_->getCurrentTipPose() : tip_pose;
   desired_tip_pose_.position_ += (apply_delta ? admittance_delta_ : Eigen::Vector3d::Zero());
-  ROS_ASSERT(desired_tip_pose_.isValid());
+  SHC_ASSERT(desired_tip_pose_.isValid());
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void Leg::calculateTipForce(void)
 {
+  CycleArena* arena = model_->getCycleArena();
+  CycleArenaScope arena_scope(arena);
   std::shared_ptr<Joint> first_joint = joint_container_.begin()->second;
 
   Eigen::Vector3d pe = tip_->getTransformFromJoint(first_joint->id_number_).block<3, 1>(0, 3);
   Eigen::Vector3d z0(0, 0, 1);
   Eigen::Vector3d p0(0, 0, 0);
 
-  Eigen::MatrixXd jacobian(6, joint_count_);
+  ArenaMatrixXd jacobian = arenaMatrix(arena, 6, joint_count_);
   jacobian.block<3, 1>(0, 0) = z0.cross(pe - p0); // Linear velocity
   jacobian.block<3, 1>(3, 0) = z0;                // Angular velocity
 
-  Eigen::VectorXd joint_torques(joint_count_);
+  ArenaVectorXd joint_torques = arenaVector(arena, joint_count_);
   joint_torques[0] = first_joint->current_effort_;
 
   // Skip first joint dh parameters since it is a fixed transformation
@@ -691,14 +692,17 @@ void Leg::calculateTipForce(void)
     joint_torques[i] = joint->current_effort_;
   }
 
-  // Transpose and invert jacobian
-  Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(joint_count_, joint_count_);
-  Eigen::MatrixXd transformation =
-      jacobian * ((jacobian.transpose() * jacobian + sqr(DLS_COEFFICIENT) * identity).inverse());
+  // Transpose and invert jacobian. Evaluated as (J*J^T + k^2*I)^-1 * J, equivalent to J * (J^T*J + k^2*I)^-1, such
+  // that the inverted matrix is of fixed size and solved without heap allocation.
+  Eigen::Matrix<double, 6, 6> damped_jacobian;
+  damped_jacobian.noalias() = jacobian * jacobian.transpose();
+  damped_jacobian += sqr(DLS_COEFFICIENT) * Eigen::Matrix<double, 6, 6>::Identity();
+  Eigen::Matrix<double, 6, 1> jacobian_torques;
+  jacobian_torques.noalias() = jacobian * joint_torques;
 
-  Eigen::VectorXd raw_tip_force_leg_frame = transformation * joint_torques;
+  Eigen::Matrix<double, 6, 1> raw_tip_force_leg_frame = damped_jacobian.inverse() * jacobian_torques;
   Eigen::Quaterniond rotation = (first_joint->getPoseJointFrame()).rotation_;
-  Eigen::VectorXd raw_tip_force = rotation._transformVector(raw_tip_force_leg_frame.block<3, 1>(0, 0));
+  Eigen::Vector3d raw_tip_force = rotation._transformVector(raw_tip_force_leg_frame.block<3, 1>(0, 0));
 
   // Low pass filter and force gain applied to calculated raw tip force
   double s = 0.15; // Smoothing Factor
@@ -723,16 +727,19 @@ void Leg::touchdownDetection(void)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-Eigen::VectorXd Leg::solveIK(const Eigen::MatrixXd &delta, const bool &solve_rotation)
+void Leg::solveIK(const Eigen::Matrix<double, 6, 1> &delta, const bool &solve_rotation,
+                  Eigen::Ref<Eigen::VectorXd> joint_position_delta)
 {
   // Calculate Jacobian from DH matrices along kinematic chain. Ref:
   // robotics.stackexchange.com/questions/2760/computing-inverse-kinematic-with-jacobian-matrices-for-6-dof-manipulator
+  CycleArena* arena = model_->getCycleArena();
+  CycleArenaScope arena_scope(arena);
   std::shared_ptr<Joint> first_joint = joint_container_.begin()->second;
   Eigen::Vector3d pe = tip_->getTransformFromJoint(first_joint->id_number_).block<3, 1>(0, 3);
   Eigen::Vector3d z0(0, 0, 1);
   Eigen::Vector3d p0(0, 0, 0);
 
-  Eigen::MatrixXd jacobian(6, joint_count_);
+  ArenaMatrixXd jacobian = arenaMatrix(arena, 6, joint_count_);
   jacobian.block<3, 1>(0, 0) = z0.cross(pe - p0);                             // Linear velocity
   jacobian.block<3, 1>(3, 0) = solve_rotation ? z0 : Eigen::Vector3d::Zero(); // Angular velocity
 
@@ -746,22 +753,25 @@ Eigen::VectorXd Leg::solveIK(const Eigen::MatrixXd &delta, const bool &solve_rot
     jacobian.block<3, 1>(3, i) = solve_rotation ? t.block<3, 1>(0, 2) : Eigen::Vector3d(0, 0, 0); // Angular velocity
   }
 
-  Eigen::MatrixXd identity = Eigen::MatrixXd::Identity(6, 6);
-  Eigen::MatrixXd jacobian_inverse(joint_count_, 6);
-  Eigen::MatrixXd j = jacobian;
-
   // Calculate jacobian inverse using damped least squares method
   // REF: Chapter 5 of Introduction to Inverse Kinematics... , Samuel R. Buss 2009
-  jacobian_inverse = j.transpose() * ((j * j.transpose() + sqr(DLS_COEFFICIENT) * identity).inverse()); //DLS Method
+  Eigen::Matrix<double, 6, 6> damped_jacobian;
+  damped_jacobian.noalias() = jacobian * jacobian.transpose();
+  damped_jacobian += sqr(DLS_COEFFICIENT) * Eigen::Matrix<double, 6, 6>::Identity();
+  Eigen::Matrix<double, 6, 6> damped_jacobian_inverse = damped_jacobian.inverse();
+  ArenaMatrixXd jacobian_inverse = arenaMatrix(arena, joint_count_, 6);
+  jacobian_inverse.noalias() = jacobian.transpose() * damped_jacobian_inverse; //DLS Method
 
   // Generate joint limit cost function and gradient
   // REF: Chapter 2.4 of Autonomous Robots - Kinematics, Path Planning and Control, Farbod. Fahimi 2008
   i = 0;
   double position_limit_cost = 0.0;
   double velocity_limit_cost = 0.0;
-  Eigen::VectorXd position_cost_gradient = Eigen::VectorXd::Zero(joint_count_);
-  Eigen::VectorXd velocity_cost_gradient = Eigen::VectorXd::Zero(joint_count_);
-  Eigen::VectorXd combined_cost_gradient = Eigen::VectorXd::Zero(joint_count_);
+  ArenaVectorXd position_cost_gradient = arenaVector(arena, joint_count_);
+  ArenaVectorXd velocity_cost_gradient = arenaVector(arena, joint_count_);
+  ArenaVectorXd combined_cost_gradient = arenaVector(arena, joint_count_);
+  position_cost_gradient.setZero();
+  velocity_cost_gradient.setZero();
   for (joint_it = joint_container_.begin(); joint_it != joint_container_.end(); ++joint_it, ++i)
   {
     std::shared_ptr<Joint> joint = joint_it->second;
@@ -787,26 +797,31 @@ Eigen::VectorXd Leg::solveIK(const Eigen::MatrixXd &delta, const bool &solve_rot
   }
   position_cost_gradient *= (position_limit_cost == 0.0 ? 0.0 : 1.0 / sqrt(position_limit_cost));
   velocity_cost_gradient *= (velocity_limit_cost == 0.0 ? 0.0 : 1.0 / sqrt(velocity_limit_cost));
-  combined_cost_gradient = interpolate(position_cost_gradient, velocity_cost_gradient, 0.75);
-
-  // Calculate joint position change
-  identity = Eigen::MatrixXd::Identity(joint_count_, joint_count_);
-  return jacobian_inverse * delta + (identity - jacobian_inverse * j) * combined_cost_gradient;
+  combined_cost_gradient = (1.0 - 0.75) * position_cost_gradient + 0.75 * velocity_cost_gradient; // Interpolate
+
+  // Calculate joint position change: J^+ * delta + (I - J^+ * J) * gradient, with the null space projection
+  // evaluated as products of vectors to avoid temporary matrices
+  Eigen::Matrix<double, 6, 1> projected_cost_gradient;
+  projected_cost_gradient.noalias() = jacobian * combined_cost_gradient;
+  joint_position_delta.noalias() = jacobian_inverse * delta;
+  joint_position_delta += combined_cost_gradient;
+  joint_position_delta.noalias() -= jacobian_inverse * projected_cost_gradient;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-double Leg::updateJointPositions(const Eigen::VectorXd &delta, const bool &simulation)
+double Leg::updateJointPositions(const Eigen::Ref<const Eigen::VectorXd> &delta, const bool &simulation)
 {
   int index = 0;
-  std::string clamping_events;
+  bool report_clamping = !params_.ignore_IK_warnings.data && !simulation;
+  EventLog* event_log = model_->getEventLog();
   double min_limit_proximity = 1.0;
   JointContainer::iterator joint_it;
   for (joint_it = joint_container_.begin(); joint_it != joint_container_.end(); ++joint_it, ++index)
   {
     std::shared_ptr<Joint> joint = joint_it->second;
     joint->desired_velocity_ = delta[index] / model_->getTimeDelta();
-    ROS_ASSERT(joint->desired_velocity_ < UNASSIGNED_VALUE);
+    SHC_ASSERT(joint->desired_velocity_ < UNASSIGNED_VALUE);
 
     // Clamp joint velocities within limits
     if (params_.clamp_joint_velocities.data && !simulation)
@@ -814,8 +829,11 @@ double Leg::updateJointPositions(const Eigen::VectorXd &delta, const bool &simul
       if (abs(joint->desired_velocity_) > joint->max_angular_speed_)
       {
         double max_velocity = joint->max_angular_speed_;
-        clamping_events += stringFormat("\n\tType: Velocity\tJoint: %s\tDesired: %f rad/s\tLimited to: %f rad/s",
-                                        joint->id_name_.c_str(), abs(joint->desired_velocity_), max_velocity);
+        if (report_clamping)
+        {
+          event_log->record(IK_VELOCITY_CLAMPING_EVENT, id_number_, joint->id_number_, EVENT_UNDEFINED_ID,
+                            abs(joint->desired_velocity_), max_velocity);
+        }
         joint->desired_velocity_ = clamped(joint->desired_velocity_, -max_velocity, max_velocity);
       }
     }
@@ -828,14 +846,20 @@ double Leg::updateJointPositions(const Eigen::VectorXd &delta, const bool &simul
     {
       if (joint->desired_position_ < joint->min_position_)
       {
-        clamping_events += stringFormat("\n\tType: Position\tJoint: %s\tDesired: %f rad\tLimited to: %f rad",
-                                        joint->id_name_.c_str(), joint->desired_position_, joint->min_position_);
+        if (report_clamping)
+        {
+          event_log->record(IK_POSITION_CLAMPING_EVENT, id_number_, joint->id_number_, EVENT_UNDEFINED_ID,
+                            joint->desired_position_, joint->min_position_);
+        }
         joint->desired_position_ = joint->min_position_;
       }
       else if (joint->desired_position_ > joint->max_position_)
       {
-        clamping_events += stringFormat("\n\tType: Position\tJoint: %s\tDesired: %f rad\tLimited to: %f rad",
-                                        joint->id_name_.c_str(), joint->desired_position_, joint->max_position_);
+        if (report_clamping)
+        {
+          event_log->record(IK_POSITION_CLAMPING_EVENT, id_number_, joint->id_number_, EVENT_UNDEFINED_ID,
+                            joint->desired_position_, joint->max_position_);
+        }
         joint->desired_position_ = joint->max_position_;
       }
     }
@@ -847,10 +871,6 @@ double Leg::updateJointPositions(const Eigen::VectorXd &delta, const bool &simul
     double half_joint_range = (joint->max_position_ - joint->min_position_) / 2.0;
     double limit_proximity = half_joint_range != 0 ? std::min(min_diff, max_diff) / half_joint_range : 1.0;
     min_limit_proximity = std::min(limit_proximity, min_limit_proximity);
-
-    // Report clamping events
-    ROS_WARN_COND(!clamping_events.empty() && !params_.ignore_IK_warnings.data && !simulation,
-                  "\nIK Clamping Event/s:%s\n", clamping_events.c_str());
   }
 
   return min_limit_proximity;
@@ -865,16 +885,18 @@ double Leg::applyIK(const bool &simulation)
   Pose leg_frame_desired_tip_pose = base_joint->getPoseJointFrame(desired_tip_pose_);
   Pose leg_frame_current_tip_pose = base_joint->getPoseJointFrame(current_tip_pose_);
   Eigen::Vector3d position_delta = leg_frame_desired_tip_pose.position_ - leg_frame_current_tip_pose.position_;
-  ROS_ASSERT(position_delta.norm() < UNASSIGNED_VALUE);
+  SHC_ASSERT(position_delta.norm() < UNASSIGNED_VALUE);
 
-  Eigen::MatrixXd delta = Eigen::Matrix<double, 6, 1>::Zero();
+  Eigen::Matrix<double, 6, 1> delta = Eigen::Matrix<double, 6, 1>::Zero();
   delta(0) = position_delta[0];
   delta(1) = position_delta[1];
   delta(2) = position_delta[2];
 
-  // Calculate change in joint positions for change in tip position
-  Eigen::VectorXd joint_position_delta(joint_count_);
-  joint_position_delta = solveIK(delta, false);
+  // Calculate change in joint positions for change in tip position (arena memory reclaimed on return as applyIK is
+  // also run outside of control cycles, e.g. during workspace generation and direct start up)
+  CycleArenaScope arena_scope(model_->getCycleArena());
+  ArenaVectorXd joint_position_delta = arenaVector(model_->getCycleArena(), joint_count_);
+  solveIK(delta, false, joint_position_delta);
 
   // Update change in joint positions for change in tip rotation to desired tip rotation if defined
   bool rotation_constrained = !desired_tip_pose_.rotation_.isApprox(UNDEFINED_ROTATION);
@@ -896,7 +918,7 @@ double Leg::applyIK(const bool &simulation)
     delta(3) = rotation_delta[0];
     delta(4) = rotation_delta[1];
     delta(5) = rotation_delta[2];
-    joint_position_delta = solveIK(delta, true);
+    solveIK(delta, true, joint_position_delta);
   }
 
   // Update Model
@@ -904,27 +926,25 @@ double Leg::applyIK(const bool &simulation)
   applyFK();
 
   // Debugging message
-  ROS_DEBUG_COND(id_number_ == 0 && params_.debug_IK.data,
+  SHC_DEBUG_COND(id_number_ == 0 && params_.debug_IK.data,
                  "\nLeg %s:\n\tDesired tip position from trajectory engine: %f:%f:%f\n\t"
                  "Resultant tip position from inverse/forward kinematics: %f:%f:%f",
                  id_name_.c_str(),
                  desired_tip_pose_.position_[0], desired_tip_pose_.position_[1], desired_tip_pose_.position_[2],
                  current_tip_pose_.position_[0], current_tip_pose_.position_[1], current_tip_pose_.position_[2]);
 
-  // Display warning messages for associated inverse kinematic deviations
-  std::string axis_label[3] = {"x", "y", "z"};
+  // Report events for associated inverse kinematic deviations
   for (int i = 0; i < 3; ++i)
   {
     Eigen::Vector3d position_error = current_tip_pose_.position_ - desired_tip_pose_.position_;
     if (abs(position_error[i]) > IK_TOLERANCE)
     {
       ik_success = 0.0;
-      ROS_WARN_COND(!simulation && !params_.ignore_IK_warnings.data,
-                    "\nInverse kinematics deviation! Calculated tip %s position of leg %s (%s: %f)"
-                    " differs from desired tip position (%s: %f)\n",
-                    axis_label[i].c_str(), id_name_.c_str(),
-                    axis_label[i].c_str(), current_tip_pose_.position_[i],
-                    axis_label[i].c_str(), desired_tip_pose_.position_[i]);
+      if (!simulation && !params_.ignore_IK_warnings.data)
+      {
+        model_->getEventLog()->record(IK_DEVIATION_EVENT, id_number_, EVENT_UNDEFINED_ID, i,
+                                      current_tip_pose_.position_[i], desired_tip_pose_.position_[i]);
+      }
     }
   }
 
@@ -982,7 +1002,7 @@ Pose Leg::applyFK(const bool &set_current, const bool &use_actual)
     current_tip_pose_ = tip_pose;
   }
 
-  ROS_ASSERT(current_tip_pose_.isValid());
+  SHC_ASSERT(current_tip_pose_.isValid());
 
   return tip_pose;
 }
@@ -1002,8 +1022,8 @@ Link::Link(std::shared_ptr<Leg> leg, std::shared_ptr<Joint> actuating_joint,
 {
   if (!params.link_parameters[leg->getIDNumber()][id_number_].initialised)
   {
-    ROS_FATAL("\nModel initialisation error for %s\n", id_name_.c_str());
-    ros::shutdown();
+    SHC_FATAL("\nModel initialisation error for %s\n", id_name_.c_str());
+    getCoreInterface()->shutdown();
   }
 }
 
@@ -1067,8 +1087,8 @@ Joint::Joint(std::shared_ptr<Leg> leg, std::shared_ptr<Link> reference_link,
   }
   else
   {
-    ROS_FATAL("\nModel initialisation error for %s\n", id_name_.c_str());
-    ros::shutdown();
+    SHC_FATAL("\nModel initialisation error for %s\n", id_name_.c_str());
+    getCoreInterface()->shutdown();
   }
 }
 
@@ -1089,8 +1109,6 @@ Joint::Joint(std::shared_ptr<Joint> joint)
   current_transform_ = joint->current_transform_;
   identity_transform_ = joint->identity_transform_;
 
-  desired_position_publisher_ = joint->desired_position_publisher_;
-
   desired_position_ = joint->desired_position_;
   desired_velocity_ = joint->desired_velocity_;
   desired_effort_ = joint->desired_effort_;
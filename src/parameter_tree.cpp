@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/parameter_tree.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool convertParameter(XmlRpc::XmlRpcValue &value, std::string* data)
+{
+  if (value.getType() != XmlRpc::XmlRpcValue::TypeString)
+  {
+    return false;
+  }
+  *data = static_cast<std::string&>(value);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool convertParameter(XmlRpc::XmlRpcValue &value, double* data)
+{
+  if (value.getType() == XmlRpc::XmlRpcValue::TypeInt)
+  {
+    *data = static_cast<int&>(value);
+    return true;
+  }
+  else if (value.getType() == XmlRpc::XmlRpcValue::TypeDouble)
+  {
+    *data = static_cast<double&>(value);
+    return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool convertParameter(XmlRpc::XmlRpcValue &value, int* data)
+{
+  if (value.getType() == XmlRpc::XmlRpcValue::TypeInt)
+  {
+    *data = static_cast<int&>(value);
+    return true;
+  }
+  else if (value.getType() == XmlRpc::XmlRpcValue::TypeDouble)
+  {
+    *data = int(std::round(static_cast<double&>(value)));
+    return true;
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool convertParameter(XmlRpc::XmlRpcValue &value, bool* data)
+{
+  if (value.getType() != XmlRpc::XmlRpcValue::TypeBoolean)
+  {
+    return false;
+  }
+  *data = static_cast<bool&>(value);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ParameterTree::fetch(const std::string &root)
+{
+  root_.clear();
+  tree_ = XmlRpc::XmlRpcValue();
+  if (!getCoreInterface()->getParameter(root, &tree_) || tree_.getType() != XmlRpc::XmlRpcValue::TypeStruct)
+  {
+    SHC_WARN("\n[SHC] Unable to fetch parameter namespace %s. Parameters will be requested individually.\n",
+             root.c_str());
+    tree_ = XmlRpc::XmlRpcValue();
+    return false;
+  }
+  root_ = root;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool ParameterTree::find(const std::string &key, XmlRpc::XmlRpcValue** value)
+{
+  // Keys outside the fetched namespace are not found within the tree
+  if (root_.empty() || key.compare(0, root_.size(), root_) != 0 || key.size() <= root_.size() ||
+      key[root_.size()] != '/')
+  {
+    return false;
+  }
+
+  // Descend the tree one namespace at a time
+  *value = &tree_;
+  size_t start = root_.size() + 1;
+  while (start <= key.size())
+  {
+    size_t end = std::min(key.find('/', start), key.size());
+    std::string name = key.substr(start, end - start);
+    if ((*value)->getType() != XmlRpc::XmlRpcValue::TypeStruct || !(*value)->hasMember(name))
+    {
+      *value = NULL;
+      return true;
+    }
+    *value = &(**value)[name];
+    start = end + 1;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -72,7 +72,7 @@ void PoseController::setAutoPoseParams(void)
     leg_poser->setNegationTransitionRatio(params_.negation_transition_ratio.data.at(leg->getIDName()));
 
     // Set reference leg for auto posing system to that which has zero phase offset
-    if (params_.offset_multiplier.data.at(leg->getIDName()) == 0)
+    if (params_.leg_offset_multiplier.at(leg->getIDNumber()) == 0)
     {
       auto_pose_reference_leg_ = leg;
     }
@@ -129,7 +129,7 @@ void PoseController::updateStance(void)
       Eigen::Quaterniond new_tip_rotation = 
         current_pose.rotation_.inverse() * leg_stepper->getCurrentTipPose().rotation_;
       Pose new_pose(new_tip_position, new_tip_rotation);
-      ROS_ASSERT(new_pose.isValid());
+      SHC_ASSERT(new_pose.isValid());
       leg_poser->setCurrentTipPose(new_pose);
     }
     // Do not apply any posing to manually manipulated legs
@@ -159,6 +159,12 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
       leg_poser->resetTransitionSequence();
       leg_poser->addTransitionPose(leg->getCurrentTipPose()); // Initial transition position
     }
+
+    // Skip generation of transition sequence if previously generated for this robot configuration
+    if (loadTransitionSequence())
+    {
+      first_sequence_execution_ = false;
+    }
   }
 
   int progress = 0; // Percentage progress (0%->100%)
@@ -209,7 +215,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
     {
       // Set horizontal target
       set_target_ = false;
-      ROS_DEBUG_COND(debug, "\nTRANSITION STEP: %d (HORIZONTAL):\n", transition_step_);
+      SHC_DEBUG_COND(debug, "\nTRANSITION STEP: %d (HORIZONTAL):\n", transition_step_);
       for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
       {
         std::shared_ptr<Leg> leg = leg_it_->second;
@@ -220,13 +226,13 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
         Eigen::Vector3d target_tip_position;
         if (leg_poser->hasTransitionPose(next_transition_step))
         {
-          ROS_DEBUG_COND(debug, "\nLeg %s targeting transition position %d.\n",
+          SHC_DEBUG_COND(debug, "\nLeg %s targeting transition position %d.\n",
                          leg->getIDName().c_str(), next_transition_step);
           target_tip_position = leg_poser->getTransitionPose(next_transition_step).position_;
         }
         else
         {
-          ROS_DEBUG_COND(debug, "\nNo transition pose found for leg %s - targeting default stance pose.\n",
+          SHC_DEBUG_COND(debug, "\nNo transition pose found for leg %s - targeting default stance pose.\n",
                          leg->getIDName().c_str());
           Eigen::Vector3d default_tip_position = leg_stepper->getDefaultTipPose().position_;
           target_tip_position = model_->getCurrentPose().inverseTransformVector(default_tip_position);
@@ -288,7 +294,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
                   joint_position_string += stringFormat("\tJoint: %s\tPosition: %f\n",
                                                         joint->id_name_.c_str(), joint->desired_position_);
                 }
-                ROS_DEBUG("\nLeg %s has completed first transition.\n"
+                SHC_DEBUG("\nLeg %s has completed first transition.\n"
                           "Optimise sequence by setting 'unpacked' joint positions to the following:\n%s", 
                           leg->getIDName().c_str(), joint_position_string.c_str());
               }
@@ -297,7 +303,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
               Pose current_tip_pose = leg_poser->getCurrentTipPose();
               Pose transition_pose = (reached_target ? target_tip_pose : current_tip_pose);
               leg_poser->addTransitionPose(transition_pose);
-              ROS_DEBUG_COND(debug, "\nAdded transition pose %d for leg %s.\n",
+              SHC_DEBUG_COND(debug, "\nAdded transition pose %d for leg %s.\n",
                              next_transition_step, leg->getIDName().c_str());
             }
           }
@@ -349,7 +355,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
     {
       // Set vertical target
       set_target_ = false;
-      ROS_DEBUG_COND(debug, "\nTRANSITION STEP: %d (VERTICAL):\n", transition_step_);
+      SHC_DEBUG_COND(debug, "\nTRANSITION STEP: %d (VERTICAL):\n", transition_step_);
       for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
       {
         std::shared_ptr<Leg> leg = leg_it_->second;
@@ -358,13 +364,13 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
         Eigen::Vector3d target_tip_position;
         if (leg_poser->hasTransitionPose(next_transition_step))
         {
-          ROS_DEBUG_COND(debug, "\nLeg %s targeting transition position %d.\n",
+          SHC_DEBUG_COND(debug, "\nLeg %s targeting transition position %d.\n",
                          leg->getIDName().c_str(), next_transition_step);
           target_tip_position = leg_poser->getTransitionPose(next_transition_step).position_;
         }
         else
         {
-          ROS_DEBUG_COND(debug, "\nNo transition position found for leg %s - targeting default stance position.\n",
+          SHC_DEBUG_COND(debug, "\nNo transition position found for leg %s - targeting default stance position.\n",
                          leg->getIDName().c_str());
           Eigen::Vector3d default_tip_position = leg_stepper->getDefaultTipPose().position_;
           target_tip_position = model_->getCurrentPose().inverseTransformVector(default_tip_position);
@@ -393,7 +399,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
       leg->setDesiredTipPose(leg_poser->getCurrentTipPose(), false);
       double limit_proximity = leg->applyIK();
       all_legs_within_workspace = all_legs_within_workspace && !(limit_proximity < safety_factor);
-      ROS_DEBUG_COND(debug && limit_proximity < safety_factor,
+      SHC_DEBUG_COND(debug && limit_proximity < safety_factor,
                      "\nLeg %s exceeded safety factor\n", leg->getIDName().c_str());
     }
 
@@ -412,7 +418,7 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
           Pose current_tip_pose = leg_poser->getCurrentTipPose();
           Pose transition_pose = (reached_target ? target_tip_pose : current_tip_pose);
           leg_poser->addTransitionPose(transition_pose);
-          ROS_DEBUG_COND(debug, "\nAdded transition position %d for leg %s.\n",
+          SHC_DEBUG_COND(debug, "\nAdded transition position %d for leg %s.\n",
                          next_transition_step, leg->getIDName().c_str());
         }
       }
@@ -437,13 +443,17 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
   // Check for excessive transition steps
   if (transition_step_ > TRANSITION_STEP_THRESHOLD)
   {
-    ROS_FATAL("\nUnable to execute sequence, shutting down controller.\n");
-    ros::shutdown();
+    SHC_FATAL("\nUnable to execute sequence, shutting down controller.\n");
+    getCoreInterface()->shutdown();
   }
 
   // Check if sequence has completed
   if (sequence_complete)
   {
+    if (first_sequence_execution_ && sequence == START_UP)
+    {
+      saveTransitionSequence();
+    }
     set_target_ = true;
     vertical_transition_complete_ = false;
     horizontal_transition_complete_ = false;
@@ -460,6 +470,171 @@ int PoseController::executeSequence(const SequenceSelection& sequence)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+uint64_t PoseController::generateTransitionCacheKey(void)
+{
+  std::vector<double> configuration;
+  for (int l = 0; l < model_->getLegCount(); ++l)
+  {
+    std::shared_ptr<Leg> leg = model_->getLegByIDNumber(l);
+    for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
+    {
+      std::shared_ptr<Joint> joint = joint_it_->second;
+      configuration.push_back(joint->min_position_);
+      configuration.push_back(joint->max_position_);
+      configuration.push_back(joint->unpacked_position_);
+    }
+    LinkContainer::iterator link_it;
+    for (link_it = leg->getLinkContainer()->begin(); link_it != leg->getLinkContainer()->end(); ++link_it)
+    {
+      std::shared_ptr<Link> link = link_it->second;
+      configuration.push_back(link->dh_parameter_r_);
+      configuration.push_back(link->dh_parameter_theta_);
+      configuration.push_back(link->dh_parameter_d_);
+      configuration.push_back(link->dh_parameter_alpha_);
+    }
+    Eigen::Vector3d default_tip_position = leg->getLegStepper()->getDefaultTipPose().position_;
+    configuration.insert(configuration.end(), default_tip_position.data(), default_tip_position.data() + 3);
+  }
+  configuration.push_back(SAFETY_FACTOR);
+
+  // FNV-1a hash of configuration values
+  uint64_t key = 14695981039346656037ULL;
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(configuration.data());
+  for (size_t i = 0; i < configuration.size() * sizeof(double); ++i)
+  {
+    key = (key ^ data[i]) * 1099511628211ULL;
+  }
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool PoseController::loadTransitionSequence(void)
+{
+  std::string cache_file = params_.transition_cache_file.data;
+  FILE* file = cache_file.empty() ? NULL : fopen(cache_file.c_str(), "rb");
+  if (file == NULL)
+  {
+    return false;
+  }
+
+  // Read header and transition poses of all legs before validating against current robot configuration
+  TransitionCacheHeader header;
+  int leg_count = model_->getLegCount();
+  bool valid = (fread(&header, sizeof(TransitionCacheHeader), 1, file) == 1 &&
+                memcmp(header.magic_, TRANSITION_CACHE_MAGIC, sizeof(TRANSITION_CACHE_MAGIC)) == 0 &&
+                header.version_ == TRANSITION_CACHE_VERSION &&
+                int(header.leg_count_) == leg_count &&
+                header.transition_step_count_ > 0 &&
+                header.transition_step_count_ <= TRANSITION_STEP_THRESHOLD);
+  std::vector<double> poses;
+  if (valid)
+  {
+    poses.resize(leg_count * (header.transition_step_count_ + 1) * 7);
+    valid = (fread(poses.data(), sizeof(double), poses.size(), file) == poses.size());
+  }
+  fclose(file);
+
+  if (!valid)
+  {
+    SHC_WARN("\n[SHC] Transition cache file %s is invalid. Transition sequence will be regenerated.\n",
+             cache_file.c_str());
+    return false;
+  }
+  else if (header.configuration_key_ != generateTransitionCacheKey())
+  {
+    SHC_INFO("\n[SHC] Robot configuration has changed since transition sequence was cached. "
+             "Transition sequence will be regenerated.\n");
+    return false;
+  }
+
+  // Cached sequence is only valid if starting from the initial tip positions for which it was generated
+  int pose_count = header.transition_step_count_ + 1;
+  for (int l = 0; l < leg_count; ++l)
+  {
+    std::shared_ptr<Leg> leg = model_->getLegByIDNumber(l);
+    Eigen::Vector3d initial_tip_position = Eigen::Map<Eigen::Vector3d>(&poses[l * pose_count * 7]);
+    if ((initial_tip_position - leg->getCurrentTipPose().position_).norm() > TIP_TOLERANCE)
+    {
+      SHC_INFO("\n[SHC] Leg %s is not at initial tip position of cached transition sequence. "
+               "Transition sequence will be regenerated.\n", leg->getIDName().c_str());
+      return false;
+    }
+  }
+
+  for (int l = 0; l < leg_count; ++l)
+  {
+    std::shared_ptr<LegPoser> leg_poser = model_->getLegByIDNumber(l)->getLegPoser();
+    for (int i = 1; i < pose_count; ++i)
+    {
+      const double* pose = &poses[(l * pose_count + i) * 7];
+      leg_poser->addTransitionPose(Pose(Eigen::Vector3d(pose[0], pose[1], pose[2]),
+                                        Eigen::Quaterniond(pose[3], pose[4], pose[5], pose[6])));
+    }
+  }
+  transition_step_count_ = header.transition_step_count_;
+  SHC_INFO("\n[SHC] Loaded transition sequence (%d transition steps) from %s.\n",
+           transition_step_count_, cache_file.c_str());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void PoseController::saveTransitionSequence(void)
+{
+  std::string cache_file = params_.transition_cache_file.data;
+  if (cache_file.empty())
+  {
+    return;
+  }
+
+  // Each leg requires a transition pose for every transition step (and initial transition pose)
+  TransitionCacheHeader header;
+  header.leg_count_ = model_->getLegCount();
+  header.transition_step_count_ = transition_step_count_;
+  header.configuration_key_ = generateTransitionCacheKey();
+  std::vector<double> poses;
+  for (int l = 0; l < model_->getLegCount(); ++l)
+  {
+    std::shared_ptr<LegPoser> leg_poser = model_->getLegByIDNumber(l)->getLegPoser();
+    if (!leg_poser->hasTransitionPose(transition_step_count_) ||
+        leg_poser->hasTransitionPose(transition_step_count_ + 1))
+    {
+      SHC_WARN("\n[SHC] Incomplete transition sequence will not be cached.\n");
+      return;
+    }
+    for (int i = 0; i <= transition_step_count_; ++i)
+    {
+      Pose pose = leg_poser->getTransitionPose(i);
+      poses.insert(poses.end(), pose.position_.data(), pose.position_.data() + 3);
+      poses.push_back(pose.rotation_.w());
+      poses.push_back(pose.rotation_.x());
+      poses.push_back(pose.rotation_.y());
+      poses.push_back(pose.rotation_.z());
+    }
+  }
+
+  FILE* file = fopen(cache_file.c_str(), "wb");
+  bool saved = (file != NULL &&
+                fwrite(&header, sizeof(TransitionCacheHeader), 1, file) == 1 &&
+                fwrite(poses.data(), sizeof(double), poses.size(), file) == poses.size());
+  if (file != NULL)
+  {
+    saved = (fclose(file) == 0) && saved;
+  }
+  if (saved)
+  {
+    SHC_INFO("\n[SHC] Saved transition sequence (%d transition steps) to %s.\n",
+             transition_step_count_, cache_file.c_str());
+  }
+  else
+  {
+    SHC_WARN("\n[SHC] Unable to save transition sequence to %s.\n", cache_file.c_str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 int PoseController::directStartup(void) // Simultaneous leg coordination
 {
   int progress = 0; // Percentage progress (0%->100%)
@@ -815,7 +990,7 @@ void PoseController::updateCurrentPose(const RobotState& robot_state)
   // Pose body at clearance offset normal to walk plane and rotate to align parallel
   updateWalkPlanePose();
   new_pose = new_pose.addPose(walk_plane_pose_);
-  ROS_ASSERT(walk_plane_pose_.isValid());
+  SHC_ASSERT(walk_plane_pose_.isValid());
   model_->setDefaultPose(walk_plane_pose_);
 
   // Manually set (joystick controlled) body pose
@@ -854,7 +1029,7 @@ void PoseController::updateCurrentPose(const RobotState& robot_state)
     //new_pose = new_pose.addPose(ik_error_pose_);
   }
   
-  ROS_ASSERT(new_pose.isValid());
+  SHC_ASSERT(new_pose.isValid());
   model_->setCurrentPose(new_pose);
 }
 
@@ -867,12 +1042,8 @@ void PoseController::updateManualPose(void)
   Eigen::Vector3d current_rotation = quaternionToEulerAngles(manual_pose_.rotation_, true);
   Eigen::Vector3d default_position = default_pose_.position_;
   Eigen::Vector3d default_rotation = quaternionToEulerAngles(default_pose_.rotation_, true);
-  Eigen::Vector3d max_position(params_.max_translation.data.at("x"),
-                        params_.max_translation.data.at("y"),
-                        params_.max_translation.data.at("z"));
-  Eigen::Vector3d max_rotation(params_.max_rotation.data.at("roll"),
-                        params_.max_rotation.data.at("pitch"),
-                        params_.max_rotation.data.at("yaw"));
+  const Eigen::Vector3d &max_position = params_.max_translation_limit;
+  const Eigen::Vector3d &max_rotation = params_.max_rotation_limit;
 
   Eigen::Vector3d translation_limit(0, 0, 0);
   Eigen::Vector3d rotation_limit(0, 0, 0);
@@ -1059,14 +1230,12 @@ void PoseController::updateTipAlignPose(void)
       Eigen::Vector3d target_translation = current_walk_plane_aligned_translation + translation_to_alignment;
 
       // Clamp target translation within limits
-      Eigen::Vector3d limit(params_.max_translation.data.at("x"),
-                     params_.max_translation.data.at("y"),
-                     params_.max_translation.data.at("z"));
+      const Eigen::Vector3d &limit = params_.max_translation_limit;
       target_translation = clamped(target_translation, limit);
 
       // Interpolate between origin tip align pose and calculated target translation
       double c = smoothStep(swing_progress); // Control input (0.0 -> 1.0)
-      ROS_ASSERT(c >= 0.0 && c <= 1.0); 
+      SHC_ASSERT(c >= 0.0 && c <= 1.0); 
       if (swing_progress < 0.5)
       {
         c = smoothStep(c * 2.0); // 0.0:0.5 -> 0.0:1.0
@@ -1122,7 +1291,7 @@ void PoseController::updateWalkPlanePose(void)
   
   // Interpolate walk plane pose as transitioning from old to new.
   walk_plane_pose_ = origin_walk_plane_pose_.interpolate(c, new_walk_plane_pose);
-  ROS_ASSERT(walk_plane_pose_.isValid());
+  SHC_ASSERT(walk_plane_pose_.isValid());
   if (c == 1.0)
   {
     origin_walk_plane_pose_ = walk_plane_pose_;
@@ -1196,9 +1365,9 @@ void PoseController::updateIMUPose(void)
   Eigen::Quaterniond rotation_error = (current_rotation * target_rotation.inverse()).normalized();
 
   // PID gains
-  double kp = params_.rotation_pid_gains.data.at("p");
-  double ki = params_.rotation_pid_gains.data.at("i");
-  double kd = params_.rotation_pid_gains.data.at("d");
+  double kp = params_.rotation_gains.p;
+  double ki = params_.rotation_gains.i;
+  double kd = params_.rotation_gains.d;
 
   rotation_position_error_ = quaternionToEulerAngles(rotation_error);
   rotation_position_error_[2] = 0.0;
@@ -1219,16 +1388,16 @@ void PoseController::updateIMUPose(void)
                                     kp * rotation_position_error_ +
                                     ki * rotation_absement_error_);
   
-  double max_roll = params_.max_rotation.data.at("roll");
-  double max_pitch = params_.max_rotation.data.at("pitch");
+  double max_roll = params_.max_rotation_limit[0];
+  double max_pitch = params_.max_rotation_limit[1];
   rotation_correction[0] = clamped(rotation_correction[0], -max_roll, max_roll);
   rotation_correction[1] = clamped(rotation_correction[1], -max_pitch, max_pitch);
   rotation_correction[2] = quaternionToEulerAngles(target_rotation)[2];  // No compensation in yaw rotation
 
   if (rotation_correction.norm() > STABILITY_THRESHOLD)
   {
-    ROS_FATAL("IMU rotation compensation became unstable! Adjust PID parameters.\n");
-    ros::shutdown();
+    SHC_FATAL("IMU rotation compensation became unstable! Adjust PID parameters.\n");
+    getCoreInterface()->shutdown();
   }
 
   imu_pose_.rotation_ = eulerAnglesToQuaternion(rotation_correction);
@@ -1249,8 +1418,8 @@ void PoseController::updateInclinationPose(void)
   double longitudinal_correction = -body_height * tan(euler[1]);
   double lateral_correction = body_height * tan(euler[0]);
 
-  double max_translation_x = params_.max_translation.data.at("x");
-  double max_translation_y = params_.max_translation.data.at("y");
+  double max_translation_x = params_.max_translation_limit[0];
+  double max_translation_y = params_.max_translation_limit[1];
   longitudinal_correction = clamped(longitudinal_correction, -max_translation_x, max_translation_x);
   lateral_correction = clamped(lateral_correction, -max_translation_y, max_translation_y);
 
@@ -1308,8 +1477,8 @@ void PoseController::calculateDefaultPose(void)
         }
       }
 
-      double max_translation_x = params_.max_translation.data.at("x");
-      double max_translation_y = params_.max_translation.data.at("y");
+      double max_translation_x = params_.max_translation_limit[0];
+      double max_translation_y = params_.max_translation_limit[1];
       zero_moment_offset /= legs_loaded;
       zero_moment_offset[0] = clamped(zero_moment_offset[0], -max_translation_x, max_translation_x);
       zero_moment_offset[1] = clamped(zero_moment_offset[1], -max_translation_y, max_translation_y);
@@ -1423,7 +1592,7 @@ Pose AutoPoser::updatePose(int phase)
 
     return_pose = Pose(position, eulerAnglesToQuaternion(rotation));
 
-    ROS_DEBUG_COND(false,
+    SHC_DEBUG_COND(false,
                    "AUTOPOSE_DEBUG %d - ITERATION: %d\t\t"
                    "TIME: %f\t\t"
                    "ORIGIN: %f:%f:%f\t\t"
@@ -1491,7 +1660,7 @@ int LegPoser::transitionConfiguration(const double& transition_time)
     for (joint_it = leg_->getJointContainer()->begin(); joint_it != leg_->getJointContainer()->end(); ++joint_it, ++i)
     {
       std::shared_ptr<Joint> joint = joint_it->second;
-      ROS_ASSERT(desired_configuration_.name[i] == joint->id_name_);
+      SHC_ASSERT(desired_configuration_.name[i] == joint->id_name_);
       bool joint_at_target = abs(desired_configuration_.position[i] - joint->desired_position_) < JOINT_TOLERANCE;
       all_joints_at_target = all_joints_at_target && joint_at_target;
 
@@ -1545,7 +1714,7 @@ int LegPoser::transitionConfiguration(const double& transition_time)
       current_string += stringFormat("%f\t", new_configuration.position[i]);
       target_string += stringFormat("%f\t", desired_configuration_.position[i]);
     }
-    ROS_DEBUG("\nTRANSITION CONFIGURATION DEBUG:\n"
+    SHC_DEBUG("\nTRANSITION CONFIGURATION DEBUG:\n"
               "\tMASTER ITERATION: %d\n\tTIME: %f\n\tORIGIN: %s\n\tCURRENT: %s\n\tTARGET: %s\n",
               master_iteration_count_, time, origin_string.c_str(), current_string.c_str(), target_string.c_str());
   }
@@ -1684,7 +1853,7 @@ int LegPoser::stepToPosition(const Pose& target_tip_pose, const Pose& target_pos
     current_tip_pose_.rotation_ = new_tip_rotation;
   }
 
-  ROS_DEBUG_COND(poser_->getParameters().debug_stepToPosition.data && leg_->getIDNumber() == 0,
+  SHC_DEBUG_COND(poser_->getParameters().debug_stepToPosition.data && leg_->getIDNumber() == 0,
                  "STEP_TO_POSITION DEBUG - LEG: %s\t\t"
                  "MASTER ITERATION: %d\t\t"
                  "TIME INPUT: %f\t\t"
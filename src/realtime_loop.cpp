@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/realtime_loop.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#define NSEC_PER_SEC 1000000000L ///< Nanoseconds per second
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+RealTimeLoop::RealTimeLoop(const double &period)
+  : period_nsec_(static_cast<long>(period * NSEC_PER_SEC))
+{
+  SHC_ASSERT(period_nsec_ > 0);
+  start();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool RealTimeLoop::configure(const int &priority, const int &cpu, const bool &lock_memory)
+{
+  bool success = true;
+
+  // Lock all current and future memory to prevent page faults during control cycles
+  if (lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+  {
+    SHC_WARN("\n[SHC] Failed to lock process memory (%s).\n", strerror(errno));
+    success = false;
+  }
+
+  // Pin calling thread to requested CPU core
+  if (cpu >= 0)
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    int result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+    if (result != 0)
+    {
+      SHC_WARN("\n[SHC] Failed to set control loop CPU affinity to core %d (%s).\n", cpu, strerror(result));
+      success = false;
+    }
+  }
+
+  // Set calling thread to real-time FIFO scheduling at requested priority
+  if (priority > 0)
+  {
+    sched_param scheduling_parameters;
+    scheduling_parameters.sched_priority = priority;
+    int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &scheduling_parameters);
+    if (result != 0)
+    {
+      SHC_WARN("\n[SHC] Failed to set control loop SCHED_FIFO priority to %d (%s).\n", priority, strerror(result));
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeLoop::start(void)
+{
+  clock_gettime(CLOCK_MONOTONIC, &scheduled_start_);
+  cycle_start_ = scheduled_start_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeLoop::sleep(void)
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  compute_time_ = timeDifference(now, cycle_start_);
+  max_compute_time_ = std::max(max_compute_time_, compute_time_);
+
+  // Schedule next cycle, skipping any cycles whose scheduled start has already passed
+  advance(&scheduled_start_);
+  if (timeDifference(now, scheduled_start_) > 0.0)
+  {
+    overrun_count_++;
+    while (timeDifference(now, scheduled_start_) > 0.0)
+    {
+      advance(&scheduled_start_);
+      skipped_cycle_count_++;
+    }
+  }
+
+  // Sleep until scheduled start of next cycle on absolute timeline (resuming if interrupted by signal)
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &scheduled_start_, NULL) == EINTR)
+  {
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &cycle_start_);
+  jitter_ = timeDifference(cycle_start_, scheduled_start_);
+  max_jitter_ = std::max(max_jitter_, jitter_);
+  jitter_sum_ += jitter_;
+  cycle_count_++;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeLoop::resetStatistics(void)
+{
+  cycle_count_ = 0;
+  overrun_count_ = 0;
+  skipped_cycle_count_ = 0;
+  max_jitter_ = 0.0;
+  jitter_sum_ = 0.0;
+  max_compute_time_ = 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double RealTimeLoop::timeDifference(const timespec &end, const timespec &start)
+{
+  return (end.tv_sec - start.tv_sec) + static_cast<double>(end.tv_nsec - start.tv_nsec) / NSEC_PER_SEC;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RealTimeLoop::advance(timespec* time)
+{
+  time->tv_nsec += period_nsec_;
+  while (time->tv_nsec >= NSEC_PER_SEC)
+  {
+    time->tv_nsec -= NSEC_PER_SEC;
+    time->tv_sec++;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
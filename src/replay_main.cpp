@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/state_controller.h"
+
+#include <chrono>
+#include <cinttypes>
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Replay entry point. Drives a state controller cycle by cycle, as fast as possible, from an input log recorded via
+/// the input_record_file parameter and verifies the desired joint positions of each cycle against those recorded.
+/// Parameters must be loaded as they were for the recording. Usage: shc_replay <input_log_file> [tolerance]
+/// where a tolerance of zero (default) requires bitwise identical desired joint positions. Returns non-zero if the
+/// input log is invalid or any cycle deviates from the recording by more than the tolerance.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+  ros::init(argc, argv, "shc_replay");
+  setCoreInterface(std::make_shared<RosInterface>());
+  ros::NodeHandle n;
+
+  if (argc < 2)
+  {
+    ROS_ERROR("\nUsage: shc_replay <input_log_file> [tolerance]\n");
+    return 1;
+  }
+  std::string log_file = argv[1];
+  double tolerance = (argc > 2) ? atof(argv[2]) : 0.0;
+
+  InputLogReader reader;
+  if (!reader.open(log_file))
+  {
+    return 1;
+  }
+
+  // Replayed inputs must not be recorded again (which would also truncate a mapped input log of the same name)
+  n.setParam("syropod/parameters/input_record_file", std::string());
+  n.setParam("syropod/parameters/transition_cache_file", std::string());
+  StateController state;
+  if (!state.startReplay(*reader.getHeader()))
+  {
+    return 1;
+  }
+
+  const InputRecordHeader* record;
+  const uint8_t* payload;
+  long cycle_count = 0;
+  long output_count = 0;
+  long deviation_count = 0;
+  double max_deviation = 0.0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  while (ros::ok() && reader.next(&record, &payload))
+  {
+    if (record->type_ == OUTPUT_RECORD)
+    {
+      double deviation = state.calculateOutputDeviation(*record, payload);
+      if (deviation > tolerance && deviation_count++ == 0)
+      {
+        ROS_ERROR("\nReplay deviates from recording in cycle %" PRIu64 " (desired joint position deviation: %g).\n",
+                  record->cycle_, deviation);
+      }
+      max_deviation = std::max(max_deviation, deviation);
+      output_count++;
+    }
+    else if (!state.replayInput(*record, payload))
+    {
+      ROS_ERROR("\nInvalid record (type %d, channel %d) in cycle %" PRIu64 " of input log %s.\n",
+                record->type_, record->channel_, record->cycle_, log_file.c_str());
+      return 1;
+    }
+    else if (record->type_ == CONTROL_CYCLE_RECORD)
+    {
+      cycle_count++;
+    }
+  }
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  if (reader.getRemaining() > 0)
+  {
+    ROS_WARN("\nInput log %s ends with a truncated record (%zu bytes) which was not replayed.\n",
+             log_file.c_str(), reader.getRemaining());
+  }
+  ROS_INFO("\nReplayed %ld cycles in %f s (%f cycles/s). %ld of %ld cycles deviated from recording by more than %g "
+           "(max deviation: %g).\n", cycle_count, elapsed, cycle_count / std::max(elapsed, 1e-9),
+           deviation_count, output_count, tolerance, max_deviation);
+
+  return deviation_count > 0 ? 1 : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
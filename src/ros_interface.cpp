@@ -0,0 +1,92 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/ros_interface.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool RosInterface::getParameter(const std::string &key, XmlRpc::XmlRpcValue* value)
+{
+  ros::NodeHandle n;
+  return n.getParam(key, *value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool RosInterface::isLogEnabled(const LogLevel &level)
+{
+  // Only debug messages are disabled by default, hence only the debug level is checked before formatting. Messages of
+  // other levels are filtered by rosconsole when logged.
+  if (level != DEBUG_LOG_LEVEL)
+  {
+    return true;
+  }
+  ROSCONSOLE_DEFINE_LOCATION(true, ros::console::levels::Debug, ROSCONSOLE_DEFAULT_NAME);
+  return __rosconsole_define_location__enabled;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Prints a message via rosconsole at the given source location, as per ROS_LOG but with the file, line and function
+/// of the caller of the core library logging macros rather than of this file.
+#define ROS_PRINT_AT_LOCATION(ros_level, file, line, function, message)                                                \
+  do                                                                                                                   \
+  {                                                                                                                    \
+    ROSCONSOLE_DEFINE_LOCATION(true, ros_level, ROSCONSOLE_DEFAULT_NAME);                                              \
+    if (ROS_UNLIKELY(__rosconsole_define_location__enabled))                                                           \
+    {                                                                                                                  \
+      ros::console::print(NULL, __rosconsole_define_location__loc.logger_, __rosconsole_define_location__loc.level_,   \
+                          file, line, function, "%s", message);                                                        \
+    }                                                                                                                  \
+  } while (false)
+
+void RosInterface::log(const LogLevel &level, const char* file, const int &line, const char* function,
+                       const char* message)
+{
+  switch (level)
+  {
+    case (DEBUG_LOG_LEVEL):
+      ROS_PRINT_AT_LOCATION(ros::console::levels::Debug, file, line, function, message);
+      break;
+    case (INFO_LOG_LEVEL):
+      ROS_PRINT_AT_LOCATION(ros::console::levels::Info, file, line, function, message);
+      break;
+    case (WARN_LOG_LEVEL):
+      ROS_PRINT_AT_LOCATION(ros::console::levels::Warn, file, line, function, message);
+      break;
+    case (ERROR_LOG_LEVEL):
+      ROS_PRINT_AT_LOCATION(ros::console::levels::Error, file, line, function, message);
+      break;
+    default:
+      ROS_PRINT_AT_LOCATION(ros::console::levels::Fatal, file, line, function, message);
+      break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double RosInterface::now(void)
+{
+  return ros::Time::now().toSec();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool RosInterface::ok(void)
+{
+  return ros::ok();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RosInterface::shutdown(void)
+{
+  ros::shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -8,6 +8,9 @@
 
 #include "syropod_highlevel_controller/state_controller.h"
 
+#include <pthread.h>
+#include <sched.h>
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 StateController::StateController(void)
@@ -17,13 +20,24 @@ StateController::StateController(void)
   // Get parameters from parameter server and initialises parameter map
   initParameters();
 
+  // Configure guard against heap allocations in RUNNING loop
+  allocation_guard_mode_ = allocationGuardModeFromName(params_.allocation_guard.data);
+  if (allocation_guard_mode_ != ALLOCATION_GUARD_OFF && !allocationTrackingEnabled())
+  {
+    ROS_WARN("\nAllocation guard requested but heap allocation tracking is not compiled in. Rebuild with "
+             "-DSHC_TRACK_ALLOCATIONS=ON to enable the allocation guard.\n");
+  }
+
   // Create robot model
-  std::shared_ptr<DebugVisualiser> debug_visualiser_ptr =
-      std::allocate_shared<DebugVisualiser>(Eigen::aligned_allocator<DebugVisualiser>(), debug_visualiser_);
-  model_ = std::allocate_shared<Model>(Eigen::aligned_allocator<Model>(), params_, debug_visualiser_ptr);
+  debug_visualiser_ = std::allocate_shared<DebugVisualiser>(Eigen::aligned_allocator<DebugVisualiser>());
+  model_ = std::allocate_shared<Model>(Eigen::aligned_allocator<Model>(), params_, debug_visualiser_);
   model_->generate();
+  model_->startEventLog(params_.event_log_file.data);
 
-  debug_visualiser_.setTimeDelta(params_.time_delta.data);
+  debug_visualiser_->setTimeDelta(params_.time_delta.data);
+  debug_visualiser_->setStreamRates(params_.debug_rviz_rates.data);
+  admittance_ =
+    std::allocate_shared<AdmittanceController>(Eigen::aligned_allocator<AdmittanceController>(), model_, params_);
   transform_listener_ =
       std::allocate_shared<tf2_ros::TransformListener>(Eigen::aligned_allocator<tf2_ros::TransformListener>(),
                                                        transform_buffer_);
@@ -79,16 +93,65 @@ StateController::StateController(void)
                                             &StateController::targetTipPoseCallback, this);
   plan_step_request_publisher_ = n.advertise<std_msgs::Int8>("shc/plan_step_request", 1000);
 
-  // Motor and other sensor topic subscriptions
-  imu_data_subscriber_ = n.subscribe("imu/data", 1, &StateController::imuCallback, this);
-  joint_state_subscriber_ = n.subscribe("joint_states", 100, &StateController::jointStatesCallback, this);
-  tip_state_subscriber_ = n.subscribe("tip_states", 1, &StateController::tipStatesCallback, this);
+  // Index joints and legs for passing sensor data between sensor spinner thread and control loop
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    sensor_leg_indices_[leg->getIDName()] = leg->getIDNumber();
+    for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
+    {
+      std::shared_ptr<Joint> joint = joint_it_->second;
+      sensor_joint_indices_[joint->id_name_] = sensor_joints_.size();
+      sensor_joints_.push_back(joint);
+    }
+  }
+  int joint_count = sensor_joints_.size();
+  int leg_count = model_->getLegCount();
+  sensor_input_.joint_position_ = Eigen::ArrayXd::Constant(joint_count, UNASSIGNED_VALUE);
+  sensor_input_.joint_velocity_ = Eigen::ArrayXd::Constant(joint_count, UNASSIGNED_VALUE);
+  sensor_input_.joint_effort_ = Eigen::ArrayXd::Constant(joint_count, UNASSIGNED_VALUE);
+  sensor_input_.wrench_count_ = Eigen::Array<uint, Eigen::Dynamic, 1>::Zero(leg_count);
+  sensor_input_.tip_force_ = Eigen::Array<double, 3, Eigen::Dynamic>::Zero(3, leg_count);
+  sensor_input_.tip_torque_ = Eigen::Array<double, 3, Eigen::Dynamic>::Zero(3, leg_count);
+  sensor_input_.step_plane_count_ = Eigen::Array<uint, Eigen::Dynamic, 1>::Zero(leg_count);
+  sensor_input_.step_plane_ = Eigen::Array<double, 3, Eigen::Dynamic>::Zero(3, leg_count);
+  sensor_sample_ = sensor_input_;
+  applied_wrench_count_ = sensor_input_.wrench_count_;
+  applied_step_plane_count_ = sensor_input_.step_plane_count_;
+  sensor_data_.reset(sensor_input_);
+
+  // Record inputs consumed by the control thread for deterministic replay
+  record_buffer_.resize(SENSOR_RECORD_IMU_SIZE + 3 * joint_count + SENSOR_RECORD_LEG_SIZE * leg_count);
+  if (!params_.input_record_file.data.empty())
+  {
+    InputLogHeader header;
+    header.joint_count_ = joint_count;
+    header.leg_count_ = leg_count;
+    header.time_delta_ = params_.time_delta.data;
+    if (input_recorder_.open(params_.input_record_file.data, header))
+    {
+      ROS_INFO("\n[SHC] Recording controller inputs to %s.\n", params_.input_record_file.data.c_str());
+
+      // Start up sequence must be generated as it will be on replay rather than loaded from transition cache
+      params_.transition_cache_file.data.clear();
+    }
+  }
+
+  // Motor and other sensor topic subscriptions (serviced by sensor spinner thread)
+  ros::NodeHandle sensor_n;
+  sensor_n.setCallbackQueue(&sensor_callback_queue_);
+  imu_data_subscriber_ = sensor_n.subscribe("imu/data", 1, &StateController::imuCallback, this);
+  joint_state_subscriber_ = sensor_n.subscribe("joint_states", 100, &StateController::jointStatesCallback, this);
+  tip_state_subscriber_ = sensor_n.subscribe("tip_states", 1, &StateController::tipStatesCallback, this);
 
   // Set up debugging publishers
   velocity_publisher_ = n.advertise<geometry_msgs::Twist>("shc/velocity", 1000);
   pose_publisher_ = n.advertise<geometry_msgs::Twist>("shc/pose", 1000);
   walkspace_publisher_ = n.advertise<std_msgs::Float32MultiArray>("shc/walkspace", 1000);
   rotation_pose_error_publisher_ = n.advertise<std_msgs::Float32MultiArray>("shc/rotation_pose_error", 1000);
+  loop_timing_publisher_ = n.advertise<std_msgs::Float32MultiArray>("shc/loop_timing", 1000);
+  timing_diagnostics_publisher_ = n.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 1);
+  leg_states_publisher_ = n.advertise<syropod_highlevel_controller::LegStateArray>("shc/leg_states", 1000);
 
   // Set up combined desired joint state publisher
   if (params_.combined_control_interface.data)
@@ -96,30 +159,65 @@ StateController::StateController(void)
     desired_joint_state_publisher_ = n.advertise<sensor_msgs::JointState>("desired_joint_states", 1);
   }
 
-  // Set up individual leg state and desired joint state publishers within leg objects
+  // Set up individual leg state and desired joint state publishers of each leg
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
     std::string topic_name = "shc/" + leg->getIDName() + "/state";
-    leg->setStatePublisher(n.advertise<syropod_highlevel_controller::LegState>(topic_name, 1000));
-    leg->setASCStatePublisher(n.advertise<std_msgs::Bool>("leg_state_" + leg->getIDName() + "_bool", 1)); // TODO
+    leg_state_publishers_[leg->getIDNumber()] = n.advertise<syropod_highlevel_controller::LegState>(topic_name, 1000);
+    asc_leg_state_publishers_[leg->getIDNumber()] =
+      n.advertise<std_msgs::Bool>("leg_state_" + leg->getIDName() + "_bool", 1); // TODO
     // If debugging in gazebo, setup joint command publishers
     if (params_.individual_control_interface.data)
     {
       for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
       {
         std::shared_ptr<Joint> joint = joint_it_->second;
-        joint->desired_position_publisher_ =
+        joint_position_publishers_[joint->id_name_] =
           n.advertise<std_msgs::Float64>(joint->id_name_ + "/command", 1000);
       }
     }
   }
+
+  // Preallocate aggregated leg state message
+  leg_states_msg_.name.resize(leg_count);
+  leg_states_msg_.joint_count.resize(leg_count);
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    leg_states_msg_.name[leg->getIDNumber()] = leg->getIDName();
+    leg_states_msg_.joint_count[leg->getIDNumber()] = leg->getJointCount();
+  }
+  leg_states_msg_.walker_tip_pose.resize(leg_count);
+  leg_states_msg_.target_tip_pose.resize(leg_count);
+  leg_states_msg_.poser_tip_pose.resize(leg_count);
+  leg_states_msg_.model_tip_pose.resize(leg_count);
+  leg_states_msg_.model_tip_velocity.resize(leg_count);
+  leg_states_msg_.joint_positions.resize(joint_count);
+  leg_states_msg_.joint_velocities.resize(joint_count);
+  leg_states_msg_.joint_efforts.resize(joint_count);
+  leg_states_msg_.stance_progress.resize(leg_count);
+  leg_states_msg_.swing_progress.resize(leg_count);
+  leg_states_msg_.time_to_swing_end.resize(leg_count);
+  leg_states_msg_.auto_pose.resize(leg_count);
+  leg_states_msg_.tip_force.resize(leg_count);
+  leg_states_msg_.admittance_delta.resize(leg_count);
+  leg_states_msg_.virtual_stiffness.resize(leg_count);
+
+  // Start servicing sensor callbacks on a single separate thread
+  sensor_spinner_ = std::allocate_shared<ros::AsyncSpinner>(Eigen::aligned_allocator<ros::AsyncSpinner>(),
+                                                             1, &sensor_callback_queue_);
+  sensor_spinner_->start();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 StateController::~StateController(void)
 {
+  sensor_spinner_->stop();
+  stopOutputThread();
+  debug_visualiser_->stopVisualisationThread();
+  delete dynamic_reconfigure_server_;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,50 +225,155 @@ StateController::~StateController(void)
 void StateController::init(void)
 {
   // Set initial gait selection number for gait toggling
-  if (params_.gait_type.data == "tripod_gait")
+  gait_selection_ = getGaitDesignation(params_.gait_type.data);
+
+  // Create controller objects and smart pointers
+  walker_ = std::allocate_shared<WalkController>(Eigen::aligned_allocator<WalkController>(), model_, params_);
+  walker_->init();
+  poser_ = std::allocate_shared<PoseController>(Eigen::aligned_allocator<PoseController>(), model_, params_);
+  poser_->init();
+  if (params_.admittance_control.data && admittance_->startAdmittanceThread())
   {
-    gait_selection_ = TRIPOD_GAIT;
+    ROS_INFO("\n[SHC] Admittance thread started at %f Hz.\n", params_.admittance_rate.data);
   }
-  else if (params_.gait_type.data == "ripple_gait")
+  if (params_.debug_rviz.data)
   {
-    gait_selection_ = RIPPLE_GAIT;
+    debug_visualiser_->startVisualisationThread();
   }
-  else if (params_.gait_type.data == "wave_gait")
+
+  robot_state_ = UNKNOWN;
+
+  initialised_ = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::updateSensorData(void)
+{
+  if (!sensor_data_.read(&sensor_sample_))
   {
-    gait_selection_ = WAVE_GAIT;
+    return;
   }
-  else if (params_.gait_type.data == "amble_gait")
+  if (input_recorder_.isRecording())
   {
-    gait_selection_ = AMBLE_GAIT;
+    packSensorData(sensor_sample_);
+    input_recorder_.record(SENSOR_DATA_RECORD, cycle_count_, NO_INPUT_CHANNEL,
+                           record_buffer_.data(), record_buffer_.size() * sizeof(double));
   }
+  applySensorData();
+}
 
-  // Create controller objects and smart pointers
-  walker_ = std::allocate_shared<WalkController>(Eigen::aligned_allocator<WalkController>(), model_, params_);
-  walker_->init();
-  poser_ = std::allocate_shared<PoseController>(Eigen::aligned_allocator<PoseController>(), model_, params_);
-  poser_->init();
-  admittance_ =
-    std::allocate_shared<AdmittanceController>(Eigen::aligned_allocator<AdmittanceController>(), model_, params_);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-  robot_state_ = UNKNOWN;
+void StateController::applySensorData(void)
+{
+  // Assign sampled state values to joint objects
+  for (uint i = 0; i < sensor_joints_.size(); ++i)
+  {
+    std::shared_ptr<Joint> joint = sensor_joints_[i];
+    if (sensor_sample_.joint_position_[i] != UNASSIGNED_VALUE)
+    {
+      joint->current_position_ = sensor_sample_.joint_position_[i] - joint->offset_;
+    }
+    if (sensor_sample_.joint_velocity_[i] != UNASSIGNED_VALUE)
+    {
+      joint->current_velocity_ = sensor_sample_.joint_velocity_[i];
+    }
+    if (sensor_sample_.joint_effort_[i] != UNASSIGNED_VALUE)
+    {
+      joint->current_effort_ = sensor_sample_.joint_effort_[i];
+      joint->desired_effort_ = joint->current_effort_; // HACK
+    }
+  }
 
-  initialised_ = true;
+  // Check if all joint positions have been received from topic
+  if (!joint_positions_initialised_)
+  {
+    joint_positions_initialised_ = (sensor_sample_.joint_position_ != UNASSIGNED_VALUE).all();
+  }
+
+  // Assign sampled IMU data to model
+  if (sensor_sample_.imu_received_ && system_state_ != SUSPENDED && poser_ != NULL)
+  {
+    model_->setImuData(sensor_sample_.imu_orientation_,
+                       sensor_sample_.imu_linear_acceleration_,
+                       sensor_sample_.imu_angular_velocity_);
+  }
+
+  // Assign sampled tip state values to leg objects if new tip states have been received since last applied
+  std::string error_string;
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+    int l = leg->getIDNumber();
+    if (sensor_sample_.wrench_count_[l] != applied_wrench_count_[l])
+    {
+      applied_wrench_count_[l] = sensor_sample_.wrench_count_[l];
+      if (leg_stepper != NULL)
+      {
+        leg_stepper->setTouchdownDetection(true);
+      }
+      leg->setTipForceMeasured(sensor_sample_.tip_force_.col(l).matrix());
+      leg->setTipTorqueMeasured(sensor_sample_.tip_torque_.col(l).matrix());
+      leg->touchdownDetection();
+    }
+    if (sensor_sample_.step_plane_count_[l] != applied_step_plane_count_[l])
+    {
+      applied_step_plane_count_[l] = sensor_sample_.step_plane_count_[l];
+      if (leg_stepper != NULL)
+      {
+        leg_stepper->setTouchdownDetection(true);
+      }
+      Eigen::Vector3d step_plane = sensor_sample_.step_plane_.col(l).matrix();
+      if (step_plane[2] != UNASSIGNED_VALUE)
+      {
+        // From step plane representation calculate position and orientation of plane relative to tip frame
+        Eigen::Vector3d step_plane_position(step_plane[2], 0.0, 0.0);
+        Eigen::Vector3d step_plane_normal(step_plane[0], step_plane[1], -1.0);
+        Eigen::Quaterniond step_plane_orientation = Eigen::Quaterniond::FromTwoVectors(Eigen::Vector3d(0, 0, 1.0),
+                                                                                      -step_plane_normal);
+
+        // Transform into robot frame and store
+        Pose step_plane_pose = leg->getTip()->getPoseRobotFrame(Pose(step_plane_position, step_plane_orientation));
+        leg->setStepPlanePose(step_plane_pose);
+      }
+      else
+      {
+        leg->setStepPlanePose(Pose::Undefined());
+        error_string += stringFormat("\nLost contact with tip range sensor/s of leg %s.\n", leg->getIDName().c_str());
+      }
+    }
+  }
+  if (!error_string.empty())
+  {
+    ROS_ERROR_THROTTLE(THROTTLE_PERIOD, "%s", error_string.c_str());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void StateController::loop(void)
 {
+  // Reclaim transient data of previous control cycle
+  model_->getCycleArena()->reset();
+  model_->getEventLog()->advanceCycle();
+
   // Posing - updates currentPose for body compensation
   if (robot_state_ != UNKNOWN)
   {
-    poser_->updateCurrentPose(robot_state_);
+    {
+      ScopedTimer timer(getStageTiming(CURRENT_POSE_STAGE), getStageAllocations(CURRENT_POSE_STAGE));
+      poser_->updateCurrentPose(robot_state_);
+    }
     walker_->setPoseState(poser_->getAutoPoseState()); // Sends pose state from poser to walker
     generateExternalTargetTransforms();
 
     // Admittance control - updates deltaZ values
     if (params_.admittance_control.data)
     {
+      ScopedTimer timer(getStageTiming(ADMITTANCE_STAGE), getStageAllocations(ADMITTANCE_STAGE));
+
       // Calculate new stiffness based on walking cycle
       if (walker_->getWalkState() != STOPPED && params_.dynamic_stiffness.data)
       {
@@ -194,6 +397,371 @@ void StateController::loop(void)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void StateController::runControlCycle(void)
+{
+  input_recorder_.record(CONTROL_CYCLE_RECORD, cycle_count_);
+  if (system_state_ != SUSPENDED)
+  {
+    ScopedTimer timer(getStageTiming(CONTROL_CYCLE_STAGE), getStageAllocations(CONTROL_CYCLE_STAGE));
+
+    // Guard steady state RUNNING loop against heap allocations once warm-up period has elapsed
+    running_cycle_count_ = (robot_state_ == RUNNING) ? running_cycle_count_ + 1 : 0;
+    if (running_cycle_count_ == 0)
+    {
+      // Report the first guarded allocation again once the robot next enters the RUNNING state
+      resetAllocationGuard();
+    }
+    double running_time = running_cycle_count_ * params_.time_delta.data;
+    bool guarded = (allocation_guard_mode_ != ALLOCATION_GUARD_OFF && !transition_state_flag_ &&
+                    running_cycle_count_ > 0 && running_time > params_.allocation_guard_warmup.data);
+    if (guarded)
+    {
+      armAllocationGuard(allocation_guard_mode_);
+    }
+    loop();
+    disarmAllocationGuard();
+    publishLegState();
+    publishLegStates();
+    publishVelocity();
+    publishPose();
+    publishWalkspace();
+    publishRotationPoseError();
+    publishFrameTransforms();
+
+    if (params_.debug_rviz.data)
+    {
+      RVIZDebugging();
+    }
+
+    publishDesiredJointState();
+  }
+  else
+  {
+    ROS_INFO_THROTTLE(THROTTLE_PERIOD, "\nController suspended. Press Logitech button to resume . . .\n");
+  }
+
+  publishTimingDiagnostics();
+
+  // Record desired joint positions for verification of replay
+  if (input_recorder_.isRecording())
+  {
+    for (uint i = 0; i < sensor_joints_.size(); ++i)
+    {
+      record_buffer_[i] = sensor_joints_[i]->desired_position_;
+    }
+    input_recorder_.record(OUTPUT_RECORD, cycle_count_, NO_INPUT_CHANNEL,
+                           record_buffer_.data(), sensor_joints_.size() * sizeof(double));
+  }
+  cycle_count_++;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool StateController::startReplay(const InputLogHeader &header)
+{
+  if (header.joint_count_ != sensor_joints_.size() || header.leg_count_ != uint(model_->getLegCount()))
+  {
+    ROS_ERROR("\n[SHC] Input log recorded for %d joints and %d legs but model has %d joints and %d legs.\n",
+              header.joint_count_, header.leg_count_, int(sensor_joints_.size()), model_->getLegCount());
+    return false;
+  }
+  if (header.time_delta_ != params_.time_delta.data)
+  {
+    ROS_ERROR("\n[SHC] Input log recorded with time_delta %f but controller has time_delta %f.\n",
+              header.time_delta_, params_.time_delta.data);
+    return false;
+  }
+
+  if (params_.admittance_control.data && params_.admittance_rate.data > 0.0)
+  {
+    ROS_WARN("\n[SHC] Admittance control runs asynchronously on the admittance thread. Replay of the input log will "
+             "not be deterministic.\n");
+  }
+
+  // Replayed sensor data replaces live sensor data and replayed inputs are not recorded again
+  sensor_spinner_->stop();
+  input_recorder_.close();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool StateController::replayInput(const InputRecordHeader &record, const uint8_t* payload)
+{
+  // Records must be consumed in the control cycle in which they were recorded
+  if (record.cycle_ != cycle_count_)
+  {
+    return false;
+  }
+
+  switch (record.type_)
+  {
+    case (SENSOR_DATA_RECORD):
+    {
+      if (record.size_ != record_buffer_.size() * sizeof(double))
+      {
+        return false;
+      }
+      unpackSensorData(reinterpret_cast<const double*>(payload), &sensor_sample_);
+      applySensorData();
+      return true;
+    }
+    case (MODEL_INIT_RECORD):
+    {
+      if (record.size_ != sizeof(uint8_t))
+      {
+        return false;
+      }
+      init();
+      initModel(payload[0] != 0);
+      return true;
+    }
+    case (CONTROL_CYCLE_RECORD):
+      runControlCycle();
+      return true;
+    case (CALLBACK_RECORD):
+      break;
+    default:
+      return false;
+  }
+
+  switch (record.channel_)
+  {
+    case (SYSTEM_STATE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      systemStateCallback(input);
+      return true;
+    }
+    case (ROBOT_STATE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      robotStateCallback(input);
+      return true;
+    }
+    case (BODY_VELOCITY_INPUT):
+    {
+      geometry_msgs::Twist input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      bodyVelocityInputCallback(input);
+      return true;
+    }
+    case (BODY_POSE_INPUT):
+    {
+      geometry_msgs::Twist input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      bodyPoseInputCallback(input);
+      return true;
+    }
+    case (POSING_MODE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      posingModeCallback(input);
+      return true;
+    }
+    case (POSE_RESET_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      poseResetCallback(input);
+      return true;
+    }
+    case (GAIT_SELECTION_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      gaitSelectionCallback(input);
+      return true;
+    }
+    case (CRUISE_CONTROL_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      cruiseControlCallback(input);
+      return true;
+    }
+    case (PLANNER_MODE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      plannerModeCallback(input);
+      return true;
+    }
+    case (PRIMARY_LEG_SELECTION_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      primaryLegSelectionCallback(input);
+      return true;
+    }
+    case (SECONDARY_LEG_SELECTION_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      secondaryLegSelectionCallback(input);
+      return true;
+    }
+    case (PRIMARY_LEG_STATE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      primaryLegStateCallback(input);
+      return true;
+    }
+    case (SECONDARY_LEG_STATE_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      secondaryLegStateCallback(input);
+      return true;
+    }
+    case (PRIMARY_TIP_VELOCITY_INPUT):
+    {
+      geometry_msgs::Point input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      primaryTipVelocityInputCallback(input);
+      return true;
+    }
+    case (SECONDARY_TIP_VELOCITY_INPUT):
+    {
+      geometry_msgs::Point input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      secondaryTipVelocityInputCallback(input);
+      return true;
+    }
+    case (PRIMARY_TIP_POSE_INPUT):
+    {
+      geometry_msgs::Pose input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      primaryTipPoseInputCallback(input);
+      return true;
+    }
+    case (SECONDARY_TIP_POSE_INPUT):
+    {
+      geometry_msgs::Pose input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      secondaryTipPoseInputCallback(input);
+      return true;
+    }
+    case (PARAMETER_SELECTION_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      parameterSelectionCallback(input);
+      return true;
+    }
+    case (PARAMETER_ADJUST_INPUT):
+    {
+      std_msgs::Int8 input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      parameterAdjustCallback(input);
+      return true;
+    }
+    case (TARGET_CONFIGURATION_INPUT):
+    {
+      sensor_msgs::JointState input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      targetConfigurationCallback(input);
+      return true;
+    }
+    case (TARGET_BODY_POSE_INPUT):
+    {
+      geometry_msgs::Pose input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      targetBodyPoseCallback(input);
+      return true;
+    }
+    case (TARGET_TIP_POSE_INPUT):
+    {
+      syropod_highlevel_controller::TargetTipPose input;
+      InputLogReader::decodeMessage(record, payload, &input);
+      targetTipPoseCallback(input);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double StateController::calculateOutputDeviation(const InputRecordHeader &record, const uint8_t* payload)
+{
+  if (record.type_ != OUTPUT_RECORD || record.size_ != sensor_joints_.size() * sizeof(double))
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double* recorded_position = reinterpret_cast<const double*>(payload);
+  double deviation = 0.0;
+  for (uint i = 0; i < sensor_joints_.size(); ++i)
+  {
+    double desired_position = sensor_joints_[i]->desired_position_;
+    if (memcmp(&desired_position, &recorded_position[i], sizeof(double)) != 0)
+    {
+      double difference = std::abs(desired_position - recorded_position[i]);
+      deviation = std::max(deviation, std::isnan(difference) ? std::numeric_limits<double>::infinity() : difference);
+    }
+  }
+  return deviation;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::packSensorData(const SensorData &sensor_data)
+{
+  int joint_count = sensor_joints_.size();
+  double* data = record_buffer_.data();
+  data[0] = sensor_data.imu_received_;
+  data[1] = sensor_data.imu_orientation_.w();
+  data[2] = sensor_data.imu_orientation_.x();
+  data[3] = sensor_data.imu_orientation_.y();
+  data[4] = sensor_data.imu_orientation_.z();
+  Eigen::Map<Eigen::Vector3d>(data + 5) = sensor_data.imu_linear_acceleration_;
+  Eigen::Map<Eigen::Vector3d>(data + 8) = sensor_data.imu_angular_velocity_;
+  data += SENSOR_RECORD_IMU_SIZE;
+  Eigen::Map<Eigen::ArrayXd>(data, joint_count) = sensor_data.joint_position_;
+  Eigen::Map<Eigen::ArrayXd>(data + joint_count, joint_count) = sensor_data.joint_velocity_;
+  Eigen::Map<Eigen::ArrayXd>(data + 2 * joint_count, joint_count) = sensor_data.joint_effort_;
+  data += 3 * joint_count;
+  for (int l = 0; l < model_->getLegCount(); ++l, data += SENSOR_RECORD_LEG_SIZE)
+  {
+    data[0] = sensor_data.wrench_count_[l];
+    Eigen::Map<Eigen::Array3d>(data + 1) = sensor_data.tip_force_.col(l);
+    Eigen::Map<Eigen::Array3d>(data + 4) = sensor_data.tip_torque_.col(l);
+    data[7] = sensor_data.step_plane_count_[l];
+    Eigen::Map<Eigen::Array3d>(data + 8) = sensor_data.step_plane_.col(l);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::unpackSensorData(const double* data, SensorData* sensor_data)
+{
+  int joint_count = sensor_joints_.size();
+  sensor_data->imu_received_ = (data[0] != 0.0);
+  sensor_data->imu_orientation_ = Eigen::Quaterniond(data[1], data[2], data[3], data[4]);
+  sensor_data->imu_linear_acceleration_ = Eigen::Map<const Eigen::Vector3d>(data + 5);
+  sensor_data->imu_angular_velocity_ = Eigen::Map<const Eigen::Vector3d>(data + 8);
+  data += SENSOR_RECORD_IMU_SIZE;
+  sensor_data->joint_position_ = Eigen::Map<const Eigen::ArrayXd>(data, joint_count);
+  sensor_data->joint_velocity_ = Eigen::Map<const Eigen::ArrayXd>(data + joint_count, joint_count);
+  sensor_data->joint_effort_ = Eigen::Map<const Eigen::ArrayXd>(data + 2 * joint_count, joint_count);
+  data += 3 * joint_count;
+  for (int l = 0; l < model_->getLegCount(); ++l, data += SENSOR_RECORD_LEG_SIZE)
+  {
+    sensor_data->wrench_count_[l] = static_cast<uint>(data[0]);
+    sensor_data->tip_force_.col(l) = Eigen::Map<const Eigen::Array3d>(data + 1);
+    sensor_data->tip_torque_.col(l) = Eigen::Map<const Eigen::Array3d>(data + 4);
+    sensor_data->step_plane_count_[l] = static_cast<uint>(data[7]);
+    sensor_data->step_plane_.col(l) = Eigen::Map<const Eigen::Array3d>(data + 8);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void StateController::transitionRobotState(void)
 {
   // UNKNOWN -> OFF/PACKED/READY/RUNNING
@@ -406,7 +974,7 @@ void StateController::runningState(void)
   // Cruise control (constant velocity input)
   else if (cruise_control_mode_ == CRUISE_CONTROL_ON &&
           (params_.cruise_control_time_limit.data == 0.0 ||
-           ros::Time::now().toSec() < cruise_control_end_time_))
+           cycle_count_ < cruise_control_end_cycle_))
   {
     linear_velocity_input_ = linear_cruise_velocity_;
     angular_velocity_input_ = angular_cruise_velocity_;
@@ -426,7 +994,10 @@ void StateController::runningState(void)
   if (update_tip_position)
   {
     // Update tip positions for walking legs
-    walker_->updateWalk(linear_velocity_input_, angular_velocity_input_);
+    {
+      ScopedTimer timer(getStageTiming(WALK_STAGE), getStageAllocations(WALK_STAGE));
+      walker_->updateWalk(linear_velocity_input_, angular_velocity_input_);
+    }
 
     // Update tip positions for manually controlled legs
     walker_->updateManual(primary_leg_selection_, primary_tip_velocity_input_,
@@ -439,10 +1010,16 @@ void StateController::runningState(void)
                           secondary_leg_selection_, secondary_pose_input_);
 
     // Pose controller takes current tip positions from walker and applies body posing
-    poser_->updateStance();
+    {
+      ScopedTimer timer(getStageTiming(STANCE_STAGE), getStageAllocations(STANCE_STAGE));
+      poser_->updateStance();
+    }
 
     // Model takes desired tip poses from pose controller and applies inverse/forwards kinematics
-    model_->updateModel();
+    {
+      ScopedTimer timer(getStageTiming(MODEL_STAGE), getStageAllocations(MODEL_STAGE));
+      model_->updateModel();
+    }
   }
 }
 
@@ -453,47 +1030,51 @@ void StateController::adjustParameter(void)
   AdjustableParameter* p = dynamic_parameter_;
   p->current_value = new_parameter_value_;
   bool set_new_parameter = true;
-  if (p->name == "step_frequency")
+  if (p->selection == STEP_FREQUENCY)
   {
-    // Calculate new speed/acceleration limits due to changing parameter
+    // Calculate new speed/acceleration limits ahead of retiming the step cycle for the new parameter
     StepCycle new_step_cycle = walker_->generateStepCycle(false);
     LimitMap max_linear_speed_map;
     LimitMap max_angular_speed_map;
-    walker_->generateLimits(new_step_cycle, &max_linear_speed_map, &max_angular_speed_map);
-    walker_->setLinearSpeedLimitMap(max_linear_speed_map);
-    walker_->setAngularSpeedLimitMap(max_angular_speed_map);
+    LimitMap max_linear_acceleration_map;
+    LimitMap max_angular_acceleration_map;
+    walker_->generateLimits(new_step_cycle, &max_linear_speed_map, &max_angular_speed_map,
+                            &max_linear_acceleration_map, &max_angular_acceleration_map);
     double max_linear_speed =
       walker_->getLimit(linear_velocity_input_, angular_velocity_input_, max_linear_speed_map);
     double max_angular_speed =
       walker_->getLimit(linear_velocity_input_, angular_velocity_input_, max_angular_speed_map);
 
-    // Generate target velocities to achieve before changing step frequency
-    Eigen::Vector2d target_linear_velocity;
-    double target_angular_velocity;
-    if (params_.velocity_input_mode.data == "throttle")
+    // Retime step cycle in place (phase and remaining swing/stance periods) if current velocity is within new limits
+    WalkState walk_state = walker_->getWalkState();
+    bool within_new_limits = (walker_->getDesiredLinearVelocity().norm() <= max_linear_speed &&
+                              abs(walker_->getDesiredAngularVelocity()) <= max_angular_speed);
+    if (walker_->isTransitioningGait())
     {
-      target_linear_velocity = clamped(linear_velocity_input_, 1.0) * max_linear_speed; // Forces input between -1.0/1.0
-      target_angular_velocity = clamped(angular_velocity_input_, -1.0, 1.0) * max_angular_speed;
-
-      // Scale linear velocity according to angular velocity (% of max) to keep stride velocities within limits
-      target_linear_velocity *= (1.0 - abs(angular_velocity_input_));
-    }
-    else if (params_.velocity_input_mode.data == "real")
-    {
-      target_linear_velocity = clamped(linear_velocity_input_, max_linear_speed);
-      target_angular_velocity = clamped(angular_velocity_input_, -max_angular_speed, max_angular_speed);
+      set_new_parameter = false;
+      ROS_INFO_THROTTLE(THROTTLE_PERIOD,
+                        "\n[SHC] Waiting for gait change to complete before setting new parameter '%s'\n",
+                        p->name.c_str());
     }
-
-    // Set new parameter once within new limits
-    if (walker_->getDesiredLinearVelocity()[0] <= target_linear_velocity[0] &&
-        walker_->getDesiredLinearVelocity()[1] <= target_linear_velocity[1] &&
-        abs(walker_->getDesiredAngularVelocity()) <= abs(target_angular_velocity))
+    else if (within_new_limits && (walk_state == MOVING || walk_state == STOPPED))
     {
       walker_->generateStepCycle();
-      walker_->generateLimits();
+      walker_->setLinearSpeedLimitMap(max_linear_speed_map);
+      walker_->setAngularSpeedLimitMap(max_angular_speed_map);
+      walker_->setLinearAccelerationLimitMap(max_linear_acceleration_map);
+      walker_->setAngularAccelerationLimitMap(max_angular_acceleration_map);
+
+      // Auto posing synchronised with step cycle requires retiming
+      if (params_.auto_posing.data && poser_->getPoseFrequency() == -1.0)
+      {
+        poser_->setAutoPoseParams();
+      }
     }
+    // Slow to within new limits before retiming
     else
     {
+      walker_->setLinearSpeedLimitMap(max_linear_speed_map);
+      walker_->setAngularSpeedLimitMap(max_angular_speed_map);
       set_new_parameter = false;
       ROS_INFO_THROTTLE(THROTTLE_PERIOD,
                         "\n[SHC] Slowing to safe speed before setting new parameter '%s'\n", p->name.c_str());
@@ -512,11 +1093,28 @@ void StateController::adjustParameter(void)
 
 void StateController::changeGait(void)
 {
-  if (walker_->getWalkState() == STOPPED)
+  // Gaits are not transitioned whilst walking in free gait, in which lift off is event driven rather than periodic
+  bool change_whilst_walking = (params_.gait_transition_cycles.data > 0 && !params_.free_gait.data);
+  WalkState walk_state = walker_->getWalkState();
+  if (walk_state == STOPPED || (change_whilst_walking && walk_state == MOVING))
   {
+    std::string current_gait_type = params_.gait_type.data;
     initGaitParameters(gait_selection_);
-    walker_->generateStepCycle();
-    walker_->generateLimits();
+    if (walk_state == STOPPED)
+    {
+      walker_->generateStepCycle();
+      walker_->generateLimits();
+    }
+    // Restore current gait and stop to change gait if support cannot be maintained whilst walking
+    else if (!walker_->generateGaitTransition(params_.gait_transition_cycles.data))
+    {
+      initGaitParameters(getGaitDesignation(current_gait_type));
+      linear_velocity_input_ = Eigen::Vector2d::Zero();
+      angular_velocity_input_ = 0.0;
+      ROS_WARN("\n[SHC] Unable to change gait within %d step cycles whilst walking without loss of support. "
+               "Stopping Syropod to change gait . . .\n", params_.gait_transition_cycles.data);
+      return;
+    }
 
     // For auto compensation find associated auto posing parameters for new gait
     if (params_.auto_posing.data && params_.auto_pose_type.data == "auto")
@@ -528,6 +1126,11 @@ void StateController::changeGait(void)
     gait_change_flag_ = false;
     ROS_INFO("\nNow using %s mode.\n", params_.gait_type.data.c_str());
   }
+  // Wait for Syropod to finish starting before changing gait whilst walking
+  else if (change_whilst_walking && walk_state == STARTING)
+  {
+    ROS_INFO_THROTTLE(THROTTLE_PERIOD, "\nWaiting for Syropod to start walking to change gait . . .\n");
+  }
   // Force Syropod to stop walking
   else
   {
@@ -714,7 +1317,7 @@ void StateController::generateExternalTargetTransforms(void)
     external_target = leg_stepper->getExternalTarget();
     if (external_target.defined_)
     {
-      ros::Time past = external_target.time_;
+      ros::Time past(external_target.time_);
       std::string frame_id = external_target.frame_id_;
       try
       {
@@ -734,7 +1337,7 @@ void StateController::generateExternalTargetTransforms(void)
     external_target = leg_stepper->getExternalDefault();
     if (external_target.defined_)
     {
-      ros::Time past = external_target.time_;
+      ros::Time past(external_target.time_);
       std::string frame_id = external_target.frame_id_;
       try
       {
@@ -754,7 +1357,7 @@ void StateController::generateExternalTargetTransforms(void)
     external_target = leg_poser->getExternalTarget();
     if (external_target.defined_)
     {
-      ros::Time past = external_target.time_;
+      ros::Time past(external_target.time_);
       std::string frame_id = external_target.frame_id_;
       try
       {
@@ -776,6 +1379,33 @@ void StateController::generateExternalTargetTransforms(void)
 
 void StateController::publishDesiredJointState(void)
 {
+  ScopedTimer timer(getStageTiming(DESIRED_JOINT_STATE_PUBLISH_STAGE),
+                    getStageAllocations(DESIRED_JOINT_STATE_PUBLISH_STAGE));
+  // Append desired joint positions to trajectory segment and pass it to output thread
+  if (output_thread_running_)
+  {
+    output_segment_.start_position_ = output_segment_.end_position_;
+    output_segment_.start_velocity_ = output_segment_.end_velocity_;
+    int index = 0;
+    for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+    {
+      std::shared_ptr<Leg> leg = leg_it_->second;
+      for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
+      {
+        std::shared_ptr<Joint> joint = joint_it_->second;
+        output_segment_.end_position_[index] = joint->desired_position_;
+        output_segment_.effort_[index] = joint->desired_effort_;
+        output_segment_.offset_[index] = joint->offset_;
+        index++;
+      }
+    }
+    output_segment_.end_velocity_ =
+      (output_segment_.end_position_ - output_segment_.start_position_) / params_.time_delta.data;
+    output_segment_.start_time_ = std::chrono::steady_clock::now();
+    output_segment_input_.write(output_segment_);
+    return;
+  }
+
   sensor_msgs::JointState joint_state_msg;
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
@@ -793,21 +1423,163 @@ void StateController::publishDesiredJointState(void)
         std::shared_ptr<Joint> joint = joint_it->second;
         std_msgs::Float64 position_command_msg;
         position_command_msg.data = joint->desired_position_ + joint->offset_;
-        joint->desired_position_publisher_.publish(position_command_msg);
+        joint_position_publishers_[joint->id_name_].publish(position_command_msg);
       }
     }
   }
 
   if (params_.combined_control_interface.data)
   {
+    joint_state_msg.header.stamp = ros::Time::now();
     desired_joint_state_publisher_.publish(joint_state_msg);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+bool StateController::startOutputThread(void)
+{
+  if (output_thread_running_ || params_.output_rate.data * params_.time_delta.data <= 1.0)
+  {
+    return false;
+  }
+
+  // Initialise trajectory segment as stationary at current desired joint positions
+  output_joint_names_.clear();
+  output_publishers_.clear();
+  std::vector<double> positions;
+  std::vector<double> efforts;
+  std::vector<double> offsets;
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
+    {
+      std::shared_ptr<Joint> joint = joint_it_->second;
+      output_joint_names_.push_back(joint->id_name_);
+      output_publishers_.push_back(joint_position_publishers_[joint->id_name_]);
+      positions.push_back(joint->desired_position_);
+      efforts.push_back(joint->desired_effort_);
+      offsets.push_back(joint->offset_);
+    }
+  }
+  int joint_count = positions.size();
+  output_segment_.start_time_ = std::chrono::steady_clock::now();
+  output_segment_.offset_ = Eigen::Map<Eigen::ArrayXd>(offsets.data(), joint_count);
+  output_segment_.start_position_ = Eigen::Map<Eigen::ArrayXd>(positions.data(), joint_count);
+  output_segment_.end_position_ = output_segment_.start_position_;
+  output_segment_.start_velocity_ = Eigen::ArrayXd::Zero(joint_count);
+  output_segment_.end_velocity_ = Eigen::ArrayXd::Zero(joint_count);
+  output_segment_.effort_ = Eigen::Map<Eigen::ArrayXd>(efforts.data(), joint_count);
+  output_segment_input_.reset(output_segment_);
+
+  output_thread_running_ = true;
+  output_thread_ = std::thread(&StateController::outputLoop, this);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::stopOutputThread(void)
+{
+  output_thread_running_ = false;
+  if (output_thread_.joinable())
+  {
+    output_thread_.join();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::outputLoop(void)
+{
+  // Set output thread to real-time FIFO scheduling at requested priority, otherwise continue with default policy
+  int priority = params_.output_priority.data;
+  if (priority > 0)
+  {
+    sched_param scheduling_parameters;
+    scheduling_parameters.sched_priority = priority;
+    int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &scheduling_parameters);
+    if (result != 0)
+    {
+      ROS_WARN("\n[SHC] Failed to set output thread SCHED_FIFO priority to %d (%s)."
+               " Continuing with default scheduling policy.\n", priority, strerror(result));
+    }
+  }
+
+  // Pace on the monotonic clock, on which trajectory segments are also timed
+  RealTimeLoop loop(1.0 / params_.output_rate.data);
+  double segment_period = params_.time_delta.data;
+
+  // Preallocate trajectory segment and combined joint state message
+  OutputSegment segment;
+  output_segment_input_.read(&segment);
+  int joint_count = output_joint_names_.size();
+  sensor_msgs::JointState joint_state_msg;
+  joint_state_msg.name = output_joint_names_;
+  joint_state_msg.position.resize(joint_count);
+  joint_state_msg.velocity.resize(joint_count);
+  joint_state_msg.effort.resize(joint_count);
+
+  while (output_thread_running_ && ros::ok())
+  {
+    // Publish nothing whilst suspended, as in single-rate mode
+    if (system_state_ == SUSPENDED)
+    {
+      loop.sleep();
+      continue;
+    }
+
+    output_segment_input_.read(&segment);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - segment.start_time_;
+    double s = clamped(elapsed.count() / segment_period, 0.0, 1.0);
+
+    // Cubic Hermite basis functions and derivatives
+    double h00 = 2.0 * pow(s, 3) - 3.0 * sqr(s) + 1.0;
+    double h10 = pow(s, 3) - 2.0 * sqr(s) + s;
+    double h01 = -2.0 * pow(s, 3) + 3.0 * sqr(s);
+    double h11 = pow(s, 3) - sqr(s);
+    double dh00 = 6.0 * sqr(s) - 6.0 * s;
+    double dh10 = 3.0 * sqr(s) - 4.0 * s + 1.0;
+    double dh01 = -6.0 * sqr(s) + 6.0 * s;
+    double dh11 = 3.0 * sqr(s) - 2.0 * s;
+
+    for (int index = 0; index < joint_count; ++index)
+    {
+      double start_tangent = segment.start_velocity_[index] * segment_period;
+      double end_tangent = segment.end_velocity_[index] * segment_period;
+      joint_state_msg.position[index] = h00 * segment.start_position_[index] + h10 * start_tangent +
+                                        h01 * segment.end_position_[index] + h11 * end_tangent;
+      joint_state_msg.velocity[index] = (dh00 * segment.start_position_[index] + dh10 * start_tangent +
+                                         dh01 * segment.end_position_[index] + dh11 * end_tangent) / segment_period;
+      joint_state_msg.effort[index] = segment.effort_[index];
+    }
+
+    if (params_.individual_control_interface.data)
+    {
+      for (int index = 0; index < joint_count; ++index)
+      {
+        std_msgs::Float64 position_command_msg;
+        position_command_msg.data = joint_state_msg.position[index] + segment.offset_[index];
+        output_publishers_[index].publish(position_command_msg);
+      }
+    }
+
+    if (params_.combined_control_interface.data)
+    {
+      joint_state_msg.header.stamp = ros::Time::now();
+      desired_joint_state_publisher_.publish(joint_state_msg);
+    }
+
+    loop.sleep();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void StateController::publishLegState(void)
 {
+  ScopedTimer timer(getStageTiming(LEG_STATE_PUBLISH_STAGE), getStageAllocations(LEG_STATE_PUBLISH_STAGE));
 
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
@@ -859,18 +1631,7 @@ void StateController::publishLegState(void)
     // Step progress
     msg.swing_progress = leg_stepper->getSwingProgress();
     msg.stance_progress = leg_stepper->getStanceProgress();
-    StepCycle step = walker_->getStepCycle();
-    double swing_time = (double(step.swing_period_) / step.period_) / step.frequency_;
-    double stance_time = (double(step.stance_period_) / step.period_) / step.frequency_;
-    double time_to_swing_end;
-    if (leg_stepper->getStanceProgress() >= 0.0)
-    {
-      time_to_swing_end = stance_time * (1.0 - leg_stepper->getStanceProgress()) + swing_time;
-    }
-    else
-    {
-      time_to_swing_end = swing_time * (1.0 - leg_stepper->getSwingProgress());
-    }
+    double time_to_swing_end = calculateTimeToSwingEnd(leg_stepper);
     msg.time_to_swing_end = time_to_swing_end;
     msg.pose_delta = walker_->calculateOdometry(time_to_swing_end).toPoseMessage();
 
@@ -888,7 +1649,91 @@ void StateController::publishLegState(void)
     msg.admittance_delta.z = leg->getAdmittanceDelta()[2];
     msg.virtual_stiffness = leg->getVirtualStiffness();
 
-    leg->publishState(msg);
+    leg_state_publishers_[leg->getIDNumber()].publish(msg);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::publishLegStates(void)
+{
+  double rate = params_.leg_states_rate.data;
+  ros::Time now = ros::Time::now();
+  if (rate <= 0.0 || (now - leg_states_time_).toSec() < 1.0 / rate)
+  {
+    return;
+  }
+  leg_states_time_ = now;
+
+  ScopedTimer timer(getStageTiming(LEG_STATES_PUBLISH_STAGE), getStageAllocations(LEG_STATES_PUBLISH_STAGE));
+  syropod_highlevel_controller::LegStateArray &msg = leg_states_msg_;
+  msg.header.stamp = now;
+  int j = 0;
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+    std::shared_ptr<LegPoser> leg_poser = leg->getLegPoser();
+    int l = leg->getIDNumber();
+
+    // Tip poses/velocities
+    msg.walker_tip_pose[l] = leg_stepper->getCurrentTipPose().toPoseMessage();
+    msg.target_tip_pose[l] = leg_stepper->getTargetTipPose().toPoseMessage();
+    msg.poser_tip_pose[l] = leg_poser->getCurrentTipPose().toPoseMessage();
+    msg.model_tip_pose[l] = leg->getCurrentTipPose().toPoseMessage();
+    msg.model_tip_velocity[l].x = leg->getCurrentTipVelocity()[0];
+    msg.model_tip_velocity[l].y = leg->getCurrentTipVelocity()[1];
+    msg.model_tip_velocity[l].z = leg->getCurrentTipVelocity()[2];
+
+    // Joint positions/velocities
+    for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_, ++j)
+    {
+      std::shared_ptr<Joint> joint = joint_it_->second;
+      msg.joint_positions[j] = joint->desired_position_;
+      msg.joint_velocities[j] = joint->desired_velocity_;
+      msg.joint_efforts[j] = joint->desired_effort_;
+    }
+
+    // Step progress
+    msg.swing_progress[l] = leg_stepper->getSwingProgress();
+    msg.stance_progress[l] = leg_stepper->getStanceProgress();
+    msg.time_to_swing_end[l] = calculateTimeToSwingEnd(leg_stepper);
+
+    // Leg specific auto pose
+    msg.auto_pose[l] = leg_poser->getAutoPose().toPoseMessage();
+
+    // Admittance controller
+    msg.tip_force[l].x = leg->getTipForceCalculated()[0] * params_.force_gain.current_value;
+    msg.tip_force[l].y = leg->getTipForceCalculated()[1] * params_.force_gain.current_value;
+    msg.tip_force[l].z = leg->getTipForceCalculated()[2] * params_.force_gain.current_value;
+    msg.admittance_delta[l].x = leg->getAdmittanceDelta()[0];
+    msg.admittance_delta[l].y = leg->getAdmittanceDelta()[1];
+    msg.admittance_delta[l].z = leg->getAdmittanceDelta()[2];
+    msg.virtual_stiffness[l] = leg->getVirtualStiffness();
+  }
+
+  // Desired body velocity from which odometry over time to swing end may be calculated
+  msg.desired_body_velocity.linear.x = walker_->getDesiredLinearVelocity()[0];
+  msg.desired_body_velocity.linear.y = walker_->getDesiredLinearVelocity()[1];
+  msg.desired_body_velocity.angular.z = walker_->getDesiredAngularVelocity();
+
+  leg_states_publisher_.publish(msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double StateController::calculateTimeToSwingEnd(std::shared_ptr<LegStepper> leg_stepper)
+{
+  const StepCycle &step = walker_->getStepCycle();
+  double swing_time = (double(step.swing_period_) / step.period_) / step.frequency_;
+  double stance_time = (double(step.stance_period_) / step.period_) / step.frequency_;
+  if (leg_stepper->getStanceProgress() >= 0.0)
+  {
+    return stance_time * (1.0 - leg_stepper->getStanceProgress()) + swing_time;
+  }
+  else
+  {
+    return swing_time * (1.0 - leg_stepper->getSwingProgress());
   }
 }
 
@@ -896,6 +1741,7 @@ void StateController::publishLegState(void)
 
 void StateController::publishVelocity(void)
 {
+  ScopedTimer timer(getStageTiming(VELOCITY_PUBLISH_STAGE), getStageAllocations(VELOCITY_PUBLISH_STAGE));
   geometry_msgs::Twist msg;
   msg.linear.x = walker_->getDesiredLinearVelocity()[0];
   msg.linear.y = walker_->getDesiredLinearVelocity()[1];
@@ -910,6 +1756,7 @@ void StateController::publishVelocity(void)
 
 void StateController::publishPose(void)
 {
+  ScopedTimer timer(getStageTiming(POSE_PUBLISH_STAGE), getStageAllocations(POSE_PUBLISH_STAGE));
   geometry_msgs::Twist msg;
   Eigen::Vector3d position = model_->getCurrentPose().position_;
   Eigen::Quaterniond rotation = model_->getCurrentPose().rotation_;
@@ -926,6 +1773,7 @@ void StateController::publishPose(void)
 
 void StateController::publishWalkspace(void)
 {
+  ScopedTimer timer(getStageTiming(WALKSPACE_PUBLISH_STAGE), getStageAllocations(WALKSPACE_PUBLISH_STAGE));
   if (robot_state_ == RUNNING)
   {
     std_msgs::Float32MultiArray msg;
@@ -944,6 +1792,8 @@ void StateController::publishWalkspace(void)
 
 void StateController::publishRotationPoseError(void)
 {
+  ScopedTimer timer(getStageTiming(ROTATION_POSE_ERROR_PUBLISH_STAGE),
+                    getStageAllocations(ROTATION_POSE_ERROR_PUBLISH_STAGE));
   std_msgs::Float32MultiArray msg;
   msg.data.clear();
   msg.data.push_back(static_cast<float>(poser_->getRotationAbsementError()[0]));
@@ -960,127 +1810,246 @@ void StateController::publishRotationPoseError(void)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void StateController::publishTimingDiagnostics(void)
+{
+  double period = params_.timing_diagnostics_period.data;
+  ros::Time now = ros::Time::now();
+  if (period <= 0.0 || (now - timing_diagnostics_time_).toSec() < period)
+  {
+    return;
+  }
+  timing_diagnostics_time_ = now;
+
+  diagnostic_msgs::DiagnosticArray msg;
+  msg.header.stamp = now;
+  for (int i = 0; i < TIMING_STAGE_COUNT; ++i)
+  {
+    TimingStatistics &statistics = stage_timing_[i];
+    diagnostic_msgs::DiagnosticStatus status;
+    status.name = stringFormat("shc: timing/%s", TIMING_STAGE_NAMES[i]);
+    status.hardware_id = "syropod_highlevel_controller";
+    status.level = (statistics.getMax() > params_.time_delta.data) ? diagnostic_msgs::DiagnosticStatus::WARN
+                                                                     : diagnostic_msgs::DiagnosticStatus::OK;
+    status.message = stringFormat("mean %.3f ms, p99 %.3f ms", statistics.getMean() * 1e3,
+                                  statistics.getPercentile(0.99) * 1e3);
+    diagnostic_msgs::KeyValue key_value;
+    key_value.key = "samples";
+    key_value.value = stringFormat("%d", statistics.getSampleCount());
+    status.values.push_back(key_value);
+    key_value.key = "min (ms)";
+    key_value.value = stringFormat("%.3f", statistics.getMin() * 1e3);
+    status.values.push_back(key_value);
+    key_value.key = "mean (ms)";
+    key_value.value = stringFormat("%.3f", statistics.getMean() * 1e3);
+    status.values.push_back(key_value);
+    key_value.key = "p99 (ms)";
+    key_value.value = stringFormat("%.3f", statistics.getPercentile(0.99) * 1e3);
+    status.values.push_back(key_value);
+    key_value.key = "max (ms)";
+    key_value.value = stringFormat("%.3f", statistics.getMax() * 1e3);
+    status.values.push_back(key_value);
+    if (allocationTrackingEnabled())
+    {
+      AllocationStatistics &allocations = stage_allocations_[i];
+      key_value.key = "mean allocations";
+      key_value.value = stringFormat("%.2f", allocations.getMeanAllocations());
+      status.values.push_back(key_value);
+      key_value.key = "max allocations";
+      key_value.value = stringFormat("%" PRIu64, allocations.getMaxAllocations());
+      status.values.push_back(key_value);
+      key_value.key = "mean allocated (bytes)";
+      key_value.value = stringFormat("%.1f", allocations.getMeanBytes());
+      status.values.push_back(key_value);
+      allocations.reset();
+    }
+    msg.status.push_back(status);
+    statistics.reset();
+  }
+
+  CycleArena* arena = model_->getCycleArena();
+  diagnostic_msgs::DiagnosticStatus status;
+  status.name = "shc: cycle_arena";
+  status.hardware_id = "syropod_highlevel_controller";
+  status.level = diagnostic_msgs::DiagnosticStatus::OK;
+  status.message = stringFormat("peak %zu of %zu bytes", arena->getPeakUsed(), arena->getCapacity());
+  diagnostic_msgs::KeyValue key_value;
+  key_value.key = "capacity (bytes)";
+  key_value.value = stringFormat("%zu", arena->getCapacity());
+  status.values.push_back(key_value);
+  key_value.key = "peak used (bytes)";
+  key_value.value = stringFormat("%zu", arena->getPeakUsed());
+  status.values.push_back(key_value);
+  key_value.key = "heap fallbacks";
+  key_value.value = stringFormat("%" PRIu64, arena->getOverflowCount());
+  status.values.push_back(key_value);
+  msg.status.push_back(status);
+
+  if (allocationTrackingEnabled())
+  {
+    uint64_t violations = getThreadAllocationCounts().guard_violations_;
+    status.name = "shc: allocation_guard";
+    status.level = (violations > 0) ? diagnostic_msgs::DiagnosticStatus::WARN : diagnostic_msgs::DiagnosticStatus::OK;
+    status.message = stringFormat("%" PRIu64 " violations", violations);
+    status.values.clear();
+    key_value.key = "mode";
+    key_value.value = params_.allocation_guard.data;
+    status.values.push_back(key_value);
+    key_value.key = "violations";
+    key_value.value = stringFormat("%" PRIu64, violations);
+    status.values.push_back(key_value);
+    msg.status.push_back(status);
+  }
+
+  EventLog* event_log = model_->getEventLog();
+  status.name = "shc: events";
+  status.level = (event_log->getDroppedCount() > 0) ? diagnostic_msgs::DiagnosticStatus::WARN
+                                                     : diagnostic_msgs::DiagnosticStatus::OK;
+  status.message = stringFormat("%" PRIu64 " dropped", event_log->getDroppedCount());
+  status.values.clear();
+  for (int i = 0; i < EVENT_TYPE_COUNT; ++i)
+  {
+    key_value.key = EVENT_TYPE_NAMES[i];
+    key_value.value = stringFormat("%" PRIu64, event_log->getEventCount(static_cast<EventType>(i)));
+    status.values.push_back(key_value);
+  }
+  msg.status.push_back(status);
+  timing_diagnostics_publisher_.publish(msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void StateController::publishLoopTiming(RealTimeLoop &loop)
+{
+  std_msgs::Float32MultiArray msg;
+  msg.data.clear();
+  msg.data.push_back(static_cast<float>(loop.getJitter()));
+  msg.data.push_back(static_cast<float>(loop.getMeanJitter()));
+  msg.data.push_back(static_cast<float>(loop.getMaxJitter()));
+  msg.data.push_back(static_cast<float>(loop.getComputeTime()));
+  msg.data.push_back(static_cast<float>(loop.getMaxComputeTime()));
+  msg.data.push_back(static_cast<float>(loop.getOverrunCount()));
+  msg.data.push_back(static_cast<float>(loop.getSkippedCycleCount()));
+  msg.data.push_back(static_cast<float>(loop.getCycleCount()));
+  loop_timing_publisher_.publish(msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void StateController::publishFrameTransforms(void)
 {
+  ScopedTimer timer(getStageTiming(FRAME_TRANSFORMS_PUBLISH_STAGE),
+                    getStageAllocations(FRAME_TRANSFORMS_PUBLISH_STAGE));
+  ros::Time now = ros::Time::now();
+
+  // Probe tf tree for odom transform from perception at low rate and regenerate frame transforms if changed
+  if (frame_transforms_.empty() || (now - odom_probe_time_).toSec() >= ODOM_PROBE_PERIOD)
+  {
+    odom_probe_time_ = now;
+    bool odom_available = transform_buffer_.canTransform("base_link", "odom", ros::Time(0));
+    if (frame_transforms_.empty() || odom_available != odom_available_)
+    {
+      odom_available_ = odom_available;
+      generateFrameTransforms();
+    }
+  }
+
   Pose odom_ideal_to_walk_plane = walker_->getOdometryIdeal();
   Pose walk_plane_to_base_link = model_->getCurrentPose();
   Pose odom_ideal_to_base_link = odom_ideal_to_walk_plane.addPose(walk_plane_to_base_link);
+  std::vector<geometry_msgs::TransformStamped>::iterator transform_it = frame_transforms_.begin();
 
-  // Broadcast ideal odom tf, if odom tf from perception does not exist on tf tree
-  try
+  // Ideal odom frame to Base Link frame transform, if odom tf from perception does not exist on tf tree
+  if (!odom_available_)
   {
-    fixed_frame_id_ = "odom";
-    transform_buffer_.lookupTransform("base_link", "odom", ros::Time(0));
-  }
-  catch (tf2::TransformException &ex)
-  {
-    ROS_WARN_ONCE("\n[SHC] No odom transform exists in tf tree - using ideal odometry\n");
-
-    fixed_frame_id_ = "odom_ideal";
-    geometry_msgs::TransformStamped odom_to_base_link;
-    odom_to_base_link.header.stamp = ros::Time::now();
-    odom_to_base_link.header.frame_id = "odom_ideal";
-    odom_to_base_link.child_frame_id = "base_link";
-    odom_to_base_link.transform.translation.x = odom_ideal_to_base_link.position_[0];
-    odom_to_base_link.transform.translation.y = odom_ideal_to_base_link.position_[1];
-    odom_to_base_link.transform.translation.z = odom_ideal_to_base_link.position_[2];
-    odom_to_base_link.transform.rotation.w = odom_ideal_to_base_link.rotation_.w();
-    odom_to_base_link.transform.rotation.x = odom_ideal_to_base_link.rotation_.x();
-    odom_to_base_link.transform.rotation.y = odom_ideal_to_base_link.rotation_.y();
-    odom_to_base_link.transform.rotation.z = odom_ideal_to_base_link.rotation_.z();
-    transform_broadcaster_.sendTransform(odom_to_base_link);
+    transform_it->header.stamp = now;
+    transform_it->transform = odom_ideal_to_base_link.toTransformMessage();
+    ++transform_it;
   }
 
   // Base Link frame to Walk Plane frame transform
-  geometry_msgs::TransformStamped base_link_to_walk_plane;
-  base_link_to_walk_plane.header.stamp = ros::Time::now();
-  base_link_to_walk_plane.header.frame_id = "base_link";
-  base_link_to_walk_plane.child_frame_id = "walk_plane";
-  base_link_to_walk_plane.transform.translation.x = (~walk_plane_to_base_link).position_[0];
-  base_link_to_walk_plane.transform.translation.y = (~walk_plane_to_base_link).position_[1];
-  base_link_to_walk_plane.transform.translation.z = (~walk_plane_to_base_link).position_[2];
-  base_link_to_walk_plane.transform.rotation.w = (~walk_plane_to_base_link).rotation_.w();
-  base_link_to_walk_plane.transform.rotation.x = (~walk_plane_to_base_link).rotation_.x();
-  base_link_to_walk_plane.transform.rotation.y = (~walk_plane_to_base_link).rotation_.y();
-  base_link_to_walk_plane.transform.rotation.z = (~walk_plane_to_base_link).rotation_.z();
-  transform_broadcaster_.sendTransform(base_link_to_walk_plane);
+  transform_it->header.stamp = now;
+  transform_it->transform = (~walk_plane_to_base_link).toTransformMessage();
+  ++transform_it;
 
   // Base Link frame to Joint/Tip frames
+  bool publish_joint_frames = params_.publish_joint_frames.data;
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
-    for (joint_it_ = leg->getJointContainer()->begin(); joint_it_ != leg->getJointContainer()->end(); ++joint_it_)
+    for (joint_it_ = leg->getJointContainer()->begin();
+         joint_it_ != leg->getJointContainer()->end() && publish_joint_frames; ++joint_it_)
     {
       std::shared_ptr<Joint> joint = joint_it_->second;
       Pose joint_robot_frame = joint->getPoseRobotFrame();
-      geometry_msgs::TransformStamped base_link_to_joint;
-      base_link_to_joint.header.stamp = ros::Time::now();
-      base_link_to_joint.header.frame_id = "base_link";
-      base_link_to_joint.child_frame_id = joint->id_name_;
-      base_link_to_joint.transform.translation.x = joint_robot_frame.position_[0];
-      base_link_to_joint.transform.translation.y = joint_robot_frame.position_[1];
-      base_link_to_joint.transform.translation.z = joint_robot_frame.position_[2];
-      Eigen::Quaterniond rotation =
+      joint_robot_frame.rotation_ =
         joint_robot_frame.rotation_ * Eigen::AngleAxisd(joint->desired_position_, Eigen::Vector3d::UnitZ());
-      base_link_to_joint.transform.rotation.w = rotation.w();
-      base_link_to_joint.transform.rotation.x = rotation.x();
-      base_link_to_joint.transform.rotation.y = rotation.y();
-      base_link_to_joint.transform.rotation.z = rotation.z();
-      transform_broadcaster_.sendTransform(base_link_to_joint);
+      transform_it->header.stamp = now;
+      transform_it->transform = joint_robot_frame.toTransformMessage();
+      ++transform_it;
     }
 
-    geometry_msgs::TransformStamped base_link_to_tip;
-    std::shared_ptr<Tip> tip = leg->getTip();
-    Pose tip_robot_frame = tip->getPoseRobotFrame();
-    base_link_to_tip.header.stamp = ros::Time::now();
-    base_link_to_tip.header.frame_id = "base_link";
-    base_link_to_tip.child_frame_id = tip->id_name_;
-    base_link_to_tip.transform.translation.x = tip_robot_frame.position_[0];
-    base_link_to_tip.transform.translation.y = tip_robot_frame.position_[1];
-    base_link_to_tip.transform.translation.z = tip_robot_frame.position_[2];
-    base_link_to_tip.transform.rotation.w = tip_robot_frame.rotation_.w();
-    base_link_to_tip.transform.rotation.x = tip_robot_frame.rotation_.x();
-    base_link_to_tip.transform.rotation.y = tip_robot_frame.rotation_.y();
-    base_link_to_tip.transform.rotation.z = tip_robot_frame.rotation_.z();
-    transform_broadcaster_.sendTransform(base_link_to_tip);
+    transform_it->header.stamp = now;
+    transform_it->transform = leg->getTip()->getPoseRobotFrame().toTransformMessage();
+    ++transform_it;
   }
+
+  transform_broadcaster_.sendTransform(frame_transforms_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void StateController::RVIZDebugging(void)
+void StateController::generateFrameTransforms(void)
 {
-  debug_visualiser_.generateRobotModel(model_);
-  debug_visualiser_.generateGravity(poser_->estimateGravity());
-  debug_visualiser_.generateWalkPlane(walker_->getWalkPlane(), walker_->getWalkPlaneNormal());
-  debug_visualiser_.generateTerrainEstimate(model_);
+  frame_transforms_.clear();
+  geometry_msgs::TransformStamped transform;
 
+  // Ideal odom frame to Base Link frame transform, if odom tf from perception does not exist on tf tree
+  if (odom_available_)
+  {
+    fixed_frame_id_ = "odom";
+  }
+  else
+  {
+    ROS_WARN_ONCE("\n[SHC] No odom transform exists in tf tree - using ideal odometry\n");
+    fixed_frame_id_ = "odom_ideal";
+    transform.header.frame_id = "odom_ideal";
+    transform.child_frame_id = "base_link";
+    frame_transforms_.push_back(transform);
+  }
+
+  // Base Link frame to Walk Plane frame transform
+  transform.header.frame_id = "base_link";
+  transform.child_frame_id = "walk_plane";
+  frame_transforms_.push_back(transform);
+
+  // Base Link frame to Joint/Tip frames
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
-    debug_visualiser_.generateTipTrajectory(leg);
-    debug_visualiser_.generateJointTorques(leg);
-
-    if (robot_state_ == RUNNING)
-    {
-      debug_visualiser_.generateDefaultTipPositions(leg);
-      debug_visualiser_.generateTargetTipPositions(leg);
-      debug_visualiser_.generateWorkspace(leg, walker_->getBodyClearance());
-      debug_visualiser_.generateWalkspace(leg, walker_->getWalkspace());
-      debug_visualiser_.generateBezierCurves(leg);
-      debug_visualiser_.generateStride(leg);
-      if (params_.admittance_control.data)
-      {
-        debug_visualiser_.generateTipForce(leg);
-      }
+    for (joint_it_ = leg->getJointContainer()->begin();
+         joint_it_ != leg->getJointContainer()->end() && params_.publish_joint_frames.data; ++joint_it_)
+    {
+      transform.child_frame_id = joint_it_->second->id_name_;
+      frame_transforms_.push_back(transform);
     }
+    transform.child_frame_id = leg->getTip()->id_name_;
+    frame_transforms_.push_back(transform);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+void StateController::RVIZDebugging(void)
+{
+  ScopedTimer timer(getStageTiming(RVIZ_DEBUGGING_STAGE), getStageAllocations(RVIZ_DEBUGGING_STAGE));
+  debug_visualiser_->captureState(model_, walker_, robot_state_ == RUNNING, params_.admittance_control.data);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 void StateController::systemStateCallback(const std_msgs::Int8 &input)
 {
+  recordInput(SYSTEM_STATE_INPUT, input);
   new_system_state_ = static_cast<SystemState>(int(input.data));
   if (system_state_ != new_system_state_)
   {
@@ -1096,6 +2065,7 @@ void StateController::systemStateCallback(const std_msgs::Int8 &input)
 
 void StateController::robotStateCallback(const std_msgs::Int8 &input)
 {
+  recordInput(ROBOT_STATE_INPUT, input);
   RobotState input_state = static_cast<RobotState>(int(input.data));
 
   // Wait for any other transitions to complete
@@ -1126,6 +2096,7 @@ void StateController::robotStateCallback(const std_msgs::Int8 &input)
 
 void StateController::bodyVelocityInputCallback(const geometry_msgs::Twist &input)
 {
+  recordInput(BODY_VELOCITY_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     linear_velocity_input_ = Eigen::Vector2d(input.linear.x, input.linear.y) * params_.body_velocity_scaler.data;
@@ -1141,6 +2112,7 @@ void StateController::bodyVelocityInputCallback(const geometry_msgs::Twist &inpu
 
 void StateController::bodyPoseInputCallback(const geometry_msgs::Twist &input)
 {
+  recordInput(BODY_POSE_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     Eigen::Vector3d rotation_input(input.angular.x, input.angular.y, input.angular.z);
@@ -1153,6 +2125,7 @@ void StateController::bodyPoseInputCallback(const geometry_msgs::Twist &input)
 
 void StateController::posingModeCallback(const std_msgs::Int8 &input)
 {
+  recordInput(POSING_MODE_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     PosingMode new_posing_mode = static_cast<PosingMode>(int(input.data));
@@ -1192,6 +2165,7 @@ void StateController::posingModeCallback(const std_msgs::Int8 &input)
 
 void StateController::poseResetCallback(const std_msgs::Int8 &input)
 {
+  recordInput(POSE_RESET_INPUT, input);
   if (system_state_ != SUSPENDED && poser_ != NULL)
   {
     if (poser_->getPoseResetMode() != IMMEDIATE_ALL_RESET)
@@ -1205,6 +2179,7 @@ void StateController::poseResetCallback(const std_msgs::Int8 &input)
 
 void StateController::gaitSelectionCallback(const std_msgs::Int8 &input)
 {
+  recordInput(GAIT_SELECTION_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     GaitDesignation new_gait_selection = static_cast<GaitDesignation>(int(input.data));
@@ -1220,6 +2195,7 @@ void StateController::gaitSelectionCallback(const std_msgs::Int8 &input)
 
 void StateController::cruiseControlCallback(const std_msgs::Int8 &input)
 {
+  recordInput(CRUISE_CONTROL_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     CruiseControlMode new_cruise_control_mode = static_cast<CruiseControlMode>(int(input.data));
@@ -1228,7 +2204,9 @@ void StateController::cruiseControlCallback(const std_msgs::Int8 &input)
       cruise_control_mode_ = new_cruise_control_mode;
       if (new_cruise_control_mode == CRUISE_CONTROL_ON)
       {
-        cruise_control_end_time_ = ros::Time::now().toSec() + params_.cruise_control_time_limit.data;
+        // Time limit is measured in control cycles such that it is independent of wall-clock time (e.g. in replay)
+        cruise_control_end_cycle_ =
+            cycle_count_ + roundToInt(params_.cruise_control_time_limit.data / params_.time_delta.data);
         if (params_.force_cruise_velocity.data)
         {
           // Set cruise velocity according to parameters
@@ -1261,6 +2239,7 @@ void StateController::cruiseControlCallback(const std_msgs::Int8 &input)
 
 void StateController::plannerModeCallback(const std_msgs::Int8 &input)
 {
+  recordInput(PLANNER_MODE_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     PlannerMode new_planner_mode = static_cast<PlannerMode>(int(input.data));
@@ -1284,6 +2263,7 @@ void StateController::plannerModeCallback(const std_msgs::Int8 &input)
 
 void StateController::primaryLegSelectionCallback(const std_msgs::Int8 &input)
 {
+  recordInput(PRIMARY_LEG_SELECTION_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     LegDesignation new_primary_leg_selection = static_cast<LegDesignation>(input.data);
@@ -1307,6 +2287,7 @@ void StateController::primaryLegSelectionCallback(const std_msgs::Int8 &input)
 
 void StateController::secondaryLegSelectionCallback(const std_msgs::Int8 &input)
 {
+  recordInput(SECONDARY_LEG_SELECTION_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     LegDesignation new_secondary_leg_selection = static_cast<LegDesignation>(input.data);
@@ -1330,6 +2311,7 @@ void StateController::secondaryLegSelectionCallback(const std_msgs::Int8 &input)
 
 void StateController::primaryLegStateCallback(const std_msgs::Int8 &input)
 {
+  recordInput(PRIMARY_LEG_STATE_INPUT, input);
   if (robot_state_ == RUNNING && !transition_state_flag_)
   {
     LegState newPrimaryLegState = static_cast<LegState>(int(input.data));
@@ -1358,6 +2340,7 @@ void StateController::primaryLegStateCallback(const std_msgs::Int8 &input)
 
 void StateController::secondaryLegStateCallback(const std_msgs::Int8 &input)
 {
+  recordInput(SECONDARY_LEG_STATE_INPUT, input);
   if (robot_state_ == RUNNING && !transition_state_flag_)
   {
     LegState newSecondaryLegState = static_cast<LegState>(int(input.data));
@@ -1386,6 +2369,7 @@ void StateController::secondaryLegStateCallback(const std_msgs::Int8 &input)
 
 void StateController::primaryTipVelocityInputCallback(const geometry_msgs::Point &input)
 {
+  recordInput(PRIMARY_TIP_VELOCITY_INPUT, input);
   primary_tip_velocity_input_ = Eigen::Vector3d(input.x, input.y, input.z);
 }
 
@@ -1393,6 +2377,7 @@ void StateController::primaryTipVelocityInputCallback(const geometry_msgs::Point
 
 void StateController::secondaryTipVelocityInputCallback(const geometry_msgs::Point &input)
 {
+  recordInput(SECONDARY_TIP_VELOCITY_INPUT, input);
   secondary_tip_velocity_input_ = Eigen::Vector3d(input.x, input.y, input.z);
 }
 
@@ -1400,6 +2385,7 @@ void StateController::secondaryTipVelocityInputCallback(const geometry_msgs::Poi
 
 void StateController::primaryTipPoseInputCallback(const geometry_msgs::Pose &input)
 {
+  recordInput(PRIMARY_TIP_POSE_INPUT, input);
   primary_pose_input_.position_ = Eigen::Vector3d(input.position.x, input.position.y, input.position.z);
   primary_pose_input_.rotation_ =
     Eigen::Quaterniond(input.orientation.w, input.orientation.x, input.orientation.y, input.orientation.z);
@@ -1409,6 +2395,7 @@ void StateController::primaryTipPoseInputCallback(const geometry_msgs::Pose &inp
 
 void StateController::secondaryTipPoseInputCallback(const geometry_msgs::Pose &input)
 {
+  recordInput(SECONDARY_TIP_POSE_INPUT, input);
   secondary_pose_input_.position_ = Eigen::Vector3d(input.position.x, input.position.y, input.position.z);
   secondary_pose_input_.rotation_ =
     Eigen::Quaterniond(input.orientation.w, input.orientation.x, input.orientation.y, input.orientation.z);
@@ -1418,6 +2405,7 @@ void StateController::secondaryTipPoseInputCallback(const geometry_msgs::Pose &i
 
 void StateController::parameterSelectionCallback(const std_msgs::Int8& input)
 {
+  recordInput(PARAMETER_SELECTION_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     ParameterSelection new_parameter_selection = static_cast<ParameterSelection>(int(input.data));
@@ -1441,6 +2429,7 @@ void StateController::parameterSelectionCallback(const std_msgs::Int8& input)
 
 void StateController::parameterAdjustCallback(const std_msgs::Int8& input)
 {
+  recordInput(PARAMETER_ADJUST_INPUT, input);
   if (robot_state_ == RUNNING)
   {
     int adjust_direction = input.data; // -1 || 0 || 1 (Decrease, no adjustment, increase)
@@ -1551,15 +2540,14 @@ void StateController::dynamicParameterCallback(syropod_highlevel_controller::Dyn
 
 void StateController::imuCallback(const sensor_msgs::Imu &data)
 {
-  if (system_state_ != SUSPENDED && poser_ != NULL)
-  {
-    Eigen::Quaterniond orientation(data.orientation.w, data.orientation.x, data.orientation.y, data.orientation.z);
-    Eigen::Vector3d angular_velocity(data.angular_velocity.x, data.angular_velocity.y, data.angular_velocity.z);
-    Eigen::Vector3d linear_acceleration(data.linear_acceleration.x,
-                                        data.linear_acceleration.y,
-                                        data.linear_acceleration.z);
-    model_->setImuData(orientation, linear_acceleration, angular_velocity);
-  }
+  sensor_input_.imu_received_ = true;
+  sensor_input_.imu_orientation_ =
+    Eigen::Quaterniond(data.orientation.w, data.orientation.x, data.orientation.y, data.orientation.z);
+  sensor_input_.imu_angular_velocity_ =
+    Eigen::Vector3d(data.angular_velocity.x, data.angular_velocity.y, data.angular_velocity.z);
+  sensor_input_.imu_linear_acceleration_ =
+    Eigen::Vector3d(data.linear_acceleration.x, data.linear_acceleration.y, data.linear_acceleration.z);
+  sensor_data_.write(sensor_input_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1568,49 +2556,25 @@ void StateController::jointStatesCallback(const sensor_msgs::JointState &joint_s
   bool get_effort_values = (joint_states.effort.size() != 0);
   bool get_velocity_values = (joint_states.velocity.size() != 0);
 
-  // Iterate through message and assign found state values to joint objects
+  // Iterate through message and store found state values of known joints
   for (uint i = 0; i < joint_states.name.size(); ++i)
   {
-    std::string joint_name = joint_states.name[i];
-    std::string leg_name = joint_name.substr(0, joint_name.find("_"));
-    std::shared_ptr<Leg> leg = model_->getLegByIDName(leg_name);
-    if (leg != NULL)
+    std::map<std::string, int>::const_iterator index_it = sensor_joint_indices_.find(joint_states.name[i]);
+    if (index_it != sensor_joint_indices_.end())
     {
-      std::shared_ptr<Joint> joint = leg->getJointByIDName(joint_name);
-      if (joint != NULL)
+      int joint_index = index_it->second;
+      sensor_input_.joint_position_[joint_index] = joint_states.position[i];
+      if (get_velocity_values)
       {
-        joint->current_position_ = joint_states.position[i] - joint->offset_;
-        if (get_velocity_values)
-        {
-          joint->current_velocity_ = joint_states.velocity[i];
-        }
-        if (get_effort_values)
-        {
-          joint->current_effort_ = joint_states.effort[i];
-          joint->desired_effort_ = joint->current_effort_; // HACK
-        }
+        sensor_input_.joint_velocity_[joint_index] = joint_states.velocity[i];
       }
-    }
-  }
-
-  // Check if all joint positions have been received from topic
-  if (!joint_positions_initialised_)
-  {
-    joint_positions_initialised_ = true;
-    for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
-    {
-      std::shared_ptr<Leg> leg = leg_it_->second;
-      JointContainer::iterator joint_it;
-      for (joint_it = leg->getJointContainer()->begin(); joint_it != leg->getJointContainer()->end(); ++joint_it)
+      if (get_effort_values)
       {
-        std::shared_ptr<Joint> joint = joint_it->second;
-        if (joint->current_position_ == UNASSIGNED_VALUE)
-        {
-          joint_positions_initialised_ = false;
-        }
+        sensor_input_.joint_effort_[joint_index] = joint_states.effort[i];
       }
     }
   }
+  sensor_data_.write(sensor_input_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1620,16 +2584,15 @@ void StateController::tipStatesCallback(const syropod_highlevel_controller::TipS
   bool get_wrench_values = tip_states.wrench.size() > 0;
   bool get_step_plane_values = tip_states.step_plane.size() > 0;
 
-  // Iterate through message and assign found contact proximity value to leg objects
-  std::string error_string;
+  // Iterate through message and store found tip state values of known legs
   for (uint i = 0; i < tip_states.name.size(); ++i)
   {
     std::string tip_name = tip_states.name[i];
     std::string leg_name = tip_name.substr(0, tip_name.find("_"));
-    std::shared_ptr<Leg> leg = model_->getLegByIDName(leg_name);
-    if (leg != NULL)
+    std::map<std::string, int>::const_iterator index_it = sensor_leg_indices_.find(leg_name);
+    if (index_it != sensor_leg_indices_.end())
     {
-      std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+      int leg_index = index_it->second;
       if (get_wrench_values)
       {
         Eigen::Vector3d tip_force(tip_states.wrench[i].force.x,
@@ -1638,50 +2601,31 @@ void StateController::tipStatesCallback(const syropod_highlevel_controller::TipS
         Eigen::Vector3d tip_torque(tip_states.wrench[i].torque.x,
                                   tip_states.wrench[i].torque.y,
                                   tip_states.wrench[i].torque.z);
-        if (leg_stepper != NULL)
+        sensor_input_.wrench_count_[leg_index]++;
+        sensor_input_.tip_force_.col(leg_index) = tip_force.array();
+        sensor_input_.tip_torque_.col(leg_index) = tip_torque.array();
+        if (!params_.use_joint_effort.data)
         {
-          leg_stepper->setTouchdownDetection(true);
+          admittance_->pushTipForce(leg_index, tip_force);
         }
-        leg->setTipForceMeasured(tip_force);
-        leg->setTipTorqueMeasured(tip_torque);
-        leg->touchdownDetection();
       }
       if (get_step_plane_values)
       {
-        if (leg_stepper != NULL)
-        {
-          leg_stepper->setTouchdownDetection(true);
-        }
-        if (tip_states.step_plane[i].z != UNASSIGNED_VALUE)
-        {
-          // From step plane representation calculate position and orientation of plane relative to tip frame
-          Eigen::Vector3d step_plane_position(tip_states.step_plane[i].z, 0.0, 0.0);
-          Eigen::Vector3d step_plane_normal(tip_states.step_plane[i].x, tip_states.step_plane[i].y, -1.0);
-          Eigen::Quaterniond step_plane_orientation = Eigen::Quaterniond::FromTwoVectors(Eigen::Vector3d(0, 0, 1.0),
-                                                                                        -step_plane_normal);
-
-          // Transform into robot frame and store
-          Pose step_plane_pose = leg->getTip()->getPoseRobotFrame(Pose(step_plane_position, step_plane_orientation));
-          leg->setStepPlanePose(step_plane_pose);
-        }
-        else
-        {
-          leg->setStepPlanePose(Pose::Undefined());
-          error_string += stringFormat("\nLost contact with tip range sensor/s of leg %s.\n", leg_name.c_str());
-        }
+        sensor_input_.step_plane_count_[leg_index]++;
+        sensor_input_.step_plane_.col(leg_index) << tip_states.step_plane[i].x,
+                                                    tip_states.step_plane[i].y,
+                                                    tip_states.step_plane[i].z;
       }
     }
   }
-  if (!error_string.empty())
-  {
-    ROS_ERROR_THROTTLE(THROTTLE_PERIOD, "%s", error_string.c_str());
-  }
+  sensor_data_.write(sensor_input_);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void StateController::targetConfigurationCallback(const sensor_msgs::JointState &target_configuration)
 {
+  recordInput(TARGET_CONFIGURATION_INPUT, target_configuration);
   poser_->setTargetConfiguration(target_configuration);
   target_configuration_acquired_ = true;
 }
@@ -1690,6 +2634,7 @@ void StateController::targetConfigurationCallback(const sensor_msgs::JointState
 
 void StateController::targetBodyPoseCallback(const geometry_msgs::Pose &target_body_pose)
 {
+  recordInput(TARGET_BODY_POSE_INPUT, target_body_pose);
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
@@ -1705,6 +2650,7 @@ void StateController::targetBodyPoseCallback(const geometry_msgs::Pose &target_b
 
 void StateController::targetTipPoseCallback(const syropod_highlevel_controller::TargetTipPose &msg)
 {
+  recordInput(TARGET_TIP_POSE_INPUT, msg);
   if (robot_state_ == RUNNING)
   {
     for (uint i = 0; i < msg.name.size(); ++i)
@@ -1727,7 +2673,7 @@ void StateController::targetTipPoseCallback(const syropod_highlevel_controller::
             external_target.pose_ = Pose(msg.target[i].pose);
             bool swing_clearance = msg.swing_clearance.size() > 0;
             external_target.swing_clearance_ = static_cast<double>(swing_clearance ? msg.swing_clearance[i] : 0.0);
-            external_target.time_ = msg.target[i].header.stamp;
+            external_target.time_ = msg.target[i].header.stamp.toSec();
             external_target.frame_id_ = msg.target[i].header.frame_id;
             external_target.transform_ = Pose::Identity(); // Correctly set from tf tree in main loop
             external_target.defined_ = true;
@@ -1748,7 +2694,7 @@ void StateController::targetTipPoseCallback(const syropod_highlevel_controller::
             ExternalTarget external_default;
             external_default.pose_ = Pose(msg.stance[i].pose);
             external_default.swing_clearance_ = 0.0;
-            external_default.time_ = msg.stance[i].header.stamp;
+            external_default.time_ = msg.stance[i].header.stamp.toSec();
             external_default.frame_id_ = msg.stance[i].header.frame_id;
             external_default.transform_ = Pose::Identity(); // Correctly set from tf tree in main loop
             external_default.defined_ = true;
@@ -1770,81 +2716,104 @@ void StateController::targetTipPoseCallback(const syropod_highlevel_controller::
 
 void StateController::initParameters(void)
 {
+  // Fetch all syropod parameters in a single parameter server request, from which parameters are then acquired
+  parameter_tree_.fetch("syropod");
+
   // Control parameters
-  params_.time_delta.init("time_delta");
-  params_.imu_posing.init("imu_posing");
-  params_.auto_posing.init("auto_posing");
-  params_.rough_terrain_mode.init("rough_terrain_mode");
-  params_.manual_posing.init("manual_posing");
-  params_.inclination_posing.init("inclination_posing");
-  params_.admittance_control.init("admittance_control");
+  params_.time_delta.init(parameter_tree_, "time_delta");
+  params_.output_rate.init(parameter_tree_, "output_rate");
+  params_.output_priority.init(parameter_tree_, "output_priority");
+  params_.real_time_loop.init(parameter_tree_, "real_time_loop");
+  params_.real_time_priority.init(parameter_tree_, "real_time_priority");
+  params_.real_time_cpu.init(parameter_tree_, "real_time_cpu");
+  params_.real_time_lock_memory.init(parameter_tree_, "real_time_lock_memory");
+  params_.imu_posing.init(parameter_tree_, "imu_posing");
+  params_.auto_posing.init(parameter_tree_, "auto_posing");
+  params_.rough_terrain_mode.init(parameter_tree_, "rough_terrain_mode");
+  params_.manual_posing.init(parameter_tree_, "manual_posing");
+  params_.inclination_posing.init(parameter_tree_, "inclination_posing");
+  params_.admittance_control.init(parameter_tree_, "admittance_control");
 
   // Hardware interface parameters
-  params_.individual_control_interface.init("individual_control_interface");
-  params_.combined_control_interface.init("combined_control_interface");
+  params_.individual_control_interface.init(parameter_tree_, "individual_control_interface");
+  params_.combined_control_interface.init(parameter_tree_, "combined_control_interface");
 
   // Model parameters
-  params_.syropod_type.init("syropod_type");
-  params_.leg_id.init("leg_id");
-  params_.joint_id.init("joint_id");
-  params_.link_id.init("link_id");
-  params_.leg_DOF.init("leg_DOF");
-  params_.clamp_joint_positions.init("clamp_joint_positions");
-  params_.clamp_joint_velocities.init("clamp_joint_velocities");
-  params_.ignore_IK_warnings.init("ignore_IK_warnings");
+  params_.syropod_type.init(parameter_tree_, "syropod_type");
+  params_.leg_id.init(parameter_tree_, "leg_id");
+  params_.joint_id.init(parameter_tree_, "joint_id");
+  params_.link_id.init(parameter_tree_, "link_id");
+  params_.leg_DOF.init(parameter_tree_, "leg_DOF");
+  params_.clamp_joint_positions.init(parameter_tree_, "clamp_joint_positions");
+  params_.clamp_joint_velocities.init(parameter_tree_, "clamp_joint_velocities");
+  params_.ignore_IK_warnings.init(parameter_tree_, "ignore_IK_warnings");
 
   // Walk controller parameters
-  params_.gait_type.init("gait_type");
-  params_.body_clearance.init("body_clearance");
-  params_.step_frequency.init("step_frequency");
-  params_.swing_height.init("swing_height");
-  params_.swing_width.init("swing_width");
-  params_.step_depth.init("step_depth");
-  params_.stance_span_modifier.init("stance_span_modifier");
-  params_.velocity_input_mode.init("velocity_input_mode");
-  params_.body_velocity_scaler.init("body_velocity_scaler");
-  params_.force_cruise_velocity.init("force_cruise_velocity");
-  params_.linear_cruise_velocity.init("linear_cruise_velocity");
-  params_.angular_cruise_velocity.init("angular_cruise_velocity");
-  params_.cruise_control_time_limit.init("cruise_control_time_limit");
-  params_.overlapping_walkspaces.init("overlapping_walkspaces");
-  params_.force_normal_touchdown.init("force_normal_touchdown");
-  params_.gravity_aligned_tips.init("gravity_aligned_tips");
-  params_.liftoff_threshold.init("liftoff_threshold");
-  params_.touchdown_threshold.init("touchdown_threshold");
+  params_.gait_type.init(parameter_tree_, "gait_type");
+  params_.body_clearance.init(parameter_tree_, "body_clearance");
+  params_.step_frequency.init(parameter_tree_, "step_frequency");
+  params_.swing_height.init(parameter_tree_, "swing_height");
+  params_.swing_width.init(parameter_tree_, "swing_width");
+  params_.step_depth.init(parameter_tree_, "step_depth");
+  params_.stance_span_modifier.init(parameter_tree_, "stance_span_modifier");
+  params_.velocity_input_mode.init(parameter_tree_, "velocity_input_mode");
+  params_.body_velocity_scaler.init(parameter_tree_, "body_velocity_scaler");
+  params_.force_cruise_velocity.init(parameter_tree_, "force_cruise_velocity");
+  params_.linear_cruise_velocity.init(parameter_tree_, "linear_cruise_velocity");
+  params_.angular_cruise_velocity.init(parameter_tree_, "angular_cruise_velocity");
+  params_.cruise_control_time_limit.init(parameter_tree_, "cruise_control_time_limit");
+  params_.overlapping_walkspaces.init(parameter_tree_, "overlapping_walkspaces");
+  params_.force_normal_touchdown.init(parameter_tree_, "force_normal_touchdown");
+  params_.gravity_aligned_tips.init(parameter_tree_, "gravity_aligned_tips");
+  params_.liftoff_threshold.init(parameter_tree_, "liftoff_threshold");
+  params_.touchdown_threshold.init(parameter_tree_, "touchdown_threshold");
+  params_.gait_transition_cycles.init(parameter_tree_, "gait_transition_cycles");
+  params_.free_gait.init(parameter_tree_, "free_gait");
+  params_.free_gait_reach_margin.init(parameter_tree_, "free_gait_reach_margin");
+  params_.free_gait_stability_margin.init(parameter_tree_, "free_gait_stability_margin");
 
   // Pose controller parameters
-  params_.auto_pose_type.init("auto_pose_type");
-  params_.start_up_sequence.init("start_up_sequence");
-  params_.time_to_start.init("time_to_start");
-  params_.rotation_pid_gains.init("rotation_pid_gains");
-  params_.max_translation.init("max_translation");
-  params_.max_translation_velocity.init("max_translation_velocity");
-  params_.max_rotation.init("max_rotation");
-  params_.max_rotation_velocity.init("max_rotation_velocity");
-  params_.leg_manipulation_mode.init("leg_manipulation_mode");
+  params_.auto_pose_type.init(parameter_tree_, "auto_pose_type");
+  params_.start_up_sequence.init(parameter_tree_, "start_up_sequence");
+  params_.time_to_start.init(parameter_tree_, "time_to_start");
+  params_.rotation_pid_gains.init(parameter_tree_, "rotation_pid_gains");
+  params_.max_translation.init(parameter_tree_, "max_translation");
+  params_.max_translation_velocity.init(parameter_tree_, "max_translation_velocity");
+  params_.max_rotation.init(parameter_tree_, "max_rotation");
+  params_.max_rotation_velocity.init(parameter_tree_, "max_rotation_velocity");
+  params_.leg_manipulation_mode.init(parameter_tree_, "leg_manipulation_mode");
 
   // Admittance controller parameters
-  params_.dynamic_stiffness.init("dynamic_stiffness");
-  params_.use_joint_effort.init("use_joint_effort");
-  params_.integrator_step_time.init("integrator_step_time");
-  params_.virtual_mass.init("virtual_mass");
-  params_.virtual_stiffness.init("virtual_stiffness");
-  params_.load_stiffness_scaler.init("load_stiffness_scaler");
-  params_.swing_stiffness_scaler.init("swing_stiffness_scaler");
-  params_.virtual_damping_ratio.init("virtual_damping_ratio");
-  params_.force_gain.init("force_gain");
+  params_.dynamic_stiffness.init(parameter_tree_, "dynamic_stiffness");
+  params_.use_joint_effort.init(parameter_tree_, "use_joint_effort");
+  params_.integrator_step_time.init(parameter_tree_, "integrator_step_time");
+  params_.admittance_rate.init(parameter_tree_, "admittance_rate");
+  params_.virtual_mass.init(parameter_tree_, "virtual_mass");
+  params_.virtual_stiffness.init(parameter_tree_, "virtual_stiffness");
+  params_.load_stiffness_scaler.init(parameter_tree_, "load_stiffness_scaler");
+  params_.swing_stiffness_scaler.init(parameter_tree_, "swing_stiffness_scaler");
+  params_.virtual_damping_ratio.init(parameter_tree_, "virtual_damping_ratio");
+  params_.force_gain.init(parameter_tree_, "force_gain");
 
   // Debug Parameters
-  params_.debug_rviz.init("debug_rviz");
-  params_.console_verbosity.init("console_verbosity");
-  params_.debug_moveToJointPosition.init("debug_move_to_joint_position");
-  params_.debug_stepToPosition.init("debug_step_to_position");
-  params_.debug_swing_trajectory.init("debug_swing_trajectory");
-  params_.debug_stance_trajectory.init("debug_stance_trajectory");
-  params_.debug_execute_sequence.init("debug_execute_sequence");
-  params_.debug_workspace_calc.init("debug_workspace_calculations");
-  params_.debug_IK.init("debug_ik");
+  params_.debug_rviz.init(parameter_tree_, "debug_rviz");
+  params_.debug_rviz_rates.init(parameter_tree_, "debug_rviz_rates");
+  params_.timing_diagnostics_period.init(parameter_tree_, "timing_diagnostics_period");
+  params_.leg_states_rate.init(parameter_tree_, "leg_states_rate");
+  params_.publish_joint_frames.init(parameter_tree_, "publish_joint_frames");
+  params_.allocation_guard.init(parameter_tree_, "allocation_guard");
+  params_.allocation_guard_warmup.init(parameter_tree_, "allocation_guard_warmup");
+  params_.event_log_file.init(parameter_tree_, "event_log_file");
+  params_.input_record_file.init(parameter_tree_, "input_record_file");
+  params_.transition_cache_file.init(parameter_tree_, "transition_cache_file");
+  params_.console_verbosity.init(parameter_tree_, "console_verbosity");
+  params_.debug_moveToJointPosition.init(parameter_tree_, "debug_move_to_joint_position");
+  params_.debug_stepToPosition.init(parameter_tree_, "debug_step_to_position");
+  params_.debug_swing_trajectory.init(parameter_tree_, "debug_swing_trajectory");
+  params_.debug_stance_trajectory.init(parameter_tree_, "debug_stance_trajectory");
+  params_.debug_execute_sequence.init(parameter_tree_, "debug_execute_sequence");
+  params_.debug_workspace_calc.init(parameter_tree_, "debug_workspace_calculations");
+  params_.debug_IK.init(parameter_tree_, "debug_ik");
 
   // Init all joint and link parameters per leg
   if (params_.leg_id.initialised && params_.joint_id.initialised && params_.link_id.initialised)
@@ -1855,8 +2824,8 @@ void StateController::initParameters(void)
     for (leg_name_it = leg_ids.begin(); leg_name_it != leg_ids.end(); ++leg_name_it, ++leg_id_num)
     {
       std::string leg_id_name = *leg_name_it;
-      params_.leg_stance_positions[leg_id_num].init(leg_id_name + "_stance_position");
-      params_.link_parameters[leg_id_num][0].init(leg_id_name + "_base_link_parameters");
+      params_.leg_stance_positions[leg_id_num].init(parameter_tree_, leg_id_name + "_stance_position");
+      params_.link_parameters[leg_id_num][0].init(parameter_tree_, leg_id_name + "_base_link_parameters");
       uint joint_count = params_.leg_DOF.data[leg_id_name];
 
       if (joint_count > params_.joint_id.data.size() || joint_count > params_.link_id.data.size() + 1)
@@ -1873,8 +2842,8 @@ void StateController::initParameters(void)
           std::string joint_name = params_.joint_id.data[i - 1];
           std::string link_parameter_name = leg_id_name + "_" + link_name + "_link_parameters";
           std::string joint_parameter_name = leg_id_name + "_" + joint_name + "_joint_parameters";
-          params_.link_parameters[leg_id_num][i].init(link_parameter_name);
-          params_.joint_parameters[leg_id_num][i - 1].init(joint_parameter_name);
+          params_.link_parameters[leg_id_num][i].init(parameter_tree_, link_parameter_name);
+          params_.joint_parameters[leg_id_num][i - 1].init(parameter_tree_, joint_parameter_name);
         }
       }
     }
@@ -1890,6 +2859,11 @@ void StateController::initParameters(void)
   params_.adjustable_map.insert(AdjustableMapType::value_type(VIRTUAL_STIFFNESS, &params_.virtual_stiffness));
   params_.adjustable_map.insert(AdjustableMapType::value_type(VIRTUAL_DAMPING, &params_.virtual_damping_ratio));
   params_.adjustable_map.insert(AdjustableMapType::value_type(FORCE_GAIN, &params_.force_gain));
+  AdjustableMapType::iterator adjustable_it;
+  for (adjustable_it = params_.adjustable_map.begin(); adjustable_it != params_.adjustable_map.end(); ++adjustable_it)
+  {
+    adjustable_it->second->selection = adjustable_it->first;
+  }
 
   // Dynamic reconfigure server and callback setup
   dynamic_reconfigure_server_ = new dynamic_reconfigure::Server<syropod_highlevel_controller::DynamicConfig>(mutex_);
@@ -1932,6 +2906,20 @@ void StateController::initParameters(void)
   dynamic_reconfigure_server_->setConfigDefault(config_default);
   dynamic_reconfigure_server_->updateConfig(config_default);
 
+  // Preload gait parameters for all designated gaits so that gait changes require no parameter server requests
+  std::string base_gait_parameters_name = "syropod/gait_parameters/";
+  std::vector<std::string> gait_names = { "wave_gait", "amble_gait", "ripple_gait", "tripod_gait" };
+  std::vector<std::string>::iterator gait_name_it;
+  for (gait_name_it = gait_names.begin(); gait_name_it != gait_names.end(); ++gait_name_it)
+  {
+    std::string gait_parameters_name = base_gait_parameters_name + *gait_name_it + "/";
+    GaitParameters &gait_parameters = gait_parameters_[*gait_name_it];
+    gait_parameters.stance_phase.init(parameter_tree_, "stance_phase", gait_parameters_name, false);
+    gait_parameters.swing_phase.init(parameter_tree_, "swing_phase", gait_parameters_name, false);
+    gait_parameters.phase_offset.init(parameter_tree_, "phase_offset", gait_parameters_name, false);
+    gait_parameters.offset_multiplier.init(parameter_tree_, "offset_multiplier", gait_parameters_name, false);
+  }
+
   initGaitParameters(GAIT_UNDESIGNATED);
   initAutoPoseParameters();
 }
@@ -1955,17 +2943,52 @@ void StateController::initGaitParameters(const GaitDesignation &gait_selection)
       params_.gait_type.data = "amble_gait";
       break;
     case (GAIT_UNDESIGNATED):
-      params_.gait_type.init("gait_type");
+      params_.gait_type.init(parameter_tree_, "gait_type");
       break;
     default:
       break;
   }
 
-  std::string base_gait_parameters_name = "syropod/gait_parameters/";
-  params_.stance_phase.init("stance_phase", base_gait_parameters_name + params_.gait_type.data + "/");
-  params_.swing_phase.init("swing_phase", base_gait_parameters_name + params_.gait_type.data + "/");
-  params_.phase_offset.init("phase_offset", base_gait_parameters_name + params_.gait_type.data + "/");
-  params_.offset_multiplier.init("offset_multiplier", base_gait_parameters_name + params_.gait_type.data + "/");
+  // Acquire gait parameters from parameter server if not successfully preloaded
+  GaitParameters &gait_parameters = gait_parameters_[params_.gait_type.data];
+  if (!gait_parameters.stance_phase.initialised || !gait_parameters.swing_phase.initialised ||
+      !gait_parameters.phase_offset.initialised || !gait_parameters.offset_multiplier.initialised)
+  {
+    std::string gait_parameters_name = "syropod/gait_parameters/" + params_.gait_type.data + "/";
+    gait_parameters.stance_phase.init(parameter_tree_, "stance_phase", gait_parameters_name);
+    gait_parameters.swing_phase.init(parameter_tree_, "swing_phase", gait_parameters_name);
+    gait_parameters.phase_offset.init(parameter_tree_, "phase_offset", gait_parameters_name);
+    gait_parameters.offset_multiplier.init(parameter_tree_, "offset_multiplier", gait_parameters_name);
+  }
+
+  params_.stance_phase = gait_parameters.stance_phase;
+  params_.swing_phase = gait_parameters.swing_phase;
+  params_.phase_offset = gait_parameters.phase_offset;
+  params_.offset_multiplier = gait_parameters.offset_multiplier;
+  params_.resolve();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+GaitDesignation StateController::getGaitDesignation(const std::string &gait_type)
+{
+  if (gait_type == "tripod_gait")
+  {
+    return TRIPOD_GAIT;
+  }
+  else if (gait_type == "ripple_gait")
+  {
+    return RIPPLE_GAIT;
+  }
+  else if (gait_type == "wave_gait")
+  {
+    return WAVE_GAIT;
+  }
+  else if (gait_type == "amble_gait")
+  {
+    return AMBLE_GAIT;
+  }
+  return GAIT_UNDESIGNATED;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1982,20 +3005,21 @@ void StateController::initAutoPoseParameters(void)
     base_auto_pose_parameters_name += (params_.auto_pose_type.data + "/");
   }
 
-  params_.pose_frequency.init("pose_frequency", base_auto_pose_parameters_name);
-  params_.pose_phase_length.init("pose_phase_length", base_auto_pose_parameters_name);
-  params_.pose_phase_starts.init("pose_phase_starts", base_auto_pose_parameters_name);
-  params_.pose_phase_ends.init("pose_phase_ends", base_auto_pose_parameters_name);
-  params_.pose_negation_phase_starts.init("pose_negation_phase_starts", base_auto_pose_parameters_name);
-  params_.pose_negation_phase_ends.init("pose_negation_phase_ends", base_auto_pose_parameters_name);
-  params_.negation_transition_ratio.init("negation_transition_ratio", base_auto_pose_parameters_name);
-  params_.x_amplitudes.init("x_amplitudes", base_auto_pose_parameters_name);
-  params_.y_amplitudes.init("y_amplitudes", base_auto_pose_parameters_name);
-  params_.z_amplitudes.init("z_amplitudes", base_auto_pose_parameters_name);
-  params_.gravity_amplitudes.init("gravity_amplitudes", base_auto_pose_parameters_name);
-  params_.roll_amplitudes.init("roll_amplitudes", base_auto_pose_parameters_name);
-  params_.pitch_amplitudes.init("pitch_amplitudes", base_auto_pose_parameters_name);
-  params_.yaw_amplitudes.init("yaw_amplitudes", base_auto_pose_parameters_name);
+  params_.pose_frequency.init(parameter_tree_, "pose_frequency", base_auto_pose_parameters_name);
+  params_.pose_phase_length.init(parameter_tree_, "pose_phase_length", base_auto_pose_parameters_name);
+  params_.pose_phase_starts.init(parameter_tree_, "pose_phase_starts", base_auto_pose_parameters_name);
+  params_.pose_phase_ends.init(parameter_tree_, "pose_phase_ends", base_auto_pose_parameters_name);
+  params_.pose_negation_phase_starts.init(parameter_tree_, "pose_negation_phase_starts",
+                                          base_auto_pose_parameters_name);
+  params_.pose_negation_phase_ends.init(parameter_tree_, "pose_negation_phase_ends", base_auto_pose_parameters_name);
+  params_.negation_transition_ratio.init(parameter_tree_, "negation_transition_ratio", base_auto_pose_parameters_name);
+  params_.x_amplitudes.init(parameter_tree_, "x_amplitudes", base_auto_pose_parameters_name);
+  params_.y_amplitudes.init(parameter_tree_, "y_amplitudes", base_auto_pose_parameters_name);
+  params_.z_amplitudes.init(parameter_tree_, "z_amplitudes", base_auto_pose_parameters_name);
+  params_.gravity_amplitudes.init(parameter_tree_, "gravity_amplitudes", base_auto_pose_parameters_name);
+  params_.roll_amplitudes.init(parameter_tree_, "roll_amplitudes", base_auto_pose_parameters_name);
+  params_.pitch_amplitudes.init(parameter_tree_, "pitch_amplitudes", base_auto_pose_parameters_name);
+  params_.yaw_amplitudes.init(parameter_tree_, "yaw_amplitudes", base_auto_pose_parameters_name);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
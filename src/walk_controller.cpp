@@ -8,7 +8,6 @@
 
 #include "syropod_highlevel_controller/walk_controller.h"
 #include "syropod_highlevel_controller/pose_controller.h"
-#include "syropod_highlevel_controller/debug_visualiser.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -162,8 +161,8 @@ void WalkController::generateWalkspace(void)
           // Unable to find reference points which bound new walkspace point direction vector therefore set zero radius
           if (bearing_1 == workplane.rbegin()->first)
           {
-            ROS_WARN("\n[SHC] Unable to generate radius at bearing %d for leg %s and workplane at height %f.\n",
-                     bearing, leg->getIDName().c_str(), target_workplane_height);
+            model_->getEventLog()->record(WALKSPACE_RADIUS_EVENT, leg->getIDNumber(), EVENT_UNDEFINED_ID,
+                                          EVENT_UNDEFINED_ID, bearing, target_workplane_height);
             radius = 0.0;
             break;
           }
@@ -234,10 +233,6 @@ void WalkController::generateLimits(StepCycle step,
                                     LimitMap *max_linear_acceleration_ptr,
                                     LimitMap *max_angular_acceleration_ptr)
 {
-  int base_step_period = params_.stance_phase.data + params_.swing_phase.data;
-  int normaliser = step.period_ / base_step_period;
-  int base_step_offset = int(params_.phase_offset.data * normaliser);
-
   bool set_limits = (!max_linear_speed_ptr && !max_linear_acceleration_ptr &&
                      !max_angular_speed_ptr && !max_angular_acceleration_ptr);
   if (set_limits)
@@ -271,10 +266,8 @@ void WalkController::generateLimits(StepCycle step,
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
-    ROS_ASSERT(params_.offset_multiplier.data.count(leg->getIDName()));
-    int multiplier = params_.offset_multiplier.data.at(leg->getIDName());
     std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
-    int step_offset = (base_step_offset * multiplier) % step.period_;
+    int step_offset = generatePhaseOffset(step, leg->getIDNumber());
     leg_stepper->setPhaseOffset(step_offset);
     if (step_offset > step.swing_start_ && step_offset < step.swing_end_) // SWING STATE
     {
@@ -364,46 +357,35 @@ void WalkController::generateLimits(StepCycle step,
 
 StepCycle WalkController::generateStepCycle(const bool set_step_cycle)
 {
-  StepCycle step;
-  step.stance_end_ = static_cast<int>(params_.stance_phase.data * 0.5);
-  step.swing_start_ = step.stance_end_;
-  step.swing_end_ = step.swing_start_ + params_.swing_phase.data;
-  step.stance_start_ = step.swing_end_;
-
   // Normalises the step period to match the total number of iterations over a full step
   int base_step_period = params_.stance_phase.data + params_.swing_phase.data;
   double swing_ratio = double(params_.swing_phase.data) / double(base_step_period); // Modifies step frequency
 
   // Ensure step period is even and divisible by base step period and therefore gives whole even normaliser value
+  // Step frequency is adjusted to match corrected step period
   double raw_step_period = ((1.0 / params_.step_frequency.current_value) / time_delta_) / swing_ratio;
-  step.period_ = roundToEvenInt(raw_step_period / base_step_period) * base_step_period;
-
-  step.frequency_ = 1.0 / (step.period_ * time_delta_); // adjust step frequency to match corrected step period
-  int normaliser = step.period_ / base_step_period;
-  step.stance_end_ *= normaliser;
-  step.swing_start_ *= normaliser;
-  step.swing_end_ *= normaliser;
-  step.stance_start_ *= normaliser;
-
-  step.stance_period_ = mod(step.stance_end_ - step.stance_start_, step.period_);
-  step.swing_period_ = step.swing_end_ - step.swing_start_;
+  int normaliser = roundToEvenInt(raw_step_period / base_step_period);
+  StepCycle step = GaitTransition::generateStepCycle(static_cast<int>(params_.stance_phase.data * 0.5) * normaliser,
+                                                     params_.stance_phase.data * normaliser,
+                                                     params_.swing_phase.data * normaliser, time_delta_);
 
   // Ensure stance and swing periods are divisible by two
-  ROS_ASSERT(step.stance_period_ % 2 == 0);
-  ROS_ASSERT(step.swing_period_ % 2 == 0);
+  SHC_ASSERT(step.stance_period_ % 2 == 0);
+  SHC_ASSERT(step.swing_period_ % 2 == 0);
 
   // Set step cycle in walk controller and update phase in leg steppers for new parameters if required
   if (set_step_cycle)
   {
     step_ = step;
-    if (walk_state_ == MOVING)
+    for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
     {
-      for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+      std::shared_ptr<Leg> leg = leg_it_->second;
+      std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+      if (walk_state_ == MOVING)
       {
-        std::shared_ptr<Leg> leg = leg_it_->second;
-        std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
         leg_stepper->updatePhase();
       }
+      leg_stepper->updateTimetable();
     }
   }
   return step;
@@ -411,6 +393,153 @@ StepCycle WalkController::generateStepCycle(const bool set_step_cycle)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+int WalkController::generatePhaseOffset(const StepCycle &step, const int &leg_id)
+{
+  int base_step_period = params_.stance_phase.data + params_.swing_phase.data;
+  int normaliser = step.period_ / base_step_period;
+  int base_step_offset = int(params_.phase_offset.data * normaliser);
+  return (base_step_offset * params_.leg_offset_multiplier[leg_id]) % step.period_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool WalkController::generateGaitTransition(const int &transition_cycles)
+{
+  // Lift off is determined by events rather than the periodic step cycle in free gait
+  if (walk_state_ != MOVING || params_.free_gait.data)
+  {
+    return false;
+  }
+
+  // Plan transition from current phases to phase offsets of the step cycle generated from new gait parameters
+  StepCycle target_step = generateStepCycle(false);
+  int leg_count = model_->getLegCount();
+  std::vector<int> phases(leg_count);
+  std::vector<int> target_offsets(leg_count);
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    phases[leg->getIDNumber()] = leg->getLegStepper()->getPhase();
+    target_offsets[leg->getIDNumber()] = generatePhaseOffset(target_step, leg->getIDNumber());
+  }
+
+  // If the transition is refused the caller restores the current gait parameters and zeroes velocity inputs, such that
+  // the robot stops to change gait
+  GaitTransition gait_transition;
+  if (!gait_transition.generate(step_, target_step, phases, target_offsets, transition_cycles))
+  {
+    return false;
+  }
+  gait_transition_ = gait_transition;
+  gait_transition_iteration_ = 0;
+
+  // Apply initial step cycle and phases of planned transition and limits of the new gait
+  step_ = gait_transition_.getInitialStepCycle();
+  for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+  {
+    std::shared_ptr<Leg> leg = leg_it_->second;
+    std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+    leg_stepper->setPhase(gait_transition_.getInitialPhase(leg->getIDNumber()));
+    leg_stepper->updateProgress();
+    leg_stepper->updateTimetable();
+  }
+  generateLimits(target_step);
+  transition_velocity_scaler_ = gait_transition_.getVelocityScaler();
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+double WalkController::calculateStabilityMargin(std::shared_ptr<Leg> lifting_leg)
+{
+  // Generate support polygon from tips of legs in stance (ordered clockwise around body by leg id number)
+  CycleArenaScope arena_scope(model_->getCycleArena());
+  ArenaVector<Eigen::Vector2d> support_polygon(ArenaAllocator<Eigen::Vector2d>(model_->getCycleArena()));
+  support_polygon.reserve(model_->getLegCount());
+  for (int i = 0; i < model_->getLegCount(); ++i)
+  {
+    std::shared_ptr<Leg> leg = model_->getLegByIDNumber(i);
+    std::shared_ptr<LegStepper> leg_stepper = leg->getLegStepper();
+    if (leg != lifting_leg && leg->getLegState() == WALKING && leg_stepper->getStepState() != SWING)
+    {
+      Eigen::Vector3d tip_position = leg_stepper->getCurrentTipPose().position_;
+      support_polygon.push_back(Eigen::Vector2d(tip_position[0], tip_position[1]));
+    }
+  }
+
+  int vertex_count = support_polygon.size();
+  if (vertex_count < 3)
+  {
+    return -UNASSIGNED_VALUE;
+  }
+
+  // Determine winding direction of polygon from signed area
+  double signed_area = 0.0;
+  for (int i = 0; i < vertex_count; ++i)
+  {
+    Eigen::Vector2d vertex_1 = support_polygon[i];
+    Eigen::Vector2d vertex_2 = support_polygon[(i + 1) % vertex_count];
+    signed_area += vertex_1[0] * vertex_2[1] - vertex_2[0] * vertex_1[1];
+  }
+  double winding = (signed_area >= 0.0) ? 1.0 : -1.0;
+
+  // Stability margin is minimum signed distance from assumed centre of gravity to edges (positive inside polygon)
+  Eigen::Vector3d body_position = model_->getCurrentPose().position_;
+  Eigen::Vector2d centre_of_gravity(body_position[0], body_position[1]);
+  double stability_margin = UNASSIGNED_VALUE;
+  for (int i = 0; i < vertex_count; ++i)
+  {
+    Eigen::Vector2d edge = support_polygon[(i + 1) % vertex_count] - support_polygon[i];
+    Eigen::Vector2d to_centre = centre_of_gravity - support_polygon[i];
+    if (edge.norm() == 0.0)
+    {
+      continue;
+    }
+    double distance = winding * (edge[0] * to_centre[1] - edge[1] * to_centre[0]) / edge.norm();
+    stability_margin = std::min(stability_margin, distance);
+  }
+  return stability_margin;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool WalkController::updateFreeGait(std::shared_ptr<LegStepper> leg_stepper)
+{
+  // Swing periods are generated as per step cycle
+  if (leg_stepper->getStepState() != STANCE || !leg_stepper->hasCompletedFirstStep())
+  {
+    return true;
+  }
+
+  int final_stance_phase = mod(step_.stance_end_ - 1, step_.period_);
+  bool final_stance_iteration = (leg_stepper->getPhase() == final_stance_phase);
+  bool reach_exhausted = (leg_stepper->calculateRemainingReach() < params_.free_gait_reach_margin.data);
+  if (!reach_exhausted && !final_stance_iteration)
+  {
+    return true;
+  }
+
+  // Lift off (early if required) once reach is exhausted if stability margin of remaining support polygon allows it
+  std::shared_ptr<Leg> leg = leg_stepper->getParentLeg();
+  bool stable = (calculateStabilityMargin(leg) >= params_.free_gait_stability_margin.data);
+  if (reach_exhausted && stable)
+  {
+    leg_stepper->setPhase(final_stance_phase);
+    return true;
+  }
+  else if (reach_exhausted)
+  {
+    free_gait_stalled_legs_++;
+    SHC_DEBUG_THROTTLE(THROTTLE_PERIOD, "\n[SHC] Leg %s is unable to lift off without losing stability.\n",
+                       leg->getIDName().c_str());
+  }
+
+  // Extend stance by holding phase at end of stance period
+  return !final_stance_iteration;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 double WalkController::getLimit(const Eigen::Vector2d &linear_velocity_input,
                                 const double &angular_velocity_input,
                                 const LimitMap &limit)
@@ -468,15 +597,13 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
 
       if (linear_velocity_input.norm() > max_linear_speed)
       {
-        ROS_WARN_THROTTLE(THROTTLE_PERIOD,
-                          "\nInput linear speed (%f) exceeds maximum linear speed (%f) and has been clamped.\n",
-                          linear_velocity_input.norm(), max_linear_speed);
+        model_->getEventLog()->record(LINEAR_SPEED_CLAMPING_EVENT, EVENT_UNDEFINED_ID, EVENT_UNDEFINED_ID,
+                                      EVENT_UNDEFINED_ID, linear_velocity_input.norm(), max_linear_speed);
       }
       if (abs(angular_velocity_input) > max_angular_speed)
       {
-        ROS_WARN_THROTTLE(THROTTLE_PERIOD,
-                          "\nInput angular velocity (%f) exceeds maximum angular speed (%f) and has been clamped.\n",
-                          abs(angular_velocity_input), max_angular_speed);
+        model_->getEventLog()->record(ANGULAR_SPEED_CLAMPING_EVENT, EVENT_UNDEFINED_ID, EVENT_UNDEFINED_ID,
+                                      EVENT_UNDEFINED_ID, abs(angular_velocity_input), max_angular_speed);
       }
     }
   }
@@ -486,6 +613,17 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
     new_angular_velocity = 0.0;
   }
 
+  // Slow body to accomodate stance periods extended by blending or holding phase during gait transition
+  new_linear_velocity *= transition_velocity_scaler_;
+  new_angular_velocity *= transition_velocity_scaler_;
+
+  // Stop body whilst any leg has exhausted its reach but is unable to lift off without losing stability (free gait)
+  if (free_gait_stalled_legs_ > 0)
+  {
+    new_linear_velocity = Eigen::Vector2d(0.0, 0.0);
+    new_angular_velocity = 0.0;
+  }
+
   bool has_velocity_command = linear_velocity_input.norm() || angular_velocity_input;
 
   // Check that all legs are in WALKING state
@@ -497,7 +635,7 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
     {
       if (linear_velocity_input.norm())
       {
-        ROS_INFO_THROTTLE(THROTTLE_PERIOD,
+        SHC_INFO_THROTTLE(THROTTLE_PERIOD,
                           "\nUnable to walk whilst manually manipulating legs, ensure each leg is in walking state.\n");
       }
       return;
@@ -542,6 +680,8 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
       leg_stepper->setPhase(leg_stepper->getPhaseOffset());
       leg_stepper->updateStepState();
     }
+    transition_velocity_scaler_ = 1.0;
+    free_gait_stalled_legs_ = 0;
     return; // Skips iteration of phase so auto posing can catch up
   }
   // State transition: STARTING->MOVING
@@ -563,7 +703,25 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
     walk_state_ = STOPPED;
   }
 
+  // Abandon planned gait transition if no longer walking by applying the step cycle of the new gait in place
+  bool transitioning_gait = isTransitioningGait();
+  if (transitioning_gait && walk_state_ != MOVING)
+  {
+    step_ = gait_transition_.getStepCycle(gait_transition_.getIterationCount() - 1);
+    for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+    {
+      std::shared_ptr<LegStepper> leg_stepper = leg_it_->second->getLegStepper();
+      leg_stepper->updatePhase();
+      leg_stepper->updateTimetable();
+    }
+    gait_transition_.clear();
+    gait_transition_iteration_ = 0;
+    transition_velocity_scaler_ = 1.0;
+    transitioning_gait = false;
+  }
+
   // Update walk/step state and tip position along trajectory for each leg
+  free_gait_stalled_legs_ = 0;
   for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
   {
     std::shared_ptr<Leg> leg = leg_it_->second;
@@ -636,7 +794,49 @@ void WalkController::updateWalk(const Eigen::Vector2d &linear_velocity_input, co
     {
       leg_stepper->updateTipPosition(); // Updates current tip position through step cycle
       leg_stepper->updateTipRotation();
-      leg_stepper->iteratePhase();
+
+      // Lift off is determined by remaining reach and support polygon stability rather than phase in free gait
+      bool iterate_phase = true;
+      if (params_.free_gait.data && walk_state_ == MOVING)
+      {
+        iterate_phase = updateFreeGait(leg_stepper);
+      }
+
+      // Phase is set from planned gait transition (progress is updated once the planned step cycle is applied)
+      if (transitioning_gait)
+      {
+        leg_stepper->setPhase(gait_transition_.getPhase(gait_transition_iteration_, leg->getIDNumber()));
+      }
+      else if (iterate_phase)
+      {
+        leg_stepper->iteratePhase();
+      }
+    }
+  }
+
+  // Apply step cycle of planned gait transition (updating timing of each leg if changed)
+  if (transitioning_gait)
+  {
+    const StepCycle &step = gait_transition_.getStepCycle(gait_transition_iteration_);
+    bool step_cycle_changed = (step.period_ != step_.period_ || step.swing_period_ != step_.swing_period_ ||
+                               step.stance_end_ != step_.stance_end_);
+    step_ = step;
+    for (leg_it_ = model_->getLegContainer()->begin(); leg_it_ != model_->getLegContainer()->end(); ++leg_it_)
+    {
+      std::shared_ptr<LegStepper> leg_stepper = leg_it_->second->getLegStepper();
+      leg_stepper->updateProgress();
+      if (step_cycle_changed)
+      {
+        leg_stepper->updateTimetable();
+      }
+    }
+
+    // Gait transition complete
+    if (++gait_transition_iteration_ == gait_transition_.getIterationCount())
+    {
+      gait_transition_.clear();
+      gait_transition_iteration_ = 0;
+      transition_velocity_scaler_ = 1.0;
     }
   }
   updateWalkPlane();
@@ -695,8 +895,7 @@ void WalkController::updateManual(const int &primary_leg_selection_ID,
           if (ik_error.norm() >= IK_TOLERANCE)
           {
             tip_position_change = tip_position_change.norm() * -ik_error.normalized();
-            ROS_WARN_THROTTLE(THROTTLE_PERIOD, "\nCannot move leg %s any further due to IK or joint limits.\n",
-                              leg->getIDName().c_str());
+            model_->getEventLog()->record(LEG_MANIPULATION_LIMIT_EVENT, leg->getIDNumber());
           }
           Eigen::Vector3d new_tip_position = leg_stepper->getCurrentTipPose().position_ + tip_position_change;
           leg_stepper->setCurrentTipPose(Pose(new_tip_position, UNDEFINED_ROTATION));
@@ -768,8 +967,8 @@ void WalkController::updateWalkPlane(void)
     Eigen::MatrixXd pseudo_inverse_A = (A.transpose() * A).inverse() * A.transpose();
     walk_plane_ = (pseudo_inverse_A * B);
     walk_plane_normal_ = Eigen::Vector3d(-walk_plane_[0], -walk_plane_[1], 1.0).normalized();
-    ROS_ASSERT(walk_plane_.norm() < UNASSIGNED_VALUE);
-    ROS_ASSERT(walk_plane_normal_.norm() < UNASSIGNED_VALUE);
+    SHC_ASSERT(walk_plane_.norm() < UNASSIGNED_VALUE);
+    SHC_ASSERT(walk_plane_normal_.norm() < UNASSIGNED_VALUE);
   }
   else
   {
@@ -845,8 +1044,7 @@ LegStepper::LegStepper(std::shared_ptr<LegStepper> leg_stepper)
   swing_progress_ = leg_stepper->swing_progress_;
   stance_progress_ = leg_stepper->stance_progress_;
   step_state_ = leg_stepper->step_state_;
-  swing_delta_t_ = leg_stepper->swing_delta_t_;
-  stance_delta_t_ = leg_stepper->stance_delta_t_;
+  timetable_ = leg_stepper->timetable_;
 
   // Iterate through and initialise control nodes (5 control nodes for quartic (4th order) bezier curves)
   for (int i = 0; i < 5; ++i)
@@ -861,8 +1059,22 @@ LegStepper::LegStepper(std::shared_ptr<LegStepper> leg_stepper)
 
 void LegStepper::updatePhase(void)
 {
-  StepCycle step = walker_->getStepCycle();
-  phase_ = static_cast<int>(step_progress_ * step.period_);
+  const StepCycle &step = walker_->getStepCycle();
+  if (step_state_ == SWING && swing_progress_ >= 0.0)
+  {
+    int swing_iteration = roundToInt(swing_progress_ * step.swing_period_);
+    phase_ = step.swing_start_ + clamped(swing_iteration, 1, step.swing_period_) - 1;
+  }
+  else if (step_state_ == STANCE && stance_progress_ >= 0.0 && completed_first_step_)
+  {
+    int stance_iteration = roundToInt(stance_progress_ * step.stance_period_);
+    phase_ = mod(step.stance_start_ + clamped(stance_iteration, 1, step.stance_period_) - 1, step.period_);
+  }
+  else
+  {
+    phase_ = static_cast<int>(step_progress_ * step.period_);
+  }
+  step_progress_ = double(phase_) / step.period_;
   updateStepState();
 }
 
@@ -870,8 +1082,16 @@ void LegStepper::updatePhase(void)
 
 void LegStepper::iteratePhase(void)
 {
-  StepCycle step = walker_->getStepCycle();
+  const StepCycle &step = walker_->getStepCycle();
   phase_ = (phase_ + 1) % (step.period_);
+  updateProgress();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void LegStepper::updateProgress(void)
+{
+  const StepCycle &step = walker_->getStepCycle();
   updateStepState();
 
   // Calculate progress of stance/swing periods (0.0->1.0 or -1.0 if not in specific state)
@@ -901,19 +1121,50 @@ void LegStepper::iteratePhase(void)
 void LegStepper::updateStepState(void)
 {
   // Update step state from phase unless force stopped
-  StepCycle step = walker_->getStepCycle();
+  const StepCycle &step = walker_->getStepCycle();
   if (step_state_ == FORCE_STOP)
   {
     return;
   }
   else if (phase_ >= step.swing_start_ && phase_ < step.swing_end_ && step_state_ != FORCE_STANCE)
   {
-    step_state_ = SWING;
+    setStepState(SWING);
   }
   else if (phase_ < step.stance_end_ || phase_ >= step.stance_start_)
   {
-    step_state_ = STANCE;
+    setStepState(STANCE);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void LegStepper::updateTimetable(void)
+{
+  const StepCycle &step = walker_->getStepCycle();
+  double time_delta = walker_->getTimeDelta();
+
+  bool standard_stance_period = (step_state_ == SWING || completed_first_step_);
+  timetable_.modified_stance_start_ = standard_stance_period ? step.stance_start_ : phase_offset_;
+  timetable_.modified_stance_period_ = mod(step.stance_end_ - timetable_.modified_stance_start_, step.period_);
+  if (step.stance_end_ == timetable_.modified_stance_start_)
+  {
+    timetable_.modified_stance_period_ = step.period_;
   }
+  SHC_ASSERT(timetable_.modified_stance_period_ != 0);
+
+  // Calculates number of iterations for ENTIRE swing period and time delta used for EACH bezier curve time input
+  int swing_iterations = int((double(step.swing_period_) / step.period_) / (step.frequency_ * time_delta));
+  timetable_.swing_iterations_ = roundToEvenInt(swing_iterations);        // Must be even
+  timetable_.swing_delta_t_ = 1.0 / (timetable_.swing_iterations_ / 2.0); // 1 sec divided by iterations for each curve
+
+  // Calculates number of iterations for stance period and time delta used for bezier curve time input
+  double modified_stance_ratio = double(timetable_.modified_stance_period_) / step.period_;
+  timetable_.stance_iterations_ = int(modified_stance_ratio / (step.frequency_ * time_delta));
+  timetable_.stance_delta_t_ = 1.0 / timetable_.stance_iterations_; // 1 second divided by number of iterations
+
+  // Scales stride vector according to stance period specifically for STARTING state of walker
+  double standard_stance_period_length = mod(step.stance_end_ - step.stance_start_, step.period_);
+  timetable_.stride_scaler_ = double(timetable_.modified_stance_period_) / standard_stance_period_length;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -922,8 +1173,8 @@ void LegStepper::updateStride(void)
 {
   walk_plane_ = walker_->getWalkPlane();
   walk_plane_normal_ = walker_->getWalkPlaneNormal();
-  ROS_ASSERT(walk_plane_.norm() < UNASSIGNED_VALUE);
-  ROS_ASSERT(walk_plane_normal_.norm() < UNASSIGNED_VALUE);
+  SHC_ASSERT(walk_plane_.norm() < UNASSIGNED_VALUE);
+  SHC_ASSERT(walk_plane_normal_.norm() < UNASSIGNED_VALUE);
 
   // Linear stride vector
   Eigen::Vector2d velocity = walker_->getDesiredLinearVelocity();
@@ -936,7 +1187,7 @@ void LegStepper::updateStride(void)
 
   // Combination and scaling
   stride_vector_ = stride_vector_linear + stride_vector_angular;
-  StepCycle step = walker_->getStepCycle();
+  const StepCycle &step = walker_->getStepCycle();
   double on_ground_ratio = double(step.stance_period_) / step.period_;
   stride_vector_ *= (on_ground_ratio / step.frequency_);
 
@@ -946,6 +1197,37 @@ void LegStepper::updateStride(void)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+double LegStepper::calculateRemainingReach(void)
+{
+  // Direction of tip motion along walk plane during stance
+  Eigen::Vector3d stance_direction = -getRejection(stride_vector_, walk_plane_normal_);
+  const LimitMap &walkspace = walker_->getWalkspace();
+  if (stance_direction.norm() == 0.0 || walkspace.empty())
+  {
+    return 1.0;
+  }
+  stance_direction.normalize();
+
+  // Interpolate walkspace radius at bearing of stance direction
+  double bearing = radiansToDegrees(atan2(stance_direction[1], stance_direction[0]));
+  bearing += (bearing < 0.0) ? 360.0 : 0.0;
+  int lower_bearing = static_cast<int>(bearing / BEARING_STEP) * BEARING_STEP;
+  int upper_bearing = std::min(lower_bearing + BEARING_STEP, 360);
+  double control_input = (bearing - lower_bearing) / BEARING_STEP;
+  double radius = interpolate(walkspace.at(lower_bearing), walkspace.at(upper_bearing), control_input);
+  if (radius <= 0.0)
+  {
+    return 0.0;
+  }
+
+  // Remaining reach from current tip position (relative to default) to walkspace limit along stance direction
+  Eigen::Vector3d tip_offset = getRejection(current_tip_pose_.position_ - default_tip_pose_.position_,
+                                            walk_plane_normal_);
+  return (radius - tip_offset.dot(stance_direction)) / radius;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 Eigen::Vector3d LegStepper::calculateStanceSpanChange(void)
 {
   // Calculate target height of plane within workspace
@@ -1005,7 +1287,7 @@ void LegStepper::updateDefaultTipPosition(void)
 
   // Update default tip pose and set walkspace to be regenerated if required
   double default_tip_position_delta = (default_tip_pose_.position_ - new_default_tip_pose.position_).norm();
-  ROS_ASSERT(new_default_tip_pose.isValid());
+  SHC_ASSERT(new_default_tip_pose.isValid());
   default_tip_pose_ = new_default_tip_pose;
   if (default_tip_position_delta > IK_TOLERANCE)
   {
@@ -1020,25 +1302,12 @@ void LegStepper::updateTipPosition(void)
   bool rough_terrain_mode = walker_->getParameters().rough_terrain_mode.data;
   bool force_normal_touchdown = walker_->getParameters().force_normal_touchdown.data;
   double time_delta = walker_->getTimeDelta();
-  StepCycle step = walker_->getStepCycle();
-
-  bool standard_stance_period = (step_state_ == SWING || completed_first_step_);
-  int modified_stance_start = standard_stance_period ? step.stance_start_ : phase_offset_;
-  int modified_stance_period = mod(step.stance_end_ - modified_stance_start, step.period_);
-  if (step.stance_end_ == modified_stance_start)
-  {
-    modified_stance_period = step.period_;
-  }
-  ROS_ASSERT(modified_stance_period != 0);
+  const StepCycle &step = walker_->getStepCycle();
 
-  // Calculates number of iterations for ENTIRE swing period and time delta used for EACH bezier curve time input
-  int swing_iterations = int((double(step.swing_period_) / step.period_) / (step.frequency_ * time_delta));
-  swing_iterations = roundToEvenInt(swing_iterations); // Must be even
-  swing_delta_t_ = 1.0 / (swing_iterations / 2.0);     // 1 sec divided by number of iterations for each bezier curve
-
-  // Calculates number of iterations for stance period and time delta used for bezier curve time input
-  int stance_iterations = int((double(modified_stance_period) / step.period_) / (step.frequency_ * time_delta));
-  stance_delta_t_ = 1.0 / stance_iterations; // 1 second divided by number of iterations
+  // Swing/stance timing is precomputed on step state transitions (see updateTimetable)
+  const int swing_iterations = timetable_.swing_iterations_;
+  const double swing_delta_t = timetable_.swing_delta_t_;
+  const double stance_delta_t = timetable_.stance_delta_t_;
 
   // Generate default target
   target_tip_pose_.position_ = default_tip_pose_.position_ + 0.5 * stride_vector_;
@@ -1101,14 +1370,16 @@ void LegStepper::updateTipPosition(void)
       }
       else
       {
-        ROS_WARN_THROTTLE(THROTTLE_PERIOD, "\n[SHC] Rough terrain mode is enabled but SHC is not receiving"
-                                           "any tip state messages used for touchdown detection.\n");
+        walker_->getEventLog()->record(TIP_STATES_MISSING_EVENT, leg_->getIDNumber());
       }
     }
 
-    // Generate swing control nodes (once at beginning of 1st half and continuously for 2nd half)
+    // Generate swing control nodes (primary curve only during 1st half and continuously reactive during 2nd half)
     bool ground_contact = (leg_->getStepPlanePose() != Pose::Undefined() && rough_terrain_mode);
-    generatePrimarySwingControlNodes();
+    if (first_half)
+    {
+      generatePrimarySwingControlNodes();
+    }
     generateSecondarySwingControlNodes(!first_half && ground_contact);
     // Adjust control nodes to force touchdown normal to walk plane
     if (force_normal_touchdown && !ground_contact)
@@ -1120,21 +1391,21 @@ void LegStepper::updateTipPosition(void)
     double time_input = 0;
     if (first_half)
     {
-      time_input = swing_delta_t_ * iteration;
-      delta_pos = swing_delta_t_ * quarticBezierDot(swing_1_nodes_, time_input);
+      time_input = swing_delta_t * iteration;
+      delta_pos = swing_delta_t * quarticBezierDot(swing_1_nodes_, time_input);
     }
     else
     {
-      time_input = swing_delta_t_ * (iteration - swing_iterations / 2);
-      delta_pos = swing_delta_t_ * quarticBezierDot(swing_2_nodes_, time_input);
+      time_input = swing_delta_t * (iteration - swing_iterations / 2);
+      delta_pos = swing_delta_t * quarticBezierDot(swing_2_nodes_, time_input);
     }
 
-    ROS_ASSERT(time_input <= 1.0);
-    ROS_ASSERT(delta_pos.norm() < UNASSIGNED_VALUE);
+    SHC_ASSERT(time_input <= 1.0);
+    SHC_ASSERT(delta_pos.norm() < UNASSIGNED_VALUE);
     current_tip_pose_.position_ += delta_pos;
-    current_tip_velocity_ = delta_pos / walker_->getTimeDelta();
+    current_tip_velocity_ = delta_pos / time_delta;
 
-    ROS_DEBUG_COND(walker_->getParameters().debug_swing_trajectory.data && leg_->getIDNumber() == 0,
+    SHC_DEBUG_COND(walker_->getParameters().debug_swing_trajectory.data && leg_->getIDNumber() == 0,
                    "SWING TRAJECTORY_DEBUG - ITERATION: %d\t\t"
                    "TIME: %f\t\t"
                    "ORIGIN: %f:%f:%f\t\t"
@@ -1150,7 +1421,7 @@ void LegStepper::updateTipPosition(void)
   {
     updateStride();
 
-    int iteration = mod(phase_ + (step.period_ - modified_stance_start), step.period_) + 1;
+    int iteration = mod(phase_ + (step.period_ - timetable_.modified_stance_start_), step.period_) + 1;
 
     // Save initial tip position at beginning of stance
     if (iteration == 1)
@@ -1164,18 +1435,17 @@ void LegStepper::updateTipPosition(void)
     }
 
     // Scales stride vector according to stance period specifically for STARTING state of walker
-    double stride_scaler = double(modified_stance_period) / (mod(step.stance_end_ - step.stance_start_, step.period_));
-    generateStanceControlNodes(stride_scaler);
+    generateStanceControlNodes(timetable_.stride_scaler_);
 
     // Uses derivative of bezier curve to ensure correct velocity along ground, this means the position may not
     // reach the target but this is less important than ensuring correct velocity according to stride vector
-    double time_input = iteration * stance_delta_t_;
-    Eigen::Vector3d delta_pos = stance_delta_t_ * quarticBezierDot(stance_nodes_, time_input);
-    ROS_ASSERT(delta_pos.norm() < UNASSIGNED_VALUE);
+    double time_input = iteration * stance_delta_t;
+    Eigen::Vector3d delta_pos = stance_delta_t * quarticBezierDot(stance_nodes_, time_input);
+    SHC_ASSERT(delta_pos.norm() < UNASSIGNED_VALUE);
     current_tip_pose_.position_ += delta_pos;
-    current_tip_velocity_ = delta_pos / walker_->getTimeDelta();
+    current_tip_velocity_ = delta_pos / time_delta;
 
-    ROS_DEBUG_COND(walker_->getParameters().debug_stance_trajectory.data && leg_->getIDNumber() == 0,
+    SHC_DEBUG_COND(walker_->getParameters().debug_stance_trajectory.data && leg_->getIDNumber() == 0,
                    "STANCE TRAJECTORY_DEBUG - ITERATION: %d\t\t"
                    "TIME: %f\t\t"
                    "ORIGIN: %f:%f:%f\t\t"
@@ -1244,7 +1514,7 @@ void LegStepper::generatePrimarySwingControlNodes(void)
   bool positive_y_axis = (Eigen::Vector3d::UnitY().dot(identity_tip_pose_.position_) > 0.0);
   mid_tip_position[1] += positive_y_axis ? mid_lateral_shift : -mid_lateral_shift;
   Eigen::Vector3d stance_node_seperation =
-      0.25 * swing_origin_tip_velocity_ * (walker_->getTimeDelta() / swing_delta_t_);
+      0.25 * swing_origin_tip_velocity_ * (walker_->getTimeDelta() / timetable_.swing_delta_t_);
 
   // Control nodes for primary swing quartic bezier curves
   // Set for position continuity at transition between stance and primary swing curves (C0 Smoothness)
@@ -1264,8 +1534,9 @@ void LegStepper::generatePrimarySwingControlNodes(void)
 
 void LegStepper::generateSecondarySwingControlNodes(const bool &ground_contact)
 {
-  Eigen::Vector3d final_tip_velocity = -stride_vector_ * (stance_delta_t_ / walker_->getTimeDelta());
-  Eigen::Vector3d stance_node_seperation = 0.25 * final_tip_velocity * (walker_->getTimeDelta() / swing_delta_t_);
+  Eigen::Vector3d final_tip_velocity = -stride_vector_ * (timetable_.stance_delta_t_ / walker_->getTimeDelta());
+  Eigen::Vector3d stance_node_seperation =
+      0.25 * final_tip_velocity * (walker_->getTimeDelta() / timetable_.swing_delta_t_);
 
   // Control nodes for secondary swing quartic bezier curves
   // Set for position continuity at transition between primary and secondary swing curves (C0 Smoothness)
@@ -1313,8 +1584,9 @@ void LegStepper::generateStanceControlNodes(const double &stride_scaler)
 
 void LegStepper::forceNormalTouchdown(void)
 {
-  Eigen::Vector3d final_tip_velocity = -stride_vector_ * (stance_delta_t_ / walker_->getTimeDelta());
-  Eigen::Vector3d stance_node_seperation = 0.25 * final_tip_velocity * (walker_->getTimeDelta() / swing_delta_t_);
+  Eigen::Vector3d final_tip_velocity = -stride_vector_ * (timetable_.stance_delta_t_ / walker_->getTimeDelta());
+  Eigen::Vector3d stance_node_seperation =
+      0.25 * final_tip_velocity * (walker_->getTimeDelta() / timetable_.swing_delta_t_);
 
   Eigen::Vector3d bezier_target = target_tip_pose_.position_;
   Eigen::Vector3d bezier_origin = target_tip_pose_.position_ - 4.0 * stance_node_seperation;
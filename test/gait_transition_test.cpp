@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019
+// Commonwealth Scientific and Industrial Research Organisation (CSIRO)
+// ABN 41 687 119 230
+//
+// Author: Fletcher Talbot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "syropod_highlevel_controller/gait_transition.h"
+
+#include <gtest/gtest.h>
+
+#define TIME_DELTA 0.02     ///< Control loop time period used in tests (50Hz)
+#define STEP_FREQUENCY 1.0  ///< Step frequency used in tests
+#define LEG_COUNT 6         ///< Number of legs (ordered clockwise by id number) used in tests
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Gait parameters as defined in config/gait.yaml (offset multipliers ordered by leg id number: AR, BR, CR, CL, BL, AL)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct TestGait
+{
+  int stance_phase;
+  int swing_phase;
+  int phase_offset;
+  int offset_multiplier[LEG_COUNT];
+};
+
+const TestGait WAVE_GAIT_PARAMETERS = {10, 2, 2, {2, 3, 4, 1, 0, 5}};
+const TestGait TRIPOD_GAIT_PARAMETERS = {2, 2, 2, {0, 1, 0, 1, 0, 1}};
+const TestGait RIPPLE_GAIT_PARAMETERS = {4, 2, 1, {2, 0, 4, 1, 3, 5}};
+const TestGait AMBLE_GAIT_PARAMETERS = {2, 1, 1, {1, 2, 0, 1, 2, 0}};
+const TestGait TEST_GAITS[] = {WAVE_GAIT_PARAMETERS, TRIPOD_GAIT_PARAMETERS,
+                               RIPPLE_GAIT_PARAMETERS, AMBLE_GAIT_PARAMETERS};
+
+/// Generates the step cycle of a gait as per WalkController::generateStepCycle.
+StepCycle generateTestStepCycle(const TestGait &gait)
+{
+  int base_step_period = gait.stance_phase + gait.swing_phase;
+  double swing_ratio = double(gait.swing_phase) / base_step_period;
+  double raw_step_period = ((1.0 / STEP_FREQUENCY) / TIME_DELTA) / swing_ratio;
+  int normaliser = roundToEvenInt(raw_step_period / base_step_period);
+  return GaitTransition::generateStepCycle(static_cast<int>(gait.stance_phase * 0.5) * normaliser,
+                                           gait.stance_phase * normaliser, gait.swing_phase * normaliser, TIME_DELTA);
+}
+
+/// Generates the phase offset of each leg for a gait as per WalkController::generateLimits.
+std::vector<int> generateTestPhaseOffsets(const TestGait &gait, const StepCycle &step)
+{
+  int normaliser = step.period_ / (gait.stance_phase + gait.swing_phase);
+  std::vector<int> offsets(LEG_COUNT);
+  for (int l = 0; l < LEG_COUNT; ++l)
+  {
+    offsets[l] = (gait.phase_offset * normaliser * gait.offset_multiplier[l]) % step.period_;
+  }
+  return offsets;
+}
+
+/// Asserts that no adjacent legs swing simultaneously at any iteration of a planned transition.
+void expectSupport(GaitTransition &transition)
+{
+  for (int i = 0; i < transition.getIterationCount(); ++i)
+  {
+    const StepCycle &step = transition.getStepCycle(i);
+    for (int l = 0; l < LEG_COUNT; ++l)
+    {
+      int adjacent_leg = (l + 1) % LEG_COUNT;
+      EXPECT_FALSE(GaitTransition::isSwing(step, transition.getPhase(i, l)) &&
+                   GaitTransition::isSwing(step, transition.getPhase(i, adjacent_leg)))
+        << "Legs " << l << " and " << adjacent_leg << " swing simultaneously at iteration " << i;
+    }
+  }
+}
+
+/// Asserts that legs of a planned transition end at the new phase offsets relative to a common reference phase.
+void expectTargetPhaseOffsets(GaitTransition &transition, const StepCycle &target_step,
+                              const std::vector<int> &target_offsets)
+{
+  int last = transition.getIterationCount() - 1;
+  ASSERT_GE(last, 0);
+  const StepCycle &step = transition.getStepCycle(last);
+  EXPECT_EQ(step.period_, target_step.period_);
+  EXPECT_EQ(step.stance_period_, target_step.stance_period_);
+  int reference_phase = mod(transition.getPhase(last, 0) - target_offsets[0], step.period_);
+  for (int l = 1; l < LEG_COUNT; ++l)
+  {
+    EXPECT_EQ(mod(transition.getPhase(last, l) - target_offsets[l], step.period_), reference_phase);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GaitTransition, TripodToWaveMaintainsSupport)
+{
+  StepCycle tripod_step = generateTestStepCycle(TRIPOD_GAIT_PARAMETERS);
+  StepCycle wave_step = generateTestStepCycle(WAVE_GAIT_PARAMETERS);
+  std::vector<int> phases = generateTestPhaseOffsets(TRIPOD_GAIT_PARAMETERS, tripod_step);
+  std::vector<int> target_offsets = generateTestPhaseOffsets(WAVE_GAIT_PARAMETERS, wave_step);
+
+  GaitTransition transition;
+  ASSERT_TRUE(transition.generate(tripod_step, wave_step, phases, target_offsets, 3));
+  expectSupport(transition);
+  expectTargetPhaseOffsets(transition, wave_step, target_offsets);
+  EXPECT_GT(transition.getVelocityScaler(), 0.0);
+  EXPECT_LE(transition.getVelocityScaler(), 1.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GaitTransition, WaveToTripodMaintainsSupport)
+{
+  StepCycle wave_step = generateTestStepCycle(WAVE_GAIT_PARAMETERS);
+  StepCycle tripod_step = generateTestStepCycle(TRIPOD_GAIT_PARAMETERS);
+  std::vector<int> phases = generateTestPhaseOffsets(WAVE_GAIT_PARAMETERS, wave_step);
+  std::vector<int> target_offsets = generateTestPhaseOffsets(TRIPOD_GAIT_PARAMETERS, tripod_step);
+
+  GaitTransition transition;
+  ASSERT_TRUE(transition.generate(wave_step, tripod_step, phases, target_offsets, 3));
+  expectSupport(transition);
+  expectTargetPhaseOffsets(transition, tripod_step, target_offsets);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GaitTransition, CompletesWithinTransitionCycles)
+{
+  for (const TestGait &current_gait : TEST_GAITS)
+  {
+    for (const TestGait &target_gait : TEST_GAITS)
+    {
+      StepCycle current_step = generateTestStepCycle(current_gait);
+      StepCycle target_step = generateTestStepCycle(target_gait);
+      std::vector<int> target_offsets = generateTestPhaseOffsets(target_gait, target_step);
+      for (int phase = 0; phase < current_step.period_; phase += current_step.period_ / 8)
+      {
+        std::vector<int> phases = generateTestPhaseOffsets(current_gait, current_step);
+        for (int &leg_phase : phases)
+        {
+          leg_phase = (leg_phase + phase) % current_step.period_;
+        }
+        for (int transition_cycles = 1; transition_cycles <= 4; ++transition_cycles)
+        {
+          GaitTransition transition;
+          if (transition.generate(current_step, target_step, phases, target_offsets, transition_cycles))
+          {
+            // Transition completes within the requested step cycles of blended period length
+            EXPECT_LE(transition.getIterationCount(),
+                      transition_cycles * std::max(current_step.period_, target_step.period_));
+            expectSupport(transition);
+            expectTargetPhaseOffsets(transition, target_step, target_offsets);
+          }
+          else
+          {
+            EXPECT_EQ(transition.getIterationCount(), 0);
+          }
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GaitTransition, RefusesWithoutTransitionCycles)
+{
+  StepCycle tripod_step = generateTestStepCycle(TRIPOD_GAIT_PARAMETERS);
+  StepCycle wave_step = generateTestStepCycle(WAVE_GAIT_PARAMETERS);
+  std::vector<int> phases = generateTestPhaseOffsets(TRIPOD_GAIT_PARAMETERS, tripod_step);
+  std::vector<int> target_offsets = generateTestPhaseOffsets(WAVE_GAIT_PARAMETERS, wave_step);
+
+  GaitTransition transition;
+  EXPECT_FALSE(transition.generate(tripod_step, wave_step, phases, target_offsets, 0));
+  EXPECT_EQ(transition.getIterationCount(), 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////